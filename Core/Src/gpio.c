@@ -106,10 +106,14 @@ void MX_GPIO_Init(void)
 
   /*Configure GPIO pins : PSH_BUT_DOWN_Pin PSH_BUT_UP_Pin PSH_BUT_SEL_Pin */
   GPIO_InitStruct.Pin = PSH_BUT_DOWN_Pin|PSH_BUT_UP_Pin|PSH_BUT_SEL_Pin;
-  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI4_15_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI4_15_IRQn);
+
 }
 
 /* USER CODE BEGIN 2 */
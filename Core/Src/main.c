@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "adc.h"
+#include "dma.h"
 #include "i2c.h"
 #include "usart.h"
 #include "gpio.h"
@@ -89,10 +90,11 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
-  MX_USART2_UART_Init();
+  MX_DMA_Init();
   MX_ADC1_Init();
-  MX_I2C1_Init();
   /* USER CODE BEGIN 2 */
+  /* Staged boot: USART2 and I2C1 are initialized by main_serre() once the
+     outputs are safe and the first sample is taken */
   /* USER CODE END 2 */
   
   /* Infinite loop */
@@ -158,10 +160,8 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
-  __disable_irq();
-  while (1)
-  {
-  }
+  /* Log the fault, put the actuators in their safe state and reset */
+  main_serre_errorHandler();
   /* USER CODE END Error_Handler_Debug */
 }
 #ifdef USE_FULL_ASSERT
@@ -23,12 +23,25 @@
 /* Includes */
 #include <errno.h>
 #include <stdint.h>
+#include "../serre/main_serre.h"
+
+#ifdef SERRE_STRICT_HEAP
+/* Strict heap build: every link that pulls _sbrk in prints this warning */
+static const char __sbrk_link_warning[]
+    __attribute__((used, section(".gnu.warning._sbrk"))) =
+    "_sbrk: heap use in a SERRE_STRICT_HEAP build, see system/pool";
+#endif
 
 /**
  * Pointer to the current high watermark of the heap usage
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Highest heap end ever reached, for the RAM monitor
+ */
+static uint8_t *__sbrk_heap_peak = NULL;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -47,6 +60,10 @@ static uint8_t *__sbrk_heap_end = NULL;
  * NOTE: If the MSP stack, at any point during execution, grows larger than the
  * reserved size, please increase the '_Min_Stack_Size'.
  *
+ * With SERRE_STRICT_HEAP defined, the firmware must not use the heap at all
+ * (C++ allocations go to the block pools): any call logs SYSTEM_HEAP_USED
+ * and resets the MCU.
+ *
  * @param incr Memory size
  * @return Pointer to allocated memory
  */
@@ -59,6 +76,10 @@ void *_sbrk(ptrdiff_t incr)
   const uint8_t *max_heap = (uint8_t *)stack_limit;
   uint8_t *prev_heap_end;
 
+#ifdef SERRE_STRICT_HEAP
+  main_serre_heapUsed();
+#endif
+
   /* Initialize heap end at first call */
   if (NULL == __sbrk_heap_end)
   {
@@ -74,6 +95,23 @@ void *_sbrk(ptrdiff_t incr)
 
   prev_heap_end = __sbrk_heap_end;
   __sbrk_heap_end += incr;
+  if (__sbrk_heap_end > __sbrk_heap_peak)
+  {
+    __sbrk_heap_peak = __sbrk_heap_end;
+  }
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * @brief Gets the heap high watermark, read by the RAM monitor
+ *        (Core/serre/system/memory)
+ * @return Highest heap end returned by _sbrk(), '_end' if the heap was
+ *         never used
+ */
+uint8_t *sysmem_heapPeak(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+
+  return (NULL == __sbrk_heap_peak) ? &_end : __sbrk_heap_peak;
+}
@@ -43,6 +43,11 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* load, start and end addresses of the .ramfunc section. defined in linker
+script */
+.word _siramfunc
+.word _sramfunc
+.word _eramfunc
 
 /**
  * @brief  This is the code that gets called when the processor first
@@ -80,6 +85,23 @@ LoopCopyDataInit:
   cmp r4, r1
   bcc CopyDataInit
 
+/* Copy the RAM functions from flash to SRAM */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  movs r3, #0
+  b LoopCopyRamfuncInit
+
+CopyRamfuncInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyRamfuncInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyRamfuncInit
+
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
   ldr r4, =_ebss
@@ -94,6 +116,21 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint the free RAM, from the heap start to the stack pointer, for the
+   stack high-water mark (STACK_PAINT in system/memory/inc/ram_monitor.hh) */
+  ldr r2, =_end
+  mov r4, sp
+  ldr r3, =0xC5C5C5C5
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
   bl __libc_init_array
 /* Call the application s entry point.*/
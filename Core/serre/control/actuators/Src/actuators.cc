@@ -0,0 +1,75 @@
+#include "../inc/actuators.hh"
+
+namespace control {
+
+namespace {
+
+bool resolve(Override mode, bool command) {
+    if (mode == Override::AUTO) {
+        return command;
+    }
+    return mode == Override::ON;
+}
+
+} // namespace
+
+bool scheduledWatering(const WateringSchedule *schedule, uint32_t elapsedMs) {
+    uint32_t phase = elapsedMs % schedule->periodMs;
+    return phase >= (schedule->periodMs - schedule->onMs);
+}
+
+Actuators::Actuators(ActuatorConfig config) {
+    this->m_config = config;
+}
+
+void Actuators::setFan(bool on) {
+    this->m_fanCommand = on;
+    this->write();
+}
+
+void Actuators::setPump(bool on) {
+    this->m_pumpCommand = on;
+    this->write();
+}
+
+void Actuators::setFanOverride(Override mode) {
+    this->m_fanOverride = mode;
+    this->write();
+}
+
+void Actuators::setPumpOverride(Override mode) {
+    this->m_pumpOverride = mode;
+    this->write();
+}
+
+Override Actuators::fanOverride() const {
+    return this->m_fanOverride;
+}
+
+Override Actuators::pumpOverride() const {
+    return this->m_pumpOverride;
+}
+
+void Actuators::applySafeState() {
+    this->setPump(false);
+    this->setFan(true);
+}
+
+bool Actuators::isFanOn() const {
+    return this->m_fanOn;
+}
+
+bool Actuators::isPumpOn() const {
+    return this->m_pumpOn;
+}
+
+void Actuators::write() {
+    this->m_fanOn = resolve(this->m_fanOverride, this->m_fanCommand);
+    this->m_pumpOn = resolve(this->m_pumpOverride, this->m_pumpCommand);
+    HAL_GPIO_WritePin(this->m_config.fanPort, this->m_config.fanPin,
+                      this->m_fanOn ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(this->m_config.pumpPort, this->m_config.pumpPin,
+                      this->m_pumpOn ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+} // namespace control
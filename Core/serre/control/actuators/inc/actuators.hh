@@ -0,0 +1,156 @@
+#ifndef ACTUATORS_HH
+#define ACTUATORS_HH
+
+// Includes
+#include "../../../../Inc/main.h"
+
+/**
+ * @namespace control
+ * @brief Contains classes driving the greenhouse actuators.
+ */
+namespace control {
+
+/**
+ * @brief GPIO assignment of the greenhouse actuators.
+ *
+ * @struct ActuatorConfig
+ * @var GPIO_TypeDef *fanPort
+ *      GPIO port of the fan output.
+ * @var uint16_t fanPin
+ *      GPIO pin of the fan output.
+ * @var GPIO_TypeDef *pumpPort
+ *      GPIO port of the pump output.
+ * @var uint16_t pumpPin
+ *      GPIO pin of the pump output.
+ */
+typedef struct {
+    GPIO_TypeDef *fanPort;  ///< Fan GPIO port
+    uint16_t fanPin;        ///< Fan GPIO pin
+    GPIO_TypeDef *pumpPort; ///< Pump GPIO port
+    uint16_t pumpPin;       ///< Pump GPIO pin
+} ActuatorConfig;
+
+/**
+ * @brief Manual override of an actuator.
+ */
+enum class Override : uint8_t {
+    AUTO = 0, ///< Output follows the control commands
+    OFF,      ///< Output forced off
+    ON        ///< Output forced on
+};
+
+/**
+ * @brief Watering on a timer, for when the soil probe cannot be trusted.
+ *
+ * @struct WateringSchedule
+ * @var uint32_t periodMs
+ *      Time from one watering to the next.
+ * @var uint32_t onMs
+ *      Pump run time of each watering.
+ */
+typedef struct {
+    uint32_t periodMs; ///< Watering period
+    uint32_t onMs;     ///< Pump run time
+} WateringSchedule;
+
+/**
+ * @brief Gets the pump state of a watering schedule.
+ *
+ * The pump runs at the end of each period, so the first watering comes a
+ * full period after the schedule starts: the soil may just have been
+ * watered when the probe failed.
+ *
+ * @param schedule Watering schedule.
+ * @param elapsedMs Time since the schedule started.
+ * @return True while the pump must run.
+ */
+bool scheduledWatering(const WateringSchedule *schedule, uint32_t elapsedMs);
+
+/**
+ * @class Actuators
+ * @brief Drives the fan and pump outputs.
+ *
+ * setFan() and setPump() give the automatic command; an output under a
+ * manual override ignores it until the override returns to AUTO.
+ */
+class Actuators {
+  public:
+    /**
+     * @brief Constructor for Actuators.
+     * @param config Actuator configuration: fanPort/fanPin and
+     * pumpPort/pumpPin of the push-pull outputs.
+     */
+    Actuators(ActuatorConfig config);
+
+    /**
+     * @brief Commands the fan.
+     * @param on True to run the fan.
+     */
+    void setFan(bool on);
+
+    /**
+     * @brief Commands the pump.
+     * @param on True to run the pump.
+     */
+    void setPump(bool on);
+
+    /**
+     * @brief Sets the manual override of the fan.
+     * @param mode AUTO to follow setFan(), OFF or ON to force the output.
+     */
+    void setFanOverride(Override mode);
+
+    /**
+     * @brief Sets the manual override of the pump.
+     * @param mode AUTO to follow setPump(), OFF or ON to force the output.
+     */
+    void setPumpOverride(Override mode);
+
+    /**
+     * @brief Gets the manual override of the fan.
+     * @return Current override mode.
+     */
+    Override fanOverride() const;
+
+    /**
+     * @brief Gets the manual override of the pump.
+     * @return Current override mode.
+     */
+    Override pumpOverride() const;
+
+    /**
+     * @brief Applies the safe state: pump off, fan on.
+     *
+     * Used whenever sensor data cannot be trusted. Not watering cannot
+     * flood the greenhouse and ventilating cannot overheat it. A manual
+     * override still wins: the technician who set it is on site.
+     */
+    void applySafeState();
+
+    /**
+     * @brief Checks if the fan is running.
+     * @return True if the fan output is on.
+     */
+    bool isFanOn() const;
+
+    /**
+     * @brief Checks if the pump is running.
+     * @return True if the pump output is on.
+     */
+    bool isPumpOn() const;
+
+  private:
+    void write();
+
+    ActuatorConfig m_config = {};             ///< Actuator configuration.
+    bool m_fanCommand = false;                ///< Automatic fan command.
+    bool m_pumpCommand = false;               ///< Automatic pump command.
+    Override m_fanOverride = Override::AUTO;  ///< Manual fan override.
+    Override m_pumpOverride = Override::AUTO; ///< Manual pump override.
+    bool m_fanOn = false;                     ///< Fan output state.
+    bool m_pumpOn = false;                    ///< Pump output state.
+};
+
+} // namespace control
+
+#endif // ACTUATORS_HH
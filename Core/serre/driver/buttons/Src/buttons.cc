@@ -0,0 +1,75 @@
+#include "../inc/buttons.hh"
+
+namespace input {
+
+namespace {
+
+uint8_t pushEvent(ButtonQueue *queue, uint8_t index, ButtonEventType type) {
+    ButtonEvent event = {static_cast<ButtonId>(index), type};
+    return ((queue != nullptr) && queue->push(event)) ? 1 : 0;
+}
+
+} // namespace
+
+Buttons::Buttons(ButtonTiming timing) {
+    this->m_timing = timing;
+}
+
+void Buttons::onEdge(ButtonId button, uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(button);
+    if (index >= BUTTON_COUNT) {
+        return;
+    }
+    this->m_state[index].bouncing = true;
+    this->m_state[index].lastEdgeMs = nowMs;
+}
+
+bool Buttons::needsUpdate() const {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        if (this->m_state[i].bouncing || this->m_state[i].pressed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t Buttons::update(uint32_t nowMs, uint8_t pressedMask,
+                        ButtonQueue *queue) {
+    uint8_t events = 0;
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        State &state = this->m_state[i];
+
+        if (state.bouncing &&
+            ((nowMs - state.lastEdgeMs) >= this->m_timing.debounceMs)) {
+            state.bouncing = false;
+            bool pressed = (pressedMask & (1U << i)) != 0;
+            if (pressed && !state.pressed) {
+                state.pressed = true;
+                state.longSent = false;
+                state.pressStartMs = nowMs;
+            } else if (!pressed && state.pressed) {
+                state.pressed = false;
+                if (!state.longSent) {
+                    events += pushEvent(queue, i, ButtonEventType::SHORT_PRESS);
+                }
+            }
+        }
+
+        if (!state.pressed) {
+            continue;
+        }
+        if (!state.longSent) {
+            if ((nowMs - state.pressStartMs) >= this->m_timing.longPressMs) {
+                state.longSent = true;
+                state.nextRepeatMs = nowMs + this->m_timing.repeatDelayMs;
+                events += pushEvent(queue, i, ButtonEventType::LONG_PRESS);
+            }
+        } else if (static_cast<int32_t>(nowMs - state.nextRepeatMs) >= 0) {
+            state.nextRepeatMs += this->m_timing.repeatPeriodMs;
+            events += pushEvent(queue, i, ButtonEventType::REPEAT);
+        }
+    }
+    return events;
+}
+
+} // namespace input
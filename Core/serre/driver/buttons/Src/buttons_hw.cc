@@ -0,0 +1,72 @@
+#include "../inc/buttons.hh"
+
+#include "../../../../Inc/main.h"
+
+namespace {
+
+/**
+ * @brief GPIO of one push button.
+ */
+struct ButtonPin {
+    GPIO_TypeDef *port; ///< GPIO port
+    uint16_t pin;       ///< GPIO pin, also the EXTI line mask
+};
+
+// Buttons pull the input low when pressed
+constexpr bool BUTTON_ACTIVE_LOW = true;
+
+const input::ButtonTiming buttonTiming = {20, 800, 400, 150};
+
+const ButtonPin buttonPins[] = {
+    {PSH_BUT_DOWN_GPIO_Port, PSH_BUT_DOWN_Pin},
+    {PSH_BUT_UP_GPIO_Port, PSH_BUT_UP_Pin},
+    {PSH_BUT_SEL_GPIO_Port, PSH_BUT_SEL_Pin},
+};
+
+input::Buttons s_buttons(buttonTiming);
+input::ButtonQueue s_queue;
+
+uint8_t readPressedMask() {
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < sizeof(buttonPins) / sizeof(buttonPins[0]); i++) {
+        bool high = HAL_GPIO_ReadPin(buttonPins[i].port, buttonPins[i].pin) ==
+                    GPIO_PIN_SET;
+        if (high != BUTTON_ACTIVE_LOW) {
+            mask |= static_cast<uint8_t>(1U << i);
+        }
+    }
+    return mask;
+}
+
+void onButtonEdge(uint16_t pin) {
+    for (uint8_t i = 0; i < sizeof(buttonPins) / sizeof(buttonPins[0]); i++) {
+        if (buttonPins[i].pin == pin) {
+            s_buttons.onEdge(static_cast<input::ButtonId>(i), HAL_GetTick());
+        }
+    }
+}
+
+} // namespace
+
+extern "C" void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin) {
+    onButtonEdge(GPIO_Pin);
+}
+
+extern "C" void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin) {
+    onButtonEdge(GPIO_Pin);
+}
+
+namespace input {
+
+uint8_t buttonsTick(uint32_t nowMs) {
+    if (!s_buttons.needsUpdate()) {
+        return 0;
+    }
+    return s_buttons.update(nowMs, readPressedMask(), &s_queue);
+}
+
+bool popButtonEvent(ButtonEvent *outEvent) {
+    return s_queue.pop(outEvent);
+}
+
+} // namespace input
@@ -0,0 +1,138 @@
+#ifndef BUTTONS_HH
+#define BUTTONS_HH
+
+// Includes
+#include "../../../system/queue/inc/spsc_queue.hh"
+
+/**
+ * @namespace input
+ * @brief Contains the push button input subsystem.
+ */
+namespace input {
+
+/**
+ * @brief Front panel push buttons.
+ */
+enum class ButtonId : uint8_t {
+    DOWN = 0, ///< PSH_BUT_DOWN (PB6)
+    UP,       ///< PSH_BUT_UP (PB7)
+    SEL,      ///< PSH_BUT_SEL (PB8)
+    COUNT
+};
+
+/**
+ * @brief Gestures recognized on a button.
+ */
+enum class ButtonEventType : uint8_t {
+    SHORT_PRESS = 0, ///< Released before the long press delay
+    LONG_PRESS,      ///< Held for the long press delay
+    REPEAT           ///< Still held, emitted periodically after LONG_PRESS
+};
+
+/**
+ * @brief Button event passed from the tick interrupt to the UI task.
+ */
+typedef struct {
+    ButtonId button;      ///< Button concerned
+    ButtonEventType type; ///< Recognized gesture
+} ButtonEvent;
+
+typedef sys::SpscQueue<ButtonEvent, 8> ButtonQueue; ///< Tick ISR to UI task.
+
+/**
+ * @brief Button timing, in milliseconds.
+ *
+ * @struct ButtonTiming
+ * @var uint16_t debounceMs
+ *      Time a level must stay stable after the last edge.
+ * @var uint16_t longPressMs
+ *      Hold time before LONG_PRESS.
+ * @var uint16_t repeatDelayMs
+ *      Delay between LONG_PRESS and the first REPEAT.
+ * @var uint16_t repeatPeriodMs
+ *      Period of the following REPEAT events.
+ */
+typedef struct {
+    uint16_t debounceMs;     ///< Stable time after the last edge
+    uint16_t longPressMs;    ///< Hold time before LONG_PRESS
+    uint16_t repeatDelayMs;  ///< LONG_PRESS to first REPEAT
+    uint16_t repeatPeriodMs; ///< Period between REPEAT events
+} ButtonTiming;
+
+/**
+ * @class Buttons
+ * @brief Edge-triggered debouncing and gesture recognition.
+ *
+ * Edges are reported by the EXTI interrupt through onEdge(). The 1 ms tick
+ * then calls update() with the pin levels, but only while needsUpdate() is
+ * true, i.e. while a button is bouncing or held: an idle panel costs no
+ * CPU time. Both callers are interrupts of the same priority, so they never
+ * preempt each other.
+ */
+class Buttons {
+  public:
+    /**
+     * @brief Constructor for Buttons.
+     * @param timing Debounce, long press and repeat timing.
+     */
+    explicit Buttons(ButtonTiming timing);
+
+    /**
+     * @brief Records an edge on a button input.
+     * @param button Button whose input changed.
+     * @param nowMs Current tick in milliseconds.
+     */
+    void onEdge(ButtonId button, uint32_t nowMs);
+
+    /**
+     * @brief Checks if update() has work to do.
+     * @return True if a button is bouncing or held.
+     */
+    bool needsUpdate() const;
+
+    /**
+     * @brief Advances the debounce and gesture state machines.
+     * @param nowMs Current tick in milliseconds.
+     * @param pressedMask Pressed buttons (bit n = ButtonId n).
+     * @param queue Queue receiving the recognized events.
+     * @return Number of events pushed.
+     */
+    uint8_t update(uint32_t nowMs, uint8_t pressedMask, ButtonQueue *queue);
+
+  private:
+    static constexpr uint8_t BUTTON_COUNT =
+        static_cast<uint8_t>(ButtonId::COUNT);
+
+    /**
+     * @brief Per-button state.
+     */
+    struct State {
+        bool pressed;          ///< Debounced level
+        bool bouncing;         ///< Edge seen, level not yet stable
+        bool longSent;         ///< LONG_PRESS already emitted
+        uint32_t lastEdgeMs;   ///< Tick of the latest edge
+        uint32_t pressStartMs; ///< Tick of the debounced press
+        uint32_t nextRepeatMs; ///< Tick of the next REPEAT
+    };
+
+    ButtonTiming m_timing = {};       ///< Gesture timing.
+    State m_state[BUTTON_COUNT] = {}; ///< Per-button state.
+};
+
+/**
+ * @brief Runs the button state machines of the board, from the 1 ms tick.
+ * @param nowMs Current tick in milliseconds.
+ * @return Number of events queued for the UI task.
+ */
+uint8_t buttonsTick(uint32_t nowMs);
+
+/**
+ * @brief Takes the oldest button event (UI task side).
+ * @param[out] outEvent Pointer to store the event.
+ * @return False if no event is pending.
+ */
+bool popButtonEvent(ButtonEvent *outEvent);
+
+} // namespace input
+
+#endif // BUTTONS_HH
@@ -0,0 +1,76 @@
+#include "../inc/devices.hh"
+
+#include "../../../system/pool/inc/block_pool.hh"
+#include "../../../ui/display/inc/ssd1306_display.hh"
+#include "../../sensors/sht_sensor/inc/sht_sensor.hh"
+
+#include <new>
+
+namespace devices {
+
+namespace {
+
+constexpr uint16_t SHT_TIMEOUT_MS = 20;     ///< I2C transaction timeout
+constexpr uint16_t SSD1306_TIMEOUT_MS = 30; ///< One 135-byte page
+
+// Driver storage, one block per supported instance
+sys::BlockPool<sizeof(sensor::ShtSensor), 2> s_shtPool;
+sys::BlockPool<sizeof(ui::Ssd1306Display), 1> s_ssd1306Pool;
+
+const uint8_t sht4xAddresses[] = {0x44, 0x45, 0x46};
+const uint8_t sht3xAddresses[] = {0x44, 0x45};
+const uint8_t ssd1306Addresses[] = {0x3C, 0x3D};
+
+bool identifySht4x(bus::I2cProber *prober, uint8_t address) {
+    return sensor::shtIdentify(prober, address, sensor::ShtModel::SHT4X);
+}
+
+bool identifySht3x(bus::I2cProber *prober, uint8_t address) {
+    return sensor::shtIdentify(prober, address, sensor::ShtModel::SHT3X);
+}
+
+void *createSht(uint8_t address, sensor::ShtModel model) {
+    void *slot = s_shtPool.allocate();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    sensor::ShtConfig config = {&bus::i2c1(), address, model, SHT_TIMEOUT_MS};
+    return new (slot) sensor::ShtSensor(config);
+}
+
+void *createSht4x(uint8_t address) {
+    return createSht(address, sensor::ShtModel::SHT4X);
+}
+
+void *createSht3x(uint8_t address) {
+    return createSht(address, sensor::ShtModel::SHT3X);
+}
+
+void *createSsd1306(uint8_t address) {
+    void *slot = s_ssd1306Pool.allocate();
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    ui::Ssd1306Config config = {&bus::i2c1(), address, SSD1306_TIMEOUT_MS};
+    return new (slot) ui::Ssd1306Display(config);
+}
+
+// Nothing else on the board uses 0x3C/0x3D: an answer there is the OLED
+const bus::DriverDescriptor driverTable[] = {
+    {"SHT4x", bus::DeviceKind::AIR_SENSOR, sht4xAddresses,
+     sizeof(sht4xAddresses), identifySht4x, createSht4x},
+    {"SHT3x", bus::DeviceKind::AIR_SENSOR, sht3xAddresses,
+     sizeof(sht3xAddresses), identifySht3x, createSht3x},
+    {"SSD1306", bus::DeviceKind::DISPLAY, ssd1306Addresses,
+     sizeof(ssd1306Addresses), nullptr, createSsd1306},
+};
+
+} // namespace
+
+void discoverI2c1(uint32_t budgetMs, bus::Discovery *result) {
+    bus::i2cDiscover(&bus::i2c1Prober(), driverTable,
+                     sizeof(driverTable) / sizeof(driverTable[0]), budgetMs,
+                     result);
+}
+
+} // namespace devices
@@ -0,0 +1,26 @@
+#ifndef DEVICES_HH
+#define DEVICES_HH
+
+// Includes
+#include "../../i2c/inc/i2c_discovery.hh"
+
+/**
+ * @namespace devices
+ * @brief Contains the I2C devices the firmware can find on a node.
+ */
+namespace devices {
+
+/**
+ * @brief Probes I2C1 for the supported devices and creates their drivers.
+ *
+ * Runs at boot with the bus idle. The drivers are built in static storage,
+ * one slot per supported instance.
+ *
+ * @param budgetMs Time allowed for the whole discovery.
+ * @param[out] result Devices found.
+ */
+void discoverI2c1(uint32_t budgetMs, bus::Discovery *result);
+
+} // namespace devices
+
+#endif // DEVICES_HH
@@ -0,0 +1,190 @@
+#include "../inc/i2c_bus.hh"
+
+#include "../../../system/ramfunc.hh"
+
+namespace bus {
+
+namespace {
+
+constexpr uint32_t RECOVERY_MIN_BACKOFF_MS = 10;   ///< After the first one
+constexpr uint32_t RECOVERY_MAX_BACKOFF_MS = 5000; ///< Also ends an episode
+constexpr uint8_t RECOVERY_ATTEMPTS = 8;           ///< Failures in a row
+
+} // namespace
+
+I2cPort::~I2cPort() {
+}
+
+I2cEngine::I2cEngine(I2cPort *port) {
+    this->m_port = port;
+}
+
+bool I2cEngine::submit(I2cTransaction *transaction) {
+    if ((transaction == nullptr) ||
+        ((transaction->txLength == 0) && (transaction->rxLength == 0))) {
+        return false;
+    }
+    this->m_port->lock();
+    if ((transaction->result == I2cResult::PENDING) ||
+        (this->m_count >= QUEUE_SIZE)) {
+        if (this->m_count >= QUEUE_SIZE) {
+            this->m_stats.rejected++;
+        }
+        this->m_port->unlock();
+        return false;
+    }
+    transaction->result = I2cResult::PENDING;
+    uint8_t tail = (this->m_head + this->m_count) & (QUEUE_SIZE - 1);
+    this->m_queue[tail] = transaction;
+    this->m_count++;
+    this->startNext();
+    this->m_port->unlock();
+    return true;
+}
+
+void I2cEngine::poll(uint32_t nowMs) {
+    this->m_port->lock();
+    I2cTransaction *current = this->m_current;
+    if (current == nullptr) {
+        this->checkBus();
+    } else if ((nowMs - this->m_startMs) >= current->timeoutMs) {
+        this->m_port->abort();
+        this->finish(I2cResult::TIMEOUT);
+        this->checkBus();
+        this->startNext();
+    }
+    this->m_port->unlock();
+}
+
+// Completion interrupt path: this, startNext() and finish() run from RAM
+SERRE_RAMFUNC void I2cEngine::onTransferDone(I2cTransferStatus status) {
+    this->m_port->lock();
+    I2cTransaction *current = this->m_current;
+    if (current == nullptr) {
+        // Late report of a transfer already timed out
+        this->m_port->unlock();
+        return;
+    }
+    if (status == I2cTransferStatus::DONE) {
+        if ((this->m_phase == Phase::WRITING) && (current->rxLength > 0)) {
+            // Repeated start into the read phase
+            this->m_phase = Phase::READING;
+            if (!this->m_port->receive(current->address, current->rxData,
+                                       current->rxLength)) {
+                this->finish(I2cResult::ERROR);
+            }
+        } else {
+            this->finish(I2cResult::OK);
+        }
+    } else if (status == I2cTransferStatus::NACK) {
+        this->finish(I2cResult::NACK);
+    } else {
+        this->finish(I2cResult::ERROR);
+    }
+    this->startNext();
+    this->m_port->unlock();
+}
+
+bool I2cEngine::isIdle() const {
+    return (this->m_current == nullptr) && (this->m_count == 0);
+}
+
+const I2cStats &I2cEngine::stats() const {
+    return this->m_stats;
+}
+
+SERRE_RAMFUNC void I2cEngine::startNext() {
+    // A callback may already have started a transaction through submit()
+    while ((this->m_current == nullptr) && (this->m_count > 0)) {
+        I2cTransaction *next = this->m_queue[this->m_head];
+        this->m_head = (this->m_head + 1) & (QUEUE_SIZE - 1);
+        this->m_count--;
+
+        this->m_current = next;
+        this->m_startMs = this->m_port->nowMs();
+        bool started;
+        if (next->txLength > 0) {
+            this->m_phase = Phase::WRITING;
+            started = this->m_port->transmit(next->address, next->txData,
+                                             next->txLength,
+                                             next->rxLength == 0);
+        } else {
+            this->m_phase = Phase::READING;
+            started = this->m_port->receive(next->address, next->rxData,
+                                            next->rxLength);
+        }
+        if (!started) {
+            this->finish(I2cResult::ERROR);
+            this->checkBus();
+        }
+    }
+}
+
+SERRE_RAMFUNC void I2cEngine::finish(I2cResult result) {
+    I2cTransaction *current = this->m_current;
+    this->m_current = nullptr;
+    this->m_phase = Phase::IDLE;
+
+    switch (result) {
+    case I2cResult::OK:
+        this->m_stats.completed++;
+        break;
+    case I2cResult::TIMEOUT:
+        this->m_stats.timeouts++;
+        break;
+    default:
+        this->m_stats.failed++;
+        break;
+    }
+    current->result = result;
+    if (current->callback != nullptr) {
+        current->callback(current);
+    }
+}
+
+void I2cEngine::checkBus() {
+    uint32_t nowMs = this->m_port->nowMs();
+    if (!this->m_port->isBusStuck()) {
+        // Free long enough after the last recovery: the episode is over
+        if (this->m_episode &&
+            ((nowMs - this->m_recoveryMs) >= RECOVERY_MAX_BACKOFF_MS)) {
+            this->m_episode = false;
+            this->m_episodeFailed = false;
+            this->m_gaveUp = false;
+            this->m_failures = 0;
+            this->m_backoffMs = 0;
+        }
+        return;
+    }
+    if (this->m_gaveUp || (this->m_episode && ((nowMs - this->m_recoveryMs) <
+                                               this->m_backoffMs))) {
+        return;
+    }
+    if (!this->m_episode) {
+        this->m_episode = true;
+        this->m_stats.stuckEpisodes++;
+    }
+    this->m_recoveryMs = nowMs;
+    this->m_backoffMs = (this->m_backoffMs == 0) ? RECOVERY_MIN_BACKOFF_MS
+                                                 : 2 * this->m_backoffMs;
+    if (this->m_backoffMs > RECOVERY_MAX_BACKOFF_MS) {
+        this->m_backoffMs = RECOVERY_MAX_BACKOFF_MS;
+    }
+
+    this->m_stats.recoveries++;
+    if (this->m_port->recoverBus()) {
+        this->m_failures = 0;
+        return;
+    }
+    this->m_stats.recoveryFailures++;
+    if (!this->m_episodeFailed) {
+        this->m_episodeFailed = true;
+        this->m_stats.failedEpisodes++;
+    }
+    if (++this->m_failures >= RECOVERY_ATTEMPTS) {
+        this->m_gaveUp = true;
+        this->m_stats.abandoned++;
+    }
+}
+
+} // namespace bus
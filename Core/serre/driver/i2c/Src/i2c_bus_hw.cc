@@ -0,0 +1,153 @@
+#include "../inc/i2c_bus.hh"
+
+#include "../../../../Inc/i2c.h"
+
+namespace bus {
+
+namespace {
+
+// I2C1 lines, see HAL_I2C_MspInit()
+GPIO_TypeDef *const SCL_PORT = GPIOA;
+constexpr uint16_t SCL_PIN = GPIO_PIN_9;
+GPIO_TypeDef *const SDA_PORT = GPIOB;
+constexpr uint16_t SDA_PIN = GPIO_PIN_9;
+
+constexpr uint8_t RECOVERY_CLOCKS = 9; // A byte and its acknowledge
+constexpr uint32_t HALF_PERIOD_US = 5; // About 100 kHz
+
+void busyWaitUs(uint32_t us) {
+    // At least 4 cycles per iteration, so never shorter than asked
+    volatile uint32_t count = (SystemCoreClock / 4000000UL) * us;
+    while (count > 0) {
+        count--;
+    }
+}
+
+bool isHigh(GPIO_TypeDef *port, uint16_t pin) {
+    return HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_SET;
+}
+
+void drive(GPIO_TypeDef *port, uint16_t pin, bool high) {
+    HAL_GPIO_WritePin(port, pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    busyWaitUs(HALF_PERIOD_US);
+}
+
+void configureOpenDrain(GPIO_TypeDef *port, uint16_t pin) {
+    GPIO_InitTypeDef init = {};
+    init.Pin = pin;
+    init.Mode = GPIO_MODE_OUTPUT_OD;
+    init.Pull = GPIO_NOPULL;
+    init.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_WritePin(port, pin, GPIO_PIN_SET);
+    HAL_GPIO_Init(port, &init);
+}
+
+/**
+ * @brief I2C port over the HAL sequential DMA transfers of hi2c1.
+ */
+class HalI2cPort final : public I2cPort {
+  public:
+    bool transmit(uint8_t address, const uint8_t *data, uint16_t length,
+                  bool stop) override {
+        uint32_t options = stop ? I2C_FIRST_AND_LAST_FRAME : I2C_FIRST_FRAME;
+        return HAL_I2C_Master_Seq_Transmit_DMA(
+                   &hi2c1, static_cast<uint16_t>(address << 1),
+                   const_cast<uint8_t *>(data), length, options) == HAL_OK;
+    }
+
+    bool receive(uint8_t address, uint8_t *data, uint16_t length) override {
+        // After a write this issues a repeated start, otherwise a start
+        return HAL_I2C_Master_Seq_Receive_DMA(
+                   &hi2c1, static_cast<uint16_t>(address << 1), data, length,
+                   I2C_LAST_FRAME) == HAL_OK;
+    }
+
+    void abort() override {
+        // A stalled transfer leaves the HAL state machine busy: start over
+        HAL_I2C_DeInit(&hi2c1);
+        MX_I2C1_Init();
+    }
+
+    bool isBusStuck() const override {
+        return !isHigh(SDA_PORT, SDA_PIN) || !isHigh(SCL_PORT, SCL_PIN);
+    }
+
+    bool recoverBus() override {
+        HAL_I2C_DeInit(&hi2c1);
+        configureOpenDrain(SCL_PORT, SCL_PIN);
+        configureOpenDrain(SDA_PORT, SDA_PIN);
+
+        // Clock out the byte the slave is still sending
+        for (uint8_t i = 0; (i < RECOVERY_CLOCKS) && !isHigh(SDA_PORT, SDA_PIN);
+             i++) {
+            drive(SCL_PORT, SCL_PIN, false);
+            drive(SCL_PORT, SCL_PIN, true);
+        }
+        // STOP: SDA rises while SCL is high
+        drive(SCL_PORT, SCL_PIN, false);
+        drive(SDA_PORT, SDA_PIN, false);
+        drive(SCL_PORT, SCL_PIN, true);
+        drive(SDA_PORT, SDA_PIN, true);
+        bool released = isHigh(SDA_PORT, SDA_PIN) && isHigh(SCL_PORT, SCL_PIN);
+
+        // Gives the lines back to the controller
+        MX_I2C1_Init();
+        return released;
+    }
+
+    uint32_t nowMs() const override {
+        return HAL_GetTick();
+    }
+
+    void lock() override {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (this->m_depth++ == 0) {
+            this->m_primask = primask;
+        }
+    }
+
+    void unlock() override {
+        if ((this->m_depth > 0) && (--this->m_depth == 0)) {
+            __set_PRIMASK(this->m_primask);
+        }
+    }
+
+  private:
+    uint32_t m_primask = 0; ///< PRIMASK saved by the outermost lock().
+    uint8_t m_depth = 0;    ///< Nesting of lock().
+};
+
+HalI2cPort s_port;
+I2cEngine s_engine(&s_port);
+
+} // namespace
+
+I2cEngine &i2c1() {
+    return s_engine;
+}
+
+} // namespace bus
+
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c == &hi2c1) {
+        bus::i2c1().onTransferDone(bus::I2cTransferStatus::DONE);
+    }
+}
+
+extern "C" void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c == &hi2c1) {
+        bus::i2c1().onTransferDone(bus::I2cTransferStatus::DONE);
+    }
+}
+
+extern "C" void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c != &hi2c1) {
+        return;
+    }
+    if (HAL_I2C_GetError(hi2c) & HAL_I2C_ERROR_AF) {
+        bus::i2c1().onTransferDone(bus::I2cTransferStatus::NACK);
+    } else {
+        bus::i2c1().onTransferDone(bus::I2cTransferStatus::ERROR);
+    }
+}
@@ -0,0 +1,104 @@
+#include "../inc/i2c_discovery.hh"
+
+namespace bus {
+
+namespace {
+
+constexpr uint8_t FIRST_ADDRESS = 0x08; // Below are reserved addresses
+constexpr uint8_t LAST_ADDRESS = 0x77;  // Above are 10-bit prefixes
+
+bool outOfTime(I2cProber *prober, uint32_t startMs, uint32_t budgetMs) {
+    return (prober->nowMs() - startMs) >= budgetMs;
+}
+
+} // namespace
+
+I2cProber::~I2cProber() {
+}
+
+bool i2cContains(const I2cAddressSet *set, uint8_t address) {
+    return (set->bits[(address >> 3) & 0x0F] & (1U << (address & 7))) != 0;
+}
+
+void i2cInsert(I2cAddressSet *set, uint8_t address) {
+    set->bits[(address >> 3) & 0x0F] |=
+        static_cast<uint8_t>(1U << (address & 7));
+}
+
+bool i2cScan(I2cProber *prober, const uint8_t *addresses, uint8_t count,
+             uint32_t budgetMs, I2cAddressSet *found) {
+    uint32_t startMs = prober->nowMs();
+    if (addresses == nullptr) {
+        count = LAST_ADDRESS - FIRST_ADDRESS + 1;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (outOfTime(prober, startMs, budgetMs)) {
+            return false;
+        }
+        uint8_t address = static_cast<uint8_t>(FIRST_ADDRESS + i);
+        if (addresses != nullptr) {
+            address = addresses[i];
+        }
+        if (!i2cContains(found, address) && prober->probe(address)) {
+            i2cInsert(found, address);
+        }
+    }
+    return true;
+}
+
+void i2cDiscover(I2cProber *prober, const DriverDescriptor *table,
+                 uint8_t tableSize, uint32_t budgetMs, Discovery *result) {
+    *result = Discovery();
+    result->complete = true;
+    uint32_t startMs = prober->nowMs();
+
+    I2cAddressSet probed = {};
+    I2cAddressSet claimed = {};
+    for (uint8_t entry = 0; entry < tableSize; entry++) {
+        const DriverDescriptor *driver = &table[entry];
+        for (uint8_t i = 0; i < driver->addressCount; i++) {
+            uint8_t address = driver->addresses[i];
+            if (outOfTime(prober, startMs, budgetMs)) {
+                result->complete = false;
+                return;
+            }
+            // Each address is probed once, whatever the number of drivers
+            if (!i2cContains(&probed, address)) {
+                i2cInsert(&probed, address);
+                if (prober->probe(address)) {
+                    i2cInsert(&result->present, address);
+                }
+            }
+            if (!i2cContains(&result->present, address) ||
+                i2cContains(&claimed, address)) {
+                continue;
+            }
+            if ((driver->identify != nullptr) &&
+                !driver->identify(prober, address)) {
+                continue;
+            }
+            i2cInsert(&claimed, address);
+            if (result->count >= Discovery::MAX_DEVICES) {
+                continue;
+            }
+            void *instance = driver->create(address);
+            if (instance != nullptr) {
+                DiscoveredDevice &device = result->devices[result->count++];
+                device.driver = driver;
+                device.address = address;
+                device.instance = instance;
+            }
+        }
+    }
+}
+
+void *i2cFindDevice(const Discovery *result, DeviceKind kind) {
+    for (uint8_t i = 0; i < result->count; i++) {
+        if (result->devices[i].driver->kind == kind) {
+            return result->devices[i].instance;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace bus
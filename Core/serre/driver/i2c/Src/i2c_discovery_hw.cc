@@ -0,0 +1,51 @@
+#include "../inc/i2c_discovery.hh"
+
+#include "../../../../Inc/i2c.h"
+
+namespace bus {
+
+namespace {
+
+constexpr uint32_t PROBE_TIMEOUT_MS = 2; // Per transfer, bus is idle at boot
+
+/**
+ * @brief Prober over the blocking HAL transfers of hi2c1.
+ */
+class HalI2cProber final : public I2cProber {
+  public:
+    bool probe(uint8_t address) override {
+        return HAL_I2C_IsDeviceReady(&hi2c1,
+                                     static_cast<uint16_t>(address << 1), 1,
+                                     PROBE_TIMEOUT_MS) == HAL_OK;
+    }
+
+    bool query(uint8_t address, const uint8_t *command, uint8_t commandLength,
+               uint16_t delayMs, uint8_t *response,
+               uint8_t responseLength) override {
+        uint16_t deviceAddress = static_cast<uint16_t>(address << 1);
+        if (HAL_I2C_Master_Transmit(&hi2c1, deviceAddress,
+                                    const_cast<uint8_t *>(command),
+                                    commandLength,
+                                    PROBE_TIMEOUT_MS) != HAL_OK) {
+            return false;
+        }
+        HAL_Delay(delayMs);
+        return HAL_I2C_Master_Receive(&hi2c1, deviceAddress, response,
+                                      responseLength,
+                                      PROBE_TIMEOUT_MS) == HAL_OK;
+    }
+
+    uint32_t nowMs() const override {
+        return HAL_GetTick();
+    }
+};
+
+HalI2cProber s_prober;
+
+} // namespace
+
+I2cProber &i2c1Prober() {
+    return s_prober;
+}
+
+} // namespace bus
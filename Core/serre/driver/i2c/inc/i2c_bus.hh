@@ -0,0 +1,261 @@
+#ifndef I2C_BUS_HH
+#define I2C_BUS_HH
+
+// Includes
+#include <stdint.h>
+
+/**
+ * @namespace bus
+ * @brief Contains the shared communication buses.
+ */
+namespace bus {
+
+/**
+ * @brief Outcome of an I2C transaction.
+ */
+enum class I2cResult : uint8_t {
+    IDLE = 0, ///< Never submitted
+    PENDING,  ///< Queued or on the bus
+    OK,       ///< Completed
+    NACK,     ///< Address or data not acknowledged
+    ERROR,    ///< Bus error, arbitration lost or refused by the driver
+    TIMEOUT   ///< Not completed within its timeout, bus reset
+};
+
+struct I2cTransaction;
+
+/**
+ * @brief Completion callback, called from interrupt context.
+ *
+ * Keep it short, typically a Scheduler::signal() of the owning task.
+ *
+ * @param transaction Completed transaction, its result is final.
+ */
+typedef void (*I2cCallback)(I2cTransaction *transaction);
+
+/**
+ * @brief I2C transaction descriptor.
+ *
+ * The write buffer is sent first, then the read buffer is filled after a
+ * repeated start; either may be empty. The descriptor and its buffers are
+ * owned by the caller and must stay valid until the result is final.
+ */
+struct I2cTransaction {
+    uint8_t address;           ///< 7-bit device address
+    const uint8_t *txData;     ///< Bytes to write
+    uint16_t txLength;         ///< Number of bytes to write
+    uint8_t *rxData;           ///< Buffer for the bytes read
+    uint16_t rxLength;         ///< Number of bytes to read
+    uint16_t timeoutMs;        ///< Limit from start to completion
+    I2cCallback callback;      ///< Completion callback, may be nullptr
+    void *context;             ///< Free for the owner
+    volatile I2cResult result; ///< Outcome
+};
+
+/**
+ * @brief Outcome of one transfer phase, reported by the port.
+ */
+enum class I2cTransferStatus : uint8_t {
+    DONE = 0, ///< Phase completed
+    NACK,     ///< Not acknowledged
+    ERROR     ///< Any other bus error
+};
+
+/**
+ * @class I2cPort
+ * @brief Hardware side of the I2C engine.
+ *
+ * A port starts transfers without waiting and reports the end of each phase
+ * through I2cEngine::onTransferDone(), usually from its interrupts.
+ */
+class I2cPort {
+  public:
+    /**
+     * @brief Virtual destructor for I2cPort.
+     */
+    virtual ~I2cPort();
+
+    /**
+     * @brief Starts writing bytes.
+     * @param address 7-bit device address.
+     * @param data Bytes to write.
+     * @param length Number of bytes, not zero.
+     * @param stop True to end with a STOP, false to keep the bus for a read.
+     * @return False if the transfer could not be started.
+     */
+    virtual bool transmit(uint8_t address, const uint8_t *data,
+                          uint16_t length, bool stop) = 0;
+
+    /**
+     * @brief Starts reading bytes, ending with a STOP.
+     * @param address 7-bit device address.
+     * @param data Buffer for the bytes.
+     * @param length Number of bytes, not zero.
+     * @return False if the transfer could not be started.
+     */
+    virtual bool receive(uint8_t address, uint8_t *data, uint16_t length) = 0;
+
+    /**
+     * @brief Stops the current transfer and resets the controller.
+     */
+    virtual void abort() = 0;
+
+    /**
+     * @brief Checks for a slave holding the bus while no transfer runs.
+     * @return True if SDA or SCL is low.
+     */
+    virtual bool isBusStuck() const = 0;
+
+    /**
+     * @brief Frees the bus: clocks SCL until SDA is released, then sends a
+     * STOP and reinitializes the controller.
+     * @return True if both lines are high afterwards.
+     */
+    virtual bool recoverBus() = 0;
+
+    /**
+     * @brief Gets the current time.
+     * @return Tick in milliseconds.
+     */
+    virtual uint32_t nowMs() const = 0;
+
+    /**
+     * @brief Masks the port interrupts, nests with unlock().
+     */
+    virtual void lock() = 0;
+
+    /**
+     * @brief Restores the state saved by the matching lock().
+     */
+    virtual void unlock() = 0;
+};
+
+/**
+ * @brief Transaction counters of an engine.
+ *
+ * @struct I2cStats
+ * @var uint32_t completed
+ *      Transactions ended with OK.
+ * @var uint32_t failed
+ *      Transactions ended with NACK or ERROR.
+ * @var uint32_t timeouts
+ *      Transactions ended with TIMEOUT.
+ * @var uint32_t rejected
+ *      Submissions refused because the queue was full.
+ * @var uint32_t recoveries
+ *      Bus recoveries run after a stuck bus was detected.
+ * @var uint32_t recoveryFailures
+ *      Recoveries that left a line low.
+ * @var uint32_t stuckEpisodes
+ *      Times the bus got stuck after a free spell of at least 5 s.
+ * @var uint32_t failedEpisodes
+ *      Episodes in which at least one recovery failed.
+ * @var uint32_t abandoned
+ *      Episodes in which the engine stopped trying to recover.
+ */
+typedef struct {
+    uint32_t completed;        ///< Ended with OK
+    uint32_t failed;           ///< Ended with NACK or ERROR
+    uint32_t timeouts;         ///< Ended with TIMEOUT
+    uint32_t rejected;         ///< Refused, queue full
+    uint32_t recoveries;       ///< Bus recoveries run
+    uint32_t recoveryFailures; ///< Recoveries leaving a line low
+    uint32_t stuckEpisodes;    ///< Stuck bus episodes
+    uint32_t failedEpisodes;   ///< Episodes with a failed recovery
+    uint32_t abandoned;        ///< Episodes given up
+} I2cStats;
+
+/**
+ * @class I2cEngine
+ * @brief Queues I2C transactions and runs them back-to-back.
+ *
+ * The next transaction is started from the completion interrupt of the
+ * previous one, so the bus stays busy without CPU involvement. poll() only
+ * enforces the timeouts and must run regularly, e.g. from a scheduler task.
+ *
+ * A slave left mid-byte by a brownout can hold SDA low, and the controller
+ * then never gets a START out. The engine checks the lines whenever the bus
+ * should be idle (at each idle poll(), after a timeout and when a transfer
+ * cannot start) and recovers the bus in place. Recoveries run with the
+ * interrupts masked, so within an episode each one doubles the wait before
+ * the next, and after a few failures in a row (a missing pull-up, a line
+ * shorted to ground) the engine gives up until the lines are seen high
+ * again.
+ */
+class I2cEngine {
+  public:
+    /**
+     * @brief Constructor for I2cEngine.
+     * @param port Hardware side.
+     */
+    explicit I2cEngine(I2cPort *port);
+
+    /**
+     * @brief Queues a transaction.
+     * @param transaction Descriptor, its result becomes PENDING.
+     * @return False if the queue is full or the transaction already pending.
+     */
+    bool submit(I2cTransaction *transaction);
+
+    /**
+     * @brief Ends the current transaction if it exceeded its timeout, and
+     * recovers a stuck bus.
+     * @param nowMs Current tick in milliseconds.
+     */
+    void poll(uint32_t nowMs);
+
+    /**
+     * @brief Reports the end of a transfer phase. Called by the port.
+     * @param status Outcome of the phase.
+     */
+    void onTransferDone(I2cTransferStatus status);
+
+    /**
+     * @brief Checks if the engine has nothing to do.
+     * @return True if no transaction is queued or on the bus.
+     */
+    bool isIdle() const;
+
+    /**
+     * @brief Gets the transaction counters.
+     * @return Counters since construction.
+     */
+    const I2cStats &stats() const;
+
+  private:
+    static constexpr uint8_t QUEUE_SIZE = 8; ///< Power of two
+
+    /**
+     * @brief Position of the current transaction.
+     */
+    enum class Phase : uint8_t { IDLE = 0, WRITING, READING };
+
+    void startNext();
+    void finish(I2cResult result);
+    void checkBus();
+
+    I2cPort *m_port = nullptr;                    ///< Hardware side.
+    I2cTransaction *m_queue[QUEUE_SIZE] = {};     ///< Waiting transactions.
+    uint8_t m_head = 0;                           ///< Next to start.
+    uint8_t m_count = 0;                          ///< Number waiting.
+    I2cTransaction *volatile m_current = nullptr; ///< On the bus.
+    volatile Phase m_phase = Phase::IDLE;         ///< Phase of m_current.
+    uint32_t m_startMs = 0;                       ///< Start of m_current.
+    I2cStats m_stats = {};                        ///< Counters.
+    uint32_t m_recoveryMs = 0;                    ///< Last recovery.
+    uint32_t m_backoffMs = 0;                     ///< Wait before the next.
+    uint8_t m_failures = 0;                       ///< Failed in a row.
+    bool m_episode = false;                       ///< Bus stuck lately.
+    bool m_episodeFailed = false;                 ///< Recovery failed in it.
+    bool m_gaveUp = false;                        ///< No more recoveries.
+};
+
+/**
+ * @brief Gets the engine of the I2C1 bus.
+ * @return Engine driving hi2c1.
+ */
+I2cEngine &i2c1();
+
+} // namespace bus
+
+#endif // I2C_BUS_HH
@@ -0,0 +1,165 @@
+#ifndef I2C_DISCOVERY_HH
+#define I2C_DISCOVERY_HH
+
+// Includes
+#include <stdint.h>
+
+namespace bus {
+
+/**
+ * @class I2cProber
+ * @brief Blocking bus access used at boot, before the engine is in use.
+ *
+ * Every call is bounded by the short timeout of the implementation.
+ */
+class I2cProber {
+  public:
+    /**
+     * @brief Virtual destructor for I2cProber.
+     */
+    virtual ~I2cProber();
+
+    /**
+     * @brief Checks if a device acknowledges its address.
+     * @param address 7-bit address.
+     * @return True if the address was acknowledged.
+     */
+    virtual bool probe(uint8_t address) = 0;
+
+    /**
+     * @brief Sends a command, waits, then reads the answer.
+     * @param address 7-bit address.
+     * @param command Command bytes.
+     * @param commandLength Number of command bytes.
+     * @param delayMs Wait between the command and the read.
+     * @param[out] response Buffer for the answer.
+     * @param responseLength Number of bytes to read.
+     * @return True if both transfers were acknowledged.
+     */
+    virtual bool query(uint8_t address, const uint8_t *command,
+                       uint8_t commandLength, uint16_t delayMs,
+                       uint8_t *response, uint8_t responseLength) = 0;
+
+    /**
+     * @brief Gets the current time.
+     * @return Tick in milliseconds.
+     */
+    virtual uint32_t nowMs() const = 0;
+};
+
+/**
+ * @brief Set of 7-bit addresses, one bit each.
+ */
+typedef struct {
+    uint8_t bits[16]; ///< Bit (address % 8) of byte (address / 8)
+} I2cAddressSet;
+
+/**
+ * @brief Checks an address of a set.
+ * @param set Address set.
+ * @param address 7-bit address.
+ * @return True if the address is in the set.
+ */
+bool i2cContains(const I2cAddressSet *set, uint8_t address);
+
+/**
+ * @brief Adds an address to a set.
+ * @param set Address set.
+ * @param address 7-bit address.
+ */
+void i2cInsert(I2cAddressSet *set, uint8_t address);
+
+/**
+ * @brief Probes addresses until done or out of time.
+ * @param prober Bus access.
+ * @param addresses Addresses to probe, nullptr for the whole range
+ * 0x08-0x77.
+ * @param count Number of addresses.
+ * @param budgetMs Time allowed for the whole scan.
+ * @param[out] found Addresses that answered.
+ * @return True if every address was probed within the budget.
+ */
+bool i2cScan(I2cProber *prober, const uint8_t *addresses, uint8_t count,
+             uint32_t budgetMs, I2cAddressSet *found);
+
+/**
+ * @brief Kind of device a driver provides.
+ */
+enum class DeviceKind : uint8_t {
+    AIR_SENSOR = 0, ///< sensor::ShtSensor
+    DISPLAY         ///< ui::Display
+};
+
+/**
+ * @brief Driver entry of the discovery table.
+ *
+ * The table is constant, so it stays in flash. An address answered by a
+ * device is given to the first entry that lists it and identifies it.
+ */
+struct DriverDescriptor {
+    const char *name;         ///< Driver name, for reports
+    DeviceKind kind;          ///< Type of the created instance
+    const uint8_t *addresses; ///< Addresses the device can use
+    uint8_t addressCount;     ///< Number of addresses
+    /**
+     * @brief Tells this device from others at the same address, may be
+     * nullptr to accept any device that answers.
+     */
+    bool (*identify)(I2cProber *prober, uint8_t address);
+    /**
+     * @brief Constructs the driver in static storage.
+     * @return Instance, nullptr when the storage is exhausted.
+     */
+    void *(*create)(uint8_t address);
+};
+
+/**
+ * @brief Driver instantiated by the discovery.
+ */
+struct DiscoveredDevice {
+    const DriverDescriptor *driver; ///< Table entry
+    uint8_t address;                ///< Address the device answered at
+    void *instance;                 ///< Driver, of type driver->kind
+};
+
+/**
+ * @brief Result of a discovery.
+ */
+struct Discovery {
+    static constexpr uint8_t MAX_DEVICES = 4;
+
+    DiscoveredDevice devices[MAX_DEVICES]; ///< Instantiated drivers
+    uint8_t count;                         ///< Number of devices
+    I2cAddressSet present;                 ///< Addresses that answered
+    bool complete;                         ///< Finished within the budget
+};
+
+/**
+ * @brief Probes the addresses of a driver table and instantiates the
+ * drivers of the devices found.
+ * @param prober Bus access.
+ * @param table Driver table.
+ * @param tableSize Number of entries.
+ * @param budgetMs Time allowed for probing and identification.
+ * @param[out] result Devices found.
+ */
+void i2cDiscover(I2cProber *prober, const DriverDescriptor *table,
+                 uint8_t tableSize, uint32_t budgetMs, Discovery *result);
+
+/**
+ * @brief Finds the first discovered device of a kind.
+ * @param result Discovery result.
+ * @param kind Kind of device.
+ * @return Driver instance, nullptr if none was found.
+ */
+void *i2cFindDevice(const Discovery *result, DeviceKind kind);
+
+/**
+ * @brief Gets the boot-time prober of the I2C1 bus.
+ * @return Prober driving hi2c1 in blocking mode.
+ */
+I2cProber &i2c1Prober();
+
+} // namespace bus
+
+#endif // I2C_DISCOVERY_HH
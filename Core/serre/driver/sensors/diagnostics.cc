@@ -0,0 +1,88 @@
+#include "diagnostics.hh"
+
+namespace sensor {
+
+namespace {
+
+constexpr uint16_t ADC_FULL_SCALE = 4095;
+constexpr uint16_t STEP_MASK = (1U << ProbeDiagnostics::WINDOW) - 1U;
+
+} // namespace
+
+void ProbeDiagnostics::setLimits(DiagnosticLimits limits) {
+    *this = ProbeDiagnostics();
+    this->m_limits = limits;
+}
+
+void ProbeDiagnostics::add(uint16_t sample, uint16_t dropped) {
+    bool jump = false;
+    if (this->m_count > 0) {
+        uint16_t step = (sample > this->m_previous)
+                            ? static_cast<uint16_t>(sample - this->m_previous)
+                            : static_cast<uint16_t>(this->m_previous - sample);
+        jump = step > this->m_limits.maxStep;
+    }
+    this->m_steps =
+        static_cast<uint16_t>(((this->m_steps << 1) | (jump ? 1U : 0U)) &
+                              STEP_MASK);
+    this->m_previous = sample;
+
+    if (this->m_count < WINDOW) {
+        this->m_count++;
+    } else {
+        this->m_sum -= dropped;
+        this->m_sumSquares -= static_cast<uint32_t>(dropped) * dropped;
+        if (this->isRail(dropped)) {
+            this->m_railCount--;
+        }
+    }
+    this->m_sum += sample;
+    this->m_sumSquares += static_cast<uint32_t>(sample) * sample;
+    if (this->isRail(sample)) {
+        this->m_railCount++;
+    }
+
+    // A flat window is only counted once all its samples are new
+    if (++this->m_sinceTurn >= WINDOW) {
+        this->m_sinceTurn = 0;
+        bool flat = (WINDOW * this->m_sumSquares) ==
+                    (this->m_sum * this->m_sum);
+        if (!flat) {
+            this->m_flatTurns = 0;
+        } else if (this->m_flatTurns < 0xFF) {
+            this->m_flatTurns++;
+        }
+    }
+}
+
+ProbeFault ProbeDiagnostics::fault() const {
+    if (this->m_count == 0) {
+        return ProbeFault::NONE;
+    }
+    if (this->m_railCount == this->m_count) {
+        return ProbeFault::RAIL;
+    }
+    if ((this->m_limits.stuckTurns > 0) &&
+        (this->m_flatTurns >= this->m_limits.stuckTurns)) {
+        return ProbeFault::STUCK;
+    }
+    if (this->m_steps != 0) {
+        return ProbeFault::RATE;
+    }
+    // n Σx² - (Σx)² is n² times the variance
+    uint32_t n = this->m_count;
+    uint32_t spread = n * this->m_sumSquares - this->m_sum * this->m_sum;
+    uint32_t limit = static_cast<uint32_t>(this->m_limits.maxNoise) *
+                     this->m_limits.maxNoise * n * n;
+    if (spread > limit) {
+        return ProbeFault::NOISE;
+    }
+    return ProbeFault::NONE;
+}
+
+bool ProbeDiagnostics::isRail(uint16_t sample) const {
+    return (sample <= this->m_limits.railMargin) ||
+           (sample >= ADC_FULL_SCALE - this->m_limits.railMargin);
+}
+
+} // namespace sensor
@@ -0,0 +1,87 @@
+#ifndef DIAGNOSTICS_HH
+#define DIAGNOSTICS_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sensor {
+
+/**
+ * @brief Why the readings of an analog probe cannot be trusted.
+ */
+enum class ProbeFault : uint8_t {
+    NONE = 0, ///< Readings plausible
+    RAIL,     ///< Whole window at 0 or full scale: open or shorted probe
+    STUCK,    ///< Identical samples for stuckTurns windows in a row
+    RATE,     ///< Jump between two reads faster than the physics allows
+    NOISE     ///< Spread over the window above the noise limit
+};
+
+/**
+ * @brief Plausibility limits of an analog probe, in ADC counts.
+ *
+ * @struct DiagnosticLimits
+ * @var uint16_t railMargin
+ *      Distance to 0 or 4095 read as a rail.
+ * @var uint16_t maxStep
+ *      Largest plausible change between two consecutive reads.
+ * @var uint16_t maxNoise
+ *      Largest plausible standard deviation over the window.
+ * @var uint8_t stuckTurns
+ *      Flat windows in a row read as a stuck value, 0 to never flag it.
+ */
+typedef struct {
+    uint16_t railMargin; ///< Counts from a rail
+    uint16_t maxStep;    ///< Largest step between two reads
+    uint16_t maxNoise;   ///< Largest standard deviation
+    uint8_t stuckTurns;  ///< Flat windows before STUCK
+} DiagnosticLimits;
+
+/**
+ * @class ProbeDiagnostics
+ * @brief Plausibility checks over the sample window of an analog probe.
+ *
+ * The window statistics are running sums updated with each sample entering
+ * and leaving the window, so add() and fault() are O(1) whatever the window
+ * length.
+ */
+class ProbeDiagnostics {
+  public:
+    static constexpr uint8_t WINDOW = 10; ///< Samples in the window.
+
+    /**
+     * @brief Sets the limits and forgets the samples seen so far.
+     * @param limits Plausibility limits of the probe.
+     */
+    void setLimits(DiagnosticLimits limits);
+
+    /**
+     * @brief Accounts for a new sample.
+     * @param sample Sample entering the window.
+     * @param dropped Sample leaving it, ignored until the window is full.
+     */
+    void add(uint16_t sample, uint16_t dropped);
+
+    /**
+     * @brief Checks the window against the limits.
+     * @return Most severe fault found, NONE before the first sample.
+     */
+    ProbeFault fault() const;
+
+  private:
+    bool isRail(uint16_t sample) const;
+
+    DiagnosticLimits m_limits = {}; ///< Plausibility limits.
+    uint32_t m_sum = 0;             ///< Σx over the window.
+    uint32_t m_sumSquares = 0;      ///< Σx² over the window.
+    uint16_t m_previous = 0;        ///< Last sample, for the step check.
+    uint16_t m_steps = 0;           ///< One bit per read, set on a jump.
+    uint8_t m_count = 0;            ///< Samples in the window.
+    uint8_t m_railCount = 0;        ///< Samples of the window at a rail.
+    uint8_t m_sinceTurn = 0;        ///< Samples since the last full turn.
+    uint8_t m_flatTurns = 0;        ///< Flat windows in a row.
+};
+
+} // namespace sensor
+
+#endif // DIAGNOSTICS_HH
@@ -0,0 +1,78 @@
+#include "../inc/die_temp.hh"
+
+namespace sensor {
+
+namespace {
+
+constexpr int32_t CAL1_TENTHS = 300;  ///< TS_CAL1 temperature (0.1 °C)
+constexpr int32_t CAL2_TENTHS = 1300; ///< TS_CAL2 temperature (0.1 °C)
+constexpr int32_t CAL_VDDA_MV = 3000; ///< VDDA of the calibration
+constexpr int32_t VDDA_MV = 3300;     ///< VDDA of the board
+constexpr int32_t MIN_TENTHS = -400;  ///< Lowest die temperature (0.1 °C)
+constexpr int32_t MAX_TENTHS = 1250;  ///< Highest die temperature (0.1 °C)
+
+// The die temperature barely moves and often reads the same count for
+// minutes: rails and jumps only, never STUCK
+const DiagnosticLimits DIAGNOSTIC_LIMITS = {16, 200, 40, 0};
+
+/**
+ * @brief Divides, rounding half away from zero.
+ */
+int32_t divideRounded(int32_t numerator, int32_t denominator) {
+    return (numerator >= 0) ? (numerator + denominator / 2) / denominator
+                            : (numerator - denominator / 2) / denominator;
+}
+
+} // namespace
+
+DieTempSensor::DieTempSensor(sensor::SensorConfig config,
+                             DieTempCalibration calibration) {
+    this->m_config = config;
+    this->m_calibration = calibration;
+    this->setDiagnosticLimits(DIAGNOSTIC_LIMITS);
+}
+
+void DieTempSensor::processData() {
+    int32_t span = static_cast<int32_t>(this->m_calibration.cal2) -
+                   static_cast<int32_t>(this->m_calibration.cal1);
+    if ((this->m_numSamples == 0) || (span <= 0)) {
+        // No sample yet, or erased calibration bytes
+        this->m_dataValid = false;
+        return;
+    }
+
+    // Sum of the ring, brought back to the 3.0 V of the calibration:
+    // at most 10 * 4095 * 3300, well within 32 bits
+    int32_t count = this->m_numSamples;
+    int32_t sum = 0;
+    for (uint8_t i = 0; i < this->m_numSamples; i++) {
+        sum += this->m_rawADC[i];
+    }
+    int32_t scaled = divideRounded(sum * VDDA_MV, CAL_VDDA_MV);
+
+    int32_t tenths =
+        CAL1_TENTHS +
+        divideRounded((scaled - count * this->m_calibration.cal1) *
+                          (CAL2_TENTHS - CAL1_TENTHS),
+                      count * span);
+    this->m_tenths = static_cast<int16_t>(tenths);
+    this->m_dataValid = (tenths >= MIN_TENTHS) && (tenths <= MAX_TENTHS) &&
+                        (this->probeFault() == ProbeFault::NONE);
+}
+
+int16_t DieTempSensor::getTemperatureTenths() const {
+    return this->m_tenths;
+}
+
+float DieTempSensor::getTemperatureCelsius() const {
+    return static_cast<float>(this->m_tenths) / 10.0f;
+}
+
+bool DieTempSensor::isTemperatureValid() const {
+    return this->m_dataValid;
+}
+
+DieTempSensor::~DieTempSensor() {
+}
+
+} // namespace sensor
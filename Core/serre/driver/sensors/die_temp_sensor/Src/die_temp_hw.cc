@@ -0,0 +1,11 @@
+#include "../inc/die_temp.hh"
+
+namespace sensor {
+
+DieTempCalibration dieTempCalibration() {
+    DieTempCalibration calibration = {*TEMPSENSOR_CAL1_ADDR,
+                                      *TEMPSENSOR_CAL2_ADDR};
+    return calibration;
+}
+
+} // namespace sensor
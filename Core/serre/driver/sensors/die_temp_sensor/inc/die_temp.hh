@@ -0,0 +1,81 @@
+#ifndef DIE_TEMP_HH
+#define DIE_TEMP_HH
+
+#include "../../sensor.hh"
+
+namespace sensor {
+
+/**
+ * @brief Factory calibration of the internal temperature sensor.
+ *
+ * @struct DieTempCalibration
+ * @var uint16_t cal1
+ *      TS_CAL1: conversion result at 30 °C, with VDDA = 3.0 V.
+ * @var uint16_t cal2
+ *      TS_CAL2: conversion result at 130 °C, with VDDA = 3.0 V.
+ */
+typedef struct {
+    uint16_t cal1; ///< Raw value at 30 °C
+    uint16_t cal2; ///< Raw value at 130 °C
+} DieTempCalibration;
+
+/**
+ * @brief Reads TS_CAL1 and TS_CAL2 from the system memory.
+ * @return Calibration written in production.
+ */
+DieTempCalibration dieTempCalibration();
+
+/**
+ * @class DieTempSensor
+ * @brief Internal temperature sensor of the MCU, derived from the
+ * AnalogSensor base class.
+ *
+ * The die runs a few degrees above the air of the enclosure, so it is a
+ * cross-check of the air probe and a board overheat monitor rather than a
+ * climate measurement. The conversion uses the two factory calibration
+ * points in integer math, with VDDA taken as the nominal 3.3 V like the
+ * external probes. The channel needs a sampling time of at least 5 us.
+ */
+class DieTempSensor final : public AnalogSensor {
+  public:
+    /**
+     * @brief Constructor for DieTempSensor.
+     * @param config Sensor configuration, on ADC_CHANNEL_TEMPSENSOR.
+     * @param calibration Factory calibration, from dieTempCalibration().
+     */
+    DieTempSensor(sensor::SensorConfig config,
+                  DieTempCalibration calibration);
+    virtual ~DieTempSensor() override;
+
+    /**
+     * @brief Processes the raw data to calculate the die temperature.
+     */
+    void processData() override;
+
+    /**
+     * @brief Gets the die temperature.
+     * @return Temperature in tenths of a degree Celsius.
+     */
+    int16_t getTemperatureTenths() const;
+
+    /**
+     * @brief Gets the die temperature.
+     * @return Temperature in Celsius.
+     */
+    float getTemperatureCelsius() const;
+
+    /**
+     * @brief Checks if the temperature data is valid.
+     * @return False with a blank calibration or out of the -40 to 125 °C
+     * operating range.
+     */
+    bool isTemperatureValid() const;
+
+  private:
+    DieTempCalibration m_calibration; ///< Factory calibration points.
+    int16_t m_tenths = 0;             ///< Current temperature (0.1 °C).
+};
+
+} // namespace sensor
+
+#endif // DIE_TEMP_HH
@@ -0,0 +1,49 @@
+#include "report.hh"
+
+#include "../../system/text/inc/line_writer.hh"
+
+#include <math.h>
+
+namespace sensor {
+
+ReportFilter::ReportFilter(ReportPolicy policy) : m_policy(policy) {
+}
+
+bool ReportFilter::accept(const Reading &reading, uint32_t nowMs) {
+    if (reading.source == Source::NONE) {
+        return false;
+    }
+    bool record = (this->m_records == 0) ||
+                  (reading.valid != this->m_last.valid) ||
+                  (reading.source != this->m_last.source) ||
+                  (fabsf(reading.value - this->m_last.value) >=
+                   this->m_policy.deadband) ||
+                  ((this->m_policy.heartbeatMs != 0) &&
+                   ((nowMs - this->m_lastMs) >= this->m_policy.heartbeatMs));
+    if (record) {
+        this->m_last = reading;
+        this->m_lastMs = nowMs;
+        this->m_records++;
+    }
+    return record;
+}
+
+uint32_t ReportFilter::records() const {
+    return this->m_records;
+}
+
+size_t reportFormat(const char *name, const Reading *reading, char *buffer,
+                    size_t size) {
+    sys::LineWriter out(buffer, size);
+    out.text("tel ");
+    out.text(name);
+    out.text(" ");
+    out.fixed(reading->value);
+    out.text((reading->source == Source::DIGITAL) ? " digital" : " analog");
+    if (!reading->valid) {
+        out.text(" invalid");
+    }
+    return out.length();
+}
+
+} // namespace sensor
@@ -0,0 +1,81 @@
+#ifndef REPORT_HH
+#define REPORT_HH
+
+// Includes
+#include "snapshot.hh"
+
+#include <stddef.h>
+
+namespace sensor {
+
+/**
+ * @brief When a measured quantity is worth a record.
+ *
+ * @struct ReportPolicy
+ * @var float deadband
+ *      Change from the last record that triggers a new one, in the unit of
+ *      the reading.
+ * @var uint32_t heartbeatMs
+ *      Longest silence: a record is sent after it even without change. 0
+ *      disables the heartbeat.
+ */
+typedef struct {
+    float deadband;       ///< Change triggering a record
+    uint32_t heartbeatMs; ///< Longest time between records, 0 for none
+} ReportPolicy;
+
+/**
+ * @class ReportFilter
+ * @brief Deadband and heartbeat gate in front of a record stream.
+ *
+ * The change is measured from the last value let through, not from the
+ * previous sample, so a slow drift is still reported once it adds up to
+ * the deadband. A change of validity or source always makes a record.
+ */
+class ReportFilter {
+  public:
+    /**
+     * @brief Constructor for ReportFilter.
+     * @param policy Deadband and heartbeat.
+     */
+    explicit ReportFilter(ReportPolicy policy);
+
+    /**
+     * @brief Decides if a reading must be recorded, and remembers it if so.
+     * @param reading Latest reading.
+     * @param nowMs Current tick in milliseconds.
+     * @return True if the reading must be recorded.
+     */
+    bool accept(const Reading &reading, uint32_t nowMs);
+
+    /**
+     * @brief Gets the number of readings let through.
+     * @return Records since construction.
+     */
+    uint32_t records() const;
+
+  private:
+    ReportPolicy m_policy;  ///< Deadband and heartbeat.
+    Reading m_last = {};    ///< Last reading let through.
+    uint32_t m_lastMs = 0;  ///< Tick of the last record.
+    uint32_t m_records = 0; ///< Readings let through.
+};
+
+/**
+ * @brief Formats a record line, without line ending.
+ *
+ * Example: "tel temperature 21.50 analog", with " invalid" appended when
+ * the sensor flagged the value.
+ *
+ * @param name Name of the quantity.
+ * @param reading Reading to record.
+ * @param[out] buffer Destination, always NUL-terminated.
+ * @param size Size of the buffer.
+ * @return Number of characters written, without the NUL.
+ */
+size_t reportFormat(const char *name, const Reading *reading, char *buffer,
+                    size_t size);
+
+} // namespace sensor
+
+#endif // REPORT_HH
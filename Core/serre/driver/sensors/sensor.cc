@@ -1,9 +1,12 @@
 #include "sensor.hh"
 
+#include "../../system/profile/inc/profile.hh"
+#include "../../system/ramfunc.hh"
+
 namespace sensor {
 
-HAL_StatusTypeDef Sensor::sensor_readHelper(uint16_t *outValue) {
-    if (outValue == nullptr) {
+HAL_StatusTypeDef AnalogSensor::sensor_readHelper(uint16_t *outValue) {
+    if ((outValue == nullptr) || (this->m_config.adcHandle == nullptr)) {
         return HAL_ERROR;
     }
 
@@ -12,14 +15,20 @@ HAL_StatusTypeDef Sensor::sensor_readHelper(uint16_t *outValue) {
     sConfig.Rank = ADC_REGULAR_RANK_1;
     sConfig.SamplingTime = this->m_config.adcSamplingTime;
 
-    if (HAL_ADC_ConfigChannel(this->m_config.adcHandle, &sConfig) != HAL_OK) {
-        Error_Handler();
+    HAL_StatusTypeDef status =
+        HAL_ADC_ConfigChannel(this->m_config.adcHandle, &sConfig);
+    if (status != HAL_OK) {
+        return status;
     }
-    if (HAL_ADC_Start(this->m_config.adcHandle) != HAL_OK) {
-        return HAL_ERROR;
+    status = HAL_ADC_Start(this->m_config.adcHandle);
+    if (status != HAL_OK) {
+        return status;
     }
-    if (HAL_ADC_PollForConversion(this->m_config.adcHandle,
-                                  this->m_config.adcTimeout) != HAL_OK) {
+    SERRE_PROFILE_BEGIN(ADC_POLL);
+    status = HAL_ADC_PollForConversion(this->m_config.adcHandle,
+                                       this->m_config.adcTimeout);
+    SERRE_PROFILE_END(ADC_POLL);
+    if (status != HAL_OK) {
         HAL_ADC_Stop(this->m_config.adcHandle);
         return HAL_TIMEOUT;
     }
@@ -29,30 +38,70 @@ HAL_StatusTypeDef Sensor::sensor_readHelper(uint16_t *outValue) {
     return HAL_OK;
 }
 
-HAL_StatusTypeDef Sensor::readData() {
+HAL_StatusTypeDef AnalogSensor::readData() {
     // Read raw ADC value from the sensor
-    if (this->sensor_readHelper(&(this->m_rawADC[this->m_sampleIndex])) !=
-        HAL_OK) {
-        return HAL_ERROR;
+    uint16_t dropped = this->m_rawADC[this->m_sampleIndex];
+    HAL_StatusTypeDef status =
+        this->sensor_readHelper(&(this->m_rawADC[this->m_sampleIndex]));
+    if (status != HAL_OK) {
+        return status;
     } else {
+        this->m_diagnostics.add(this->m_rawADC[this->m_sampleIndex], dropped);
         this->m_sampleIndex = (this->m_sampleIndex + 1) % 10;
         if (this->m_numSamples < 10) {
             this->m_numSamples++;
         }
+        // One trend point per turn: the ring then holds 10 new samples
+        if (this->m_sampleIndex == 0) {
+            uint16_t sum = 0;
+            for (uint8_t i = 0; i < 10; i++) {
+                sum += this->m_rawADC[i];
+            }
+            this->m_trend.add(sum);
+        }
         return HAL_OK;
     }
 }
 
-void Sensor::processData() {
+// Filter kernel, run from RAM. Summing integers keeps the soft-float
+// helpers, which stay in flash, out of the loop.
+SERRE_RAMFUNC void AnalogSensor::processData() {
     uint8_t numSamples = this->m_numSamples > 0 ? this->m_numSamples : 1;
-    this->m_processedValue = 0.0f;
+    uint32_t sum = 0;
     for (uint8_t i = 0; i < numSamples; i++) {
-        this->m_processedValue += this->m_rawADC[i];
+        sum += this->m_rawADC[i];
     }
-    this->m_processedValue /= static_cast<float>(numSamples);
+    this->m_processedValue =
+        static_cast<float>(sum) / static_cast<float>(numSamples);
+}
+
+bool AnalogSensor::isTrendReady() const {
+    return (this->m_config.samplePeriodMs > 0) &&
+           (this->m_trend.count() >= TREND_MIN_POINTS);
+}
+
+float AnalogSensor::rawSlopePerMinute() const {
+    if (!this->isTrendReady()) {
+        return 0.0f;
+    }
+    // Points are sums of 10 samples, 10 read periods apart
+    float pointMinutes =
+        (10.0f * static_cast<float>(this->m_config.samplePeriodMs)) / 60000.0f;
+    return this->m_trend.slope() / (10.0f * pointMinutes);
+}
+
+ProbeFault AnalogSensor::probeFault() const {
+    return this->m_diagnostics.fault();
+}
+
+void AnalogSensor::setDiagnosticLimits(DiagnosticLimits limits) {
+    this->m_diagnostics.setLimits(limits);
 }
 
 Sensor::~Sensor() {
 }
 
+AnalogSensor::~AnalogSensor() {
+}
+
 } // namespace sensor
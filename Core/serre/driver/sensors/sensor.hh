@@ -3,6 +3,8 @@
 
 // Includes
 #include "../../../Inc/adc.h"
+#include "diagnostics.hh"
+#include "trend.hh"
 /**
  * @namespace sensor
  * @brief Contains classes and methods for handling various sensors.
@@ -25,21 +27,24 @@ namespace sensor {
  *      ADC sampling time configuration for the sensor.
  * @var uint32_t adcTimeout
  *      Timeout duration (in milliseconds) for ADC read operations.
+ * @var uint32_t samplePeriodMs
+ *      Interval between readData() calls, 0 to disable the trend.
  */
 typedef struct {
     ADC_HandleTypeDef *adcHandle; ///< Pointer to the ADC handle
     uint32_t adcChannel;          ///< ADC channel number
     uint32_t adcSamplingTime;     ///< ADC sampling time
     uint32_t adcTimeout;          ///< ADC read timeout in milliseconds
+    uint32_t samplePeriodMs;      ///< Read interval, for the trend
 } SensorConfig;
 
 /**
  * @class Sensor
  * @brief Abstract base class for sensor management.
  *
- * This class provides an interface for initializing, reading, and processing
- * data from sensors. It includes a configuration structure for sensor
- * parameters, including timeout configuration.
+ * This class provides the interface for reading and processing data from
+ * sensors, whatever their transport: readData() acquires a raw sample and
+ * processData() converts it.
  *
  * @note Derived classes must implement the virtual methods to provide specific
  *       sensor functionality.
@@ -50,16 +55,67 @@ class Sensor {
      * @brief Virtual destructor for Sensor.
      */
     virtual ~Sensor();
-    
+
     /**
-     * @brief Reads data from the temperature sensor.
+     * @brief Acquires a raw sample from the sensor.
+     * @return HAL status of the acquisition.
      */
-    HAL_StatusTypeDef readData();
+    virtual HAL_StatusTypeDef readData() = 0;
+
+    /**
+     * @brief Processes the raw data and updates the processed value.
+     */
+    virtual void processData() = 0;
+
+  protected:
+    bool m_dataValid = false; ///< Flag indicating if the data is valid.
+};
+
+/**
+ * @class AnalogSensor
+ * @brief Base class for sensors read through an ADC channel.
+ *
+ * Samples are averaged over the last 10 reads. Each full turn of the
+ * sample ring also adds its sum to a SlopeEstimator, giving the trend over
+ * the last SlopeEstimator::WINDOW turns (2 minutes at one read per second).
+ * The same window goes through ProbeDiagnostics: derived classes report
+ * their data invalid while probeFault() is not NONE.
+ */
+class AnalogSensor : public Sensor {
+  public:
+    /**
+     * @brief Virtual destructor for AnalogSensor.
+     */
+    virtual ~AnalogSensor() override;
+
+    /**
+     * @brief Reads data from the sensor's ADC channel.
+     * @return HAL status of the ADC read, HAL_ERROR without an ADC handle.
+     */
+    HAL_StatusTypeDef readData() override;
 
     /**
      * @brief Processes the raw ADC data and updates the processed value.
      */
-    virtual void processData();
+    void processData() override;
+
+    /**
+     * @brief Checks if enough ring turns were seen to trust the trend.
+     * @return True once TREND_MIN_POINTS turns were completed.
+     */
+    bool isTrendReady() const;
+
+    /**
+     * @brief Checks the sample window for a faulty probe.
+     * @return Most severe fault found, NONE if the readings are plausible.
+     */
+    ProbeFault probeFault() const;
+
+    /**
+     * @brief Sets the plausibility limits, restarting the diagnostics.
+     * @param limits Rail margin, step, noise and stuck limits in counts.
+     */
+    void setDiagnosticLimits(DiagnosticLimits limits);
 
   protected:
     /**
@@ -69,17 +125,25 @@ class Sensor {
      */
     HAL_StatusTypeDef sensor_readHelper(uint16_t *outValue);
 
+    /**
+     * @brief Gets the trend of the raw ADC value.
+     * @return ADC counts per minute, 0 until the trend is ready.
+     */
+    float rawSlopePerMinute() const;
 
     /**
      * @brief Sensor configuration structure.
      */
     SensorConfig m_config = {};
 
-    uint8_t m_numSamples = 0;    ///< Number of samples to average.
-    bool m_dataValid = false;    ///< Flag indicating if the data is valid.
-    uint16_t m_rawADC[10] = {0}; ///< Raw ADC value from the sensor.
-    float m_processedValue = 0;  ///< Processed sensor value.
-    uint8_t m_sampleIndex = 0;   ///< Index for sampling multiple readings.
+    uint8_t m_numSamples = 0;       ///< Number of samples to average.
+    uint16_t m_rawADC[10] = {0};    ///< Raw ADC value from the sensor.
+    float m_processedValue = 0;     ///< Processed sensor value.
+    uint8_t m_sampleIndex = 0;      ///< Index for sampling multiple readings.
+    SlopeEstimator m_trend;         ///< Slope of the ring sums.
+    ProbeDiagnostics m_diagnostics; ///< Plausibility of the ring.
+
+    static constexpr uint8_t TREND_MIN_POINTS = 4; ///< 40 s at 1 Hz.
 };
 
 } // namespace sensor
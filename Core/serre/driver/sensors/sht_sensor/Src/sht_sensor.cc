@@ -0,0 +1,172 @@
+#include "../inc/sht_sensor.hh"
+
+namespace sensor {
+
+namespace {
+
+constexpr uint16_t SHT3X_MEASURE_HIGH = 0x2400; // No clock stretching
+constexpr uint8_t SHT4X_MEASURE_HIGH = 0xFD;
+constexpr uint8_t SHT3X_READ_SERIAL[] = {0x37, 0x80};
+constexpr uint8_t SHT4X_READ_SERIAL[] = {0x89};
+constexpr uint16_t SERIAL_DELAY_MS = 1;
+constexpr uint16_t SHT3X_CONVERSION_MS = 16; // 15.5 ms max
+constexpr uint16_t SHT4X_CONVERSION_MS = 9;  // 8.3 ms max
+constexpr float RAW_FULL_SCALE = 65535.0f;
+
+} // namespace
+
+uint8_t shtCrc(const uint8_t *data, uint8_t length) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (crc & 0x80) {
+                crc = static_cast<uint8_t>((crc << 1) ^ 0x31);
+            } else {
+                crc = static_cast<uint8_t>(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+bool shtIdentify(bus::I2cProber *prober, uint8_t address, ShtModel model) {
+    uint8_t response[6] = {0};
+    bool answered;
+    if (model == ShtModel::SHT3X) {
+        answered = prober->query(address, SHT3X_READ_SERIAL,
+                                 sizeof(SHT3X_READ_SERIAL), SERIAL_DELAY_MS,
+                                 response, sizeof(response));
+    } else {
+        answered = prober->query(address, SHT4X_READ_SERIAL,
+                                 sizeof(SHT4X_READ_SERIAL), SERIAL_DELAY_MS,
+                                 response, sizeof(response));
+    }
+    return answered && (shtCrc(&response[0], 2) == response[2]) &&
+           (shtCrc(&response[3], 2) == response[5]);
+}
+
+ShtSensor::ShtSensor(ShtConfig config) {
+    this->m_config = config;
+    this->m_transaction.address = config.address;
+    this->m_transaction.timeoutMs = config.timeoutMs;
+    this->m_transaction.result = bus::I2cResult::IDLE;
+}
+
+void ShtSensor::setCallback(bus::I2cCallback callback, void *context) {
+    this->m_transaction.callback = callback;
+    this->m_transaction.context = context;
+}
+
+HAL_StatusTypeDef ShtSensor::trigger() {
+    if (this->m_config.model == ShtModel::SHT3X) {
+        this->m_command[0] = static_cast<uint8_t>(SHT3X_MEASURE_HIGH >> 8);
+        this->m_command[1] = static_cast<uint8_t>(SHT3X_MEASURE_HIGH & 0xFF);
+        return this->submit(Step::TRIGGER, this->m_command, 2, nullptr, 0);
+    }
+    this->m_command[0] = SHT4X_MEASURE_HIGH;
+    return this->submit(Step::TRIGGER, this->m_command, 1, nullptr, 0);
+}
+
+HAL_StatusTypeDef ShtSensor::fetch() {
+    return this->submit(Step::FETCH, nullptr, 0, this->m_response,
+                        sizeof(this->m_response));
+}
+
+uint16_t ShtSensor::conversionTimeMs() const {
+    if (this->m_config.model == ShtModel::SHT3X) {
+        return SHT3X_CONVERSION_MS;
+    }
+    return SHT4X_CONVERSION_MS;
+}
+
+bool ShtSensor::isBusy() const {
+    return this->m_transaction.result == bus::I2cResult::PENDING;
+}
+
+HAL_StatusTypeDef ShtSensor::readData() {
+    if (this->m_step != Step::FETCH) {
+        return HAL_ERROR;
+    }
+    switch (this->m_transaction.result) {
+    case bus::I2cResult::PENDING:
+        return HAL_BUSY;
+    case bus::I2cResult::OK:
+        break;
+    case bus::I2cResult::TIMEOUT:
+        this->m_step = Step::IDLE;
+        return HAL_TIMEOUT;
+    default:
+        this->m_step = Step::IDLE;
+        return HAL_ERROR;
+    }
+    this->m_step = Step::IDLE;
+
+    const uint8_t *response = this->m_response;
+    if ((shtCrc(&response[0], 2) != response[2]) ||
+        (shtCrc(&response[3], 2) != response[5])) {
+        this->m_dataValid = false;
+        return HAL_ERROR;
+    }
+    this->m_rawTemperature =
+        static_cast<uint16_t>((response[0] << 8) | response[1]);
+    this->m_rawHumidity =
+        static_cast<uint16_t>((response[3] << 8) | response[4]);
+    this->m_dataValid = true;
+    return HAL_OK;
+}
+
+void ShtSensor::processData() {
+    float temperature = static_cast<float>(this->m_rawTemperature);
+    float humidity = static_cast<float>(this->m_rawHumidity);
+    this->m_temperature = -45.0f + (175.0f * temperature / RAW_FULL_SCALE);
+
+    if (this->m_config.model == ShtModel::SHT3X) {
+        this->m_humidity = 100.0f * humidity / RAW_FULL_SCALE;
+    } else {
+        // SHT4x can report slightly outside 0-100 %RH, clamp as advised
+        this->m_humidity = -6.0f + (125.0f * humidity / RAW_FULL_SCALE);
+        if (this->m_humidity < 0.0f) {
+            this->m_humidity = 0.0f;
+        } else if (this->m_humidity > 100.0f) {
+            this->m_humidity = 100.0f;
+        }
+    }
+}
+
+float ShtSensor::getTemperatureCelsius() const {
+    return this->m_temperature;
+}
+
+float ShtSensor::getHumidityPercent() const {
+    return this->m_humidity;
+}
+
+bool ShtSensor::isDataValid() const {
+    return this->m_dataValid;
+}
+
+HAL_StatusTypeDef ShtSensor::submit(Step step, const uint8_t *txData,
+                                    uint16_t txLength, uint8_t *rxData,
+                                    uint16_t rxLength) {
+    if (this->m_config.bus == nullptr) {
+        return HAL_ERROR;
+    }
+    if (this->isBusy()) {
+        return HAL_BUSY;
+    }
+    this->m_transaction.txData = txData;
+    this->m_transaction.txLength = txLength;
+    this->m_transaction.rxData = rxData;
+    this->m_transaction.rxLength = rxLength;
+    if (!this->m_config.bus->submit(&this->m_transaction)) {
+        return HAL_ERROR;
+    }
+    this->m_step = step;
+    return HAL_OK;
+}
+
+ShtSensor::~ShtSensor() {
+}
+
+} // namespace sensor
@@ -0,0 +1,161 @@
+#ifndef SHT_SENSOR_HH
+#define SHT_SENSOR_HH
+
+#include "../../../i2c/inc/i2c_bus.hh"
+#include "../../../i2c/inc/i2c_discovery.hh"
+#include "../../sensor.hh"
+
+namespace sensor {
+
+/**
+ * @brief Supported Sensirion humidity and temperature sensors.
+ */
+enum class ShtModel : uint8_t {
+    SHT3X = 0, ///< SHT30/31/35, 16-bit commands
+    SHT4X      ///< SHT40/41/45, 8-bit commands
+};
+
+/**
+ * @brief Configuration structure for an SHT sensor on an I2C bus.
+ *
+ * @struct ShtConfig
+ * @var bus::I2cEngine *bus
+ *      Engine of the bus the sensor is on.
+ * @var uint8_t address
+ *      7-bit address (0x44 or 0x45).
+ * @var ShtModel model
+ *      Sensor family.
+ * @var uint16_t timeoutMs
+ *      Timeout of each I2C transaction.
+ */
+typedef struct {
+    bus::I2cEngine *bus; ///< Engine of the bus
+    uint8_t address;     ///< 7-bit address
+    ShtModel model;      ///< Sensor family
+    uint16_t timeoutMs;  ///< I2C transaction timeout
+} ShtConfig;
+
+/**
+ * @brief Computes the Sensirion CRC-8 (polynomial 0x31, init 0xFF).
+ * @param data Bytes to check.
+ * @param length Number of bytes.
+ * @return CRC of the bytes.
+ */
+uint8_t shtCrc(const uint8_t *data, uint8_t length);
+
+/**
+ * @brief Checks that the device at an address is an SHT of a given family.
+ *
+ * Reads the serial number with the command of the family: the other family
+ * does not answer it with valid CRCs.
+ *
+ * @param prober Boot-time bus access.
+ * @param address 7-bit address of the device.
+ * @param model Expected family.
+ * @return True if the serial number was read with valid CRCs.
+ */
+bool shtIdentify(bus::I2cProber *prober, uint8_t address, ShtModel model);
+
+/**
+ * @class ShtSensor
+ * @brief SHT3x/SHT4x temperature and humidity sensor, single-shot mode.
+ *
+ * A measurement takes two non-blocking steps: trigger() sends the
+ * measurement command, then after conversionTimeMs() fetch() reads the six
+ * result bytes. Once the fetch has completed, readData() checks both CRCs
+ * and processData() converts the sample.
+ */
+class ShtSensor final : public Sensor {
+  public:
+    /**
+     * @brief Constructor for ShtSensor.
+     * @param config Sensor configuration: bus, address, model and timeout.
+     */
+    explicit ShtSensor(ShtConfig config);
+    virtual ~ShtSensor() override;
+
+    /**
+     * @brief Sets a callback for the end of each I2C transaction.
+     * @param callback Called from interrupt context, may be nullptr.
+     * @param context Passed back through I2cTransaction::context.
+     */
+    void setCallback(bus::I2cCallback callback, void *context);
+
+    /**
+     * @brief Queues the single-shot measurement command.
+     * @return HAL_BUSY if a transaction is pending, HAL_ERROR if refused.
+     */
+    HAL_StatusTypeDef trigger();
+
+    /**
+     * @brief Queues the read of the measurement result.
+     * @return HAL_BUSY if a transaction is pending, HAL_ERROR if refused.
+     */
+    HAL_StatusTypeDef fetch();
+
+    /**
+     * @brief Gets the maximum conversion time of the model.
+     * @return Delay between trigger() and fetch(), in milliseconds.
+     */
+    uint16_t conversionTimeMs() const;
+
+    /**
+     * @brief Checks if an I2C transaction is pending.
+     * @return True until the last trigger() or fetch() completes.
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief Takes the result of the last fetch().
+     * @return HAL_OK with a CRC-checked sample, HAL_BUSY while the fetch is
+     * pending, HAL_TIMEOUT or HAL_ERROR if it failed.
+     */
+    HAL_StatusTypeDef readData() override;
+
+    /**
+     * @brief Converts the last sample to temperature and humidity.
+     */
+    void processData() override;
+
+    /**
+     * @brief Gets the temperature in Celsius.
+     * @return Temperature in Celsius.
+     */
+    float getTemperatureCelsius() const;
+
+    /**
+     * @brief Gets the relative humidity.
+     * @return Relative humidity in percent.
+     */
+    float getHumidityPercent() const;
+
+    /**
+     * @brief Checks if the last sample is valid.
+     * @return True if the last sample passed its CRCs.
+     */
+    bool isDataValid() const;
+
+  private:
+    /**
+     * @brief Last transaction queued.
+     */
+    enum class Step : uint8_t { IDLE = 0, TRIGGER, FETCH };
+
+    HAL_StatusTypeDef submit(Step step, const uint8_t *txData,
+                             uint16_t txLength, uint8_t *rxData,
+                             uint16_t rxLength);
+
+    ShtConfig m_config = {};                ///< Sensor configuration.
+    bus::I2cTransaction m_transaction = {}; ///< Descriptor on the bus.
+    Step m_step = Step::IDLE;               ///< Last transaction queued.
+    uint8_t m_command[2] = {0};             ///< Measurement command.
+    uint8_t m_response[6] = {0};            ///< T, CRC, RH, CRC.
+    uint16_t m_rawTemperature = 0;          ///< Last raw temperature.
+    uint16_t m_rawHumidity = 0;             ///< Last raw humidity.
+    float m_temperature = 0.0f;             ///< Temperature in Celsius.
+    float m_humidity = 0.0f;                ///< Relative humidity (%).
+};
+
+} // namespace sensor
+
+#endif // SHT_SENSOR_HH
@@ -0,0 +1,23 @@
+#include "snapshot.hh"
+
+namespace sensor {
+
+bool publish(Reading *reading, float value, bool valid, Source source,
+             uint32_t nowMs) {
+    if ((source == Source::ANALOG) && (reading->source == Source::DIGITAL) &&
+        ((nowMs - reading->timestampMs) < DIGITAL_STALE_MS)) {
+        return false;
+    }
+    reading->value = value;
+    reading->timestampMs = nowMs;
+    reading->source = source;
+    reading->valid = valid;
+    return true;
+}
+
+bool sameReading(const Reading &a, const Reading &b) {
+    return (a.value == b.value) && (a.valid == b.valid) &&
+           (a.source == b.source);
+}
+
+} // namespace sensor
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOT_HH
+#define SNAPSHOT_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sensor {
+
+/**
+ * @brief Kind of sensor a reading comes from.
+ */
+enum class Source : uint8_t {
+    NONE = 0, ///< Never published
+    ANALOG,   ///< ADC probe
+    DIGITAL   ///< I2C sensor
+};
+
+/**
+ * @brief Latest value of one measured quantity.
+ *
+ * @struct Reading
+ * @var float value
+ *      Measured value.
+ * @var uint32_t timestampMs
+ *      Tick of the measurement.
+ * @var Source source
+ *      Sensor that produced the value.
+ * @var bool valid
+ *      False if the sensor flagged the value as out of range.
+ */
+typedef struct {
+    float value;          ///< Measured value
+    uint32_t timestampMs; ///< Tick of the measurement
+    Source source;        ///< Sensor that produced the value
+    bool valid;           ///< Value within the sensor range
+} Reading;
+
+/**
+ * @brief Latest measurements of the greenhouse, shared by all sensors.
+ *
+ * @struct Snapshot
+ * @var Reading temperature
+ *      Air temperature in Celsius.
+ * @var Reading soilHumidity
+ *      Soil humidity in percent.
+ * @var Reading airHumidity
+ *      Relative air humidity in percent.
+ */
+typedef struct {
+    Reading temperature;  ///< Air temperature (°C)
+    Reading soilHumidity; ///< Soil humidity (%)
+    Reading airHumidity;  ///< Relative air humidity (%)
+} Snapshot;
+
+constexpr uint32_t DIGITAL_STALE_MS = 5000; ///< Digital reading lifetime.
+
+/**
+ * @brief Publishes a measurement into a snapshot reading.
+ *
+ * A digital sensor is more accurate than an analog probe, so an analog value
+ * does not replace a digital one younger than DIGITAL_STALE_MS.
+ *
+ * @param reading Reading to update.
+ * @param value Measured value.
+ * @param valid False if the value is out of the sensor range.
+ * @param source Sensor kind.
+ * @param nowMs Current tick in milliseconds.
+ * @return True if the reading was updated.
+ */
+bool publish(Reading *reading, float value, bool valid, Source source,
+             uint32_t nowMs);
+
+/**
+ * @brief Tells if two readings carry the same data, whatever their age.
+ *
+ * Values are compared exactly: the filtered readings only change when the
+ * conversions do, so a steady greenhouse publishes the same value again.
+ *
+ * @param a First reading.
+ * @param b Second reading.
+ * @return True if value, validity and source are equal.
+ */
+bool sameReading(const Reading &a, const Reading &b);
+
+} // namespace sensor
+
+#endif // SNAPSHOT_HH
@@ -1,24 +1,32 @@
 #include "../inc/soil_hum.hh"
 
+#include "../../../../system/profile/inc/profile.hh"
+
 namespace sensor {
 
+namespace {
+
+// Soil moisture moves slowly but a capacitive probe is noisy: 10 minutes
+// of identical counts means a frozen reading
+const DiagnosticLimits DIAGNOSTIC_LIMITS = {16, 400, 100, 60};
+
+} // namespace
+
 SoilHumSensor::SoilHumSensor(SensorConfig config) {
-    // Initialize the ADC channel configuration
-    if (config.adcHandle == nullptr) {
-        Error_Handler();
-    }
+    // Initialize the ADC channel configuration. A missing ADC handle is
+    // reported by readData() rather than halting the whole node.
     this->m_config = config;
+    this->setDiagnosticLimits(DIAGNOSTIC_LIMITS);
 }
 
 void SoilHumSensor::processData() {
-    sensor::Sensor::processData();
+    SERRE_PROFILE_BEGIN(SOIL_MATH);
+    sensor::AnalogSensor::processData();
     // Calculate humidity percentage based on calibration values
     if (this->m_processedValue <= this->m_wetCalibration) {
         this->m_humidityPercent = 100.0f;
-        this->m_dataValid = true;
     } else if (this->m_processedValue >= this->m_dryCalibration) {
         this->m_humidityPercent = 0.0f;
-        this->m_dataValid = true;
     } else {
         this->m_humidityPercent =
             100.0f - ((static_cast<float>(this->m_processedValue) -
@@ -26,13 +34,26 @@ void SoilHumSensor::processData() {
                       (static_cast<float>(this->m_dryCalibration) -
                        static_cast<float>(this->m_wetCalibration))) *
                          100.0f;
-        this->m_dataValid = true;
     }
+    // An open probe reads full scale, which would pass for dry soil
+    this->m_dataValid = this->probeFault() == ProbeFault::NONE;
+    SERRE_PROFILE_END(SOIL_MATH);
 }
 float SoilHumSensor::getHumidityPercent() const {
     return this->m_humidityPercent;
 }
 
+float SoilHumSensor::getTrendPercentPerHour() const {
+    // Wetter soil reads lower
+    float span = static_cast<float>(this->m_dryCalibration) -
+                 static_cast<float>(this->m_wetCalibration);
+    return -60.0f * this->rawSlopePerMinute() * 100.0f / span;
+}
+
+uint16_t SoilHumSensor::getRawAverage() const {
+    return static_cast<uint16_t>(this->m_processedValue);
+}
+
 bool SoilHumSensor::isHumidityValid() const {
     return this->m_dataValid;
 }
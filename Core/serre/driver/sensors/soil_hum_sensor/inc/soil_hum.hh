@@ -9,11 +9,11 @@ namespace sensor {
  * @class SoilHumSensor
  * @brief A class representing a soil humidity sensor.
  *
- * This class inherits from the Sensor base class and provides functionality
+ * This class inherits from the AnalogSensor base class and provides functionality
  * to read and process soil humidity data. It also includes methods for
  * calibration and retrieving humidity values.
  */
-class SoilHumSensor final : public Sensor {
+class SoilHumSensor final : public AnalogSensor {
   public:
     /**
      * @brief Constructor for SoilHumSensor.
@@ -41,6 +41,18 @@ class SoilHumSensor final : public Sensor {
      */
     bool isHumidityValid() const;
 
+    /**
+     * @brief Gets the humidity trend over the last 2 minutes of reads.
+     * @return Change in percent per hour, 0 until isTrendReady().
+     */
+    float getTrendPercentPerHour() const;
+
+    /**
+     * @brief Gets the averaged raw ADC value, as used for calibration.
+     * @return Raw value of the last processData() call.
+     */
+    uint16_t getRawAverage() const;
+
     /**
      * @brief Calibrates the sensor with dry and wet values.
      * @param dryValue The raw value representing dry soil.
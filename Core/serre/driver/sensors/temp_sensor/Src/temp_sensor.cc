@@ -1,23 +1,35 @@
 #include "../inc/temp_sensor.hh"
 
+#include "../../../../system/profile/inc/profile.hh"
+
 namespace sensor {
 
+namespace {
+
+// 12.4 counts/°C: 6.5 °C between two reads, 3 °C of noise, 5 minutes
+// without a single count of change at one read per second
+const DiagnosticLimits DIAGNOSTIC_LIMITS = {16, 80, 40, 30};
+
+} // namespace
+
 TempSensor::TempSensor(sensor::SensorConfig config) {
-    // Initialize the ADC channel configuration
-    if (config.adcHandle == nullptr) {
-        Error_Handler();
-    }
+    // Initialize the ADC channel configuration. A missing ADC handle is
+    // reported by readData() rather than halting the whole node.
     this->m_config = config;
+    this->setDiagnosticLimits(DIAGNOSTIC_LIMITS);
 }
 
 void TempSensor::processData() {
-    sensor::Sensor::processData();
+    SERRE_PROFILE_BEGIN(TEMP_MATH);
+    sensor::AnalogSensor::processData();
     this->m_processedValue = (3.3f * this->m_processedValue) / ADC_MAX_VALUE;
     this->m_temperature =
         (static_cast<float>(this->m_processedValue) - 0.5) * this->SENSOR_SLOPE;
     // Validate the temperature data
     this->m_dataValid = (this->m_temperature >= this->m_minThreshold) &&
-                        (this->m_temperature <= this->m_maxThreshold);
+                        (this->m_temperature <= this->m_maxThreshold) &&
+                        (this->probeFault() == ProbeFault::NONE);
+    SERRE_PROFILE_END(TEMP_MATH);
 }
 
 float TempSensor::getTemperatureCelsius() const {
@@ -36,6 +48,11 @@ bool TempSensor::isTemperatureValid() const {
     return this->m_dataValid;
 }
 
+float TempSensor::getTrendCelsiusPerMinute() const {
+    return (3.3f * this->rawSlopePerMinute() / ADC_MAX_VALUE) *
+           this->SENSOR_SLOPE;
+}
+
 void TempSensor::setThreshold(float minTemp, float maxTemp) {
     this->m_minThreshold = minTemp;
     this->m_maxThreshold = maxTemp;
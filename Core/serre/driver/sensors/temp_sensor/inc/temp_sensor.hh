@@ -7,13 +7,13 @@ namespace sensor {
 
 /**
  * @class TempSensor
- * @brief A class representing a temperature sensor, derived from the Sensor
- * base class.
+ * @brief A class representing a temperature sensor, derived from the
+ * AnalogSensor base class.
  *
  * This class provides methods to read, process, and retrieve temperature data.
  * It also allows setting thresholds for temperature monitoring.
  */
-class TempSensor final : public Sensor {
+class TempSensor final : public AnalogSensor {
   public:
     /**
      * @brief Constructor for TempSensor.
@@ -53,6 +53,12 @@ class TempSensor final : public Sensor {
      */
     bool isTemperatureValid() const;
 
+    /**
+     * @brief Gets the temperature trend over the last 2 minutes of reads.
+     * @return Change in Celsius per minute, 0 until isTrendReady().
+     */
+    float getTrendCelsiusPerMinute() const;
+
     /**
      * @brief Sets the temperature thresholds.
      * @param minTemp Minimum temperature threshold.
@@ -0,0 +1,45 @@
+#include "trend.hh"
+
+namespace sensor {
+
+void SlopeEstimator::add(uint16_t value) {
+    int32_t y = value;
+    if (this->m_count < WINDOW) {
+        this->m_sumXY += static_cast<int32_t>(this->m_count) * y;
+        this->m_sumY += y;
+        this->m_count++;
+    } else {
+        // Every remaining point moves one step closer to x = 0
+        int32_t oldest = this->m_points[this->m_next];
+        this->m_sumXY += (WINDOW - 1) * y - (this->m_sumY - oldest);
+        this->m_sumY += y - oldest;
+    }
+    this->m_points[this->m_next] = value;
+    this->m_next = static_cast<uint8_t>((this->m_next + 1) % WINDOW);
+}
+
+void SlopeEstimator::reset() {
+    this->m_sumY = 0;
+    this->m_sumXY = 0;
+    this->m_count = 0;
+    this->m_next = 0;
+}
+
+uint8_t SlopeEstimator::count() const {
+    return this->m_count;
+}
+
+float SlopeEstimator::slope() const {
+    int32_t n = this->m_count;
+    if (n < 2) {
+        return 0.0f;
+    }
+    // Within int32 for WINDOW points up to 65535: n Σxy < 2^26
+    int32_t sumX = n * (n - 1) / 2;
+    int32_t sumXX = (n - 1) * n * (2 * n - 1) / 6;
+    int32_t numerator = n * this->m_sumXY - sumX * this->m_sumY;
+    int32_t denominator = n * sumXX - sumX * sumX;
+    return static_cast<float>(numerator) / static_cast<float>(denominator);
+}
+
+} // namespace sensor
@@ -0,0 +1,55 @@
+#ifndef TREND_HH
+#define TREND_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sensor {
+
+/**
+ * @class SlopeEstimator
+ * @brief Least-squares slope of the last WINDOW points of a stream.
+ *
+ * The points are taken as evenly spaced. Σy and Σxy are kept as running
+ * integer sums, with x counted from the oldest point, so add() and slope()
+ * are O(1) and exact: sliding the window by one point only takes the
+ * dropped value out of both sums.
+ */
+class SlopeEstimator {
+  public:
+    static constexpr uint8_t WINDOW = 12; ///< Points in the window.
+
+    /**
+     * @brief Adds a point, dropping the oldest one once the window is full.
+     * @param value New point.
+     */
+    void add(uint16_t value);
+
+    /**
+     * @brief Forgets every point.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of points in the window.
+     * @return 0 to WINDOW.
+     */
+    uint8_t count() const;
+
+    /**
+     * @brief Gets the slope of the regression line.
+     * @return Value change per point, 0 with fewer than two points.
+     */
+    float slope() const;
+
+  private:
+    uint16_t m_points[WINDOW] = {}; ///< Window, oldest at m_next once full.
+    int32_t m_sumY = 0;             ///< Σy over the window.
+    int32_t m_sumXY = 0;            ///< Σxy, x = 0 for the oldest point.
+    uint8_t m_count = 0;            ///< Points in the window.
+    uint8_t m_next = 0;             ///< Slot of the next point.
+};
+
+} // namespace sensor
+
+#endif // TREND_HH
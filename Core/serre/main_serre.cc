@@ -1,31 +1,827 @@
 #include "main_serre.h"
 
 #include "../Inc/adc.h"
+#include "../Inc/i2c.h"
+#include "../Inc/usart.h"
+#include "control/actuators/inc/actuators.hh"
+#include "driver/buttons/inc/buttons.hh"
+#include "driver/devices/inc/devices.hh"
+#include "driver/i2c/inc/i2c_bus.hh"
+#include "driver/sensors/die_temp_sensor/inc/die_temp.hh"
+#include "driver/sensors/sht_sensor/inc/sht_sensor.hh"
+#include "driver/sensors/report.hh"
+#include "driver/sensors/snapshot.hh"
 #include "driver/sensors/soil_hum_sensor/inc/soil_hum.hh"
 #include "driver/sensors/temp_sensor/inc/temp_sensor.hh"
+#include "system/boot/inc/boot_markers.hh"
+#include "system/bus/inc/topic_bus.hh"
+#include "system/clock/inc/clock.hh"
+#include "system/crash/inc/crash.hh"
+#include "system/fault/inc/fault.hh"
+#include "system/latency/inc/isr_latency.hh"
+#include "system/memory/inc/ram_monitor.hh"
+#include "system/pool/inc/pool_heap.hh"
+#include "system/profile/inc/profile.hh"
+#include "system/scheduler/inc/scheduler.hh"
+#include "system/settings/inc/settings.hh"
+#include "system/watchdog/inc/watchdog.hh"
+#include "ui/display/inc/console_display.hh"
+#include "ui/display/inc/ssd1306_display.hh"
+#include "ui/panel/inc/panel.hh"
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+constexpr uint32_t WATCHDOG_TIMEOUT_MS = 4000;     ///< IWDG reset delay
+constexpr uint32_t ACQUISITION_PERIOD_MS = 1000;   ///< Sensor sampling period
+constexpr uint32_t ACQUISITION_DEADLINE_MS = 3000; ///< Max acquisition gap
+constexpr uint32_t CONTROL_DEADLINE_MS = 3000;     ///< Max control gap
+constexpr uint32_t I2C_POLL_MS = 5;                ///< I2C timeout check
+constexpr uint32_t AIR_POLL_MS = 5;                ///< SHT step check
+constexpr uint32_t DISCOVERY_BUDGET_MS = 50;       ///< Boot I2C probing
+constexpr uint32_t OLED_RETRY_MS = 50;             ///< OLED transfer retry
+constexpr uint16_t ISR_LATENCY_SAMPLES = 32;       ///< Samples per handler
+constexpr uint32_t CONSOLE_TIMEOUT_MS = 100;       ///< UART console write
+constexpr uint32_t CONSOLE_POLL_MS = 100;          ///< Console command check
+constexpr uint32_t RAM_CHECK_MS = 10000;           ///< Stack headroom check
+constexpr uint32_t RAM_MIN_FREE_BYTES = 256;       ///< Headroom alarm level
+constexpr int16_t DIE_HOT_TENTHS = 700;            ///< Clock throttled above
+constexpr int16_t DIE_COOLED_TENTHS = 600;         ///< Full clock again below
+constexpr float DIE_PROBE_MAX_GAP_C = 15.0f;       ///< Air probe plausibility
+
+// Watering while the soil probe is faulted: one minute every 6 hours
+const control::WateringSchedule safeWatering = {6UL * 3600UL * 1000UL, 60000};
+
+const control::ActuatorConfig actuatorConfig = {FAN_GPIO_Port, FAN_Pin,
+                                                PUMP_GPIO_Port, PUMP_Pin};
+
+const sensor::SensorConfig tempConfig = {&hadc1, ADC_CHANNEL_1,
+                                         ADC_SAMPLINGTIME_COMMON_1, 100,
+                                         ACQUISITION_PERIOD_MS};
+
+const sensor::SensorConfig soilHumConfig = {&hadc1, ADC_CHANNEL_0,
+                                            ADC_SAMPLINGTIME_COMMON_1, 100,
+                                            ACQUISITION_PERIOD_MS};
+
+// The internal sensor needs 5 us of sampling: common time 2 is 160.5 cycles
+const sensor::SensorConfig dieTempConfig = {&hadc1, ADC_CHANNEL_TEMPSENSOR,
+                                            ADC_SAMPLINGTIME_COMMON_2, 100, 0};
+
+sys::Scheduler scheduler;
+volatile int8_t uiTaskId = sys::INVALID_TASK;
+int8_t busTaskId = sys::INVALID_TASK;
+volatile int8_t airTaskId = sys::INVALID_TASK;
+volatile int8_t oledTaskId = sys::INVALID_TASK;
+bool consoleStarted = false;
+
+/**
+ * @brief Progress of the air sensor measurement.
+ */
+enum class AirStep : uint8_t {
+    IDLE = 0,  ///< Waiting for the next sampling period
+    TRIGGERED, ///< Measurement command sent, converting
+    FETCHING   ///< Result being read
+};
+
+/**
+ * @brief Measurements published on the bus.
+ */
+enum class Topic : uint8_t {
+    TEMPERATURE = 0, ///< Snapshot air temperature (°C)
+    SOIL_HUMIDITY,   ///< Snapshot soil humidity (%)
+    SOIL_RAW,        ///< Soil probe conversion average
+    AIR_HUMIDITY,    ///< Snapshot air humidity (%)
+    COUNT            ///< Number of topics
+};
+
+typedef sys::TopicBus<Topic, sensor::Reading, sensor::sameReading>
+    ReadingBus;
+
+/**
+ * @brief Redraws the menu when a value it may show has changed.
+ */
+void onReadout(void *context, Topic topic, const sensor::Reading &reading) {
+    (void)context;
+    (void)topic;
+    (void)reading;
+    scheduler.signal(uiTaskId);
+}
+
+// Subscribers, one line per consumer and topic
+const ReadingBus::Entry subscriptions[] = {
+    {Topic::SOIL_RAW, onReadout},
+};
+
+/**
+ * @brief Measurement sent on the telemetry stream.
+ *
+ * @struct Telemetry
+ * @var Topic topic
+ *      Bus topic holding the latest reading.
+ * @var const char *name
+ *      Name in the record.
+ * @var sensor::ReportPolicy policy
+ *      Deadband and heartbeat of the records.
+ */
+typedef struct {
+    Topic topic;                 ///< Source topic
+    const char *name;            ///< Record name
+    sensor::ReportPolicy policy; ///< When to send a record
+} Telemetry;
+
+// Send a record on a real change, or every 10 to 30 minutes as a heartbeat
+const Telemetry telemetry[] = {
+    {Topic::TEMPERATURE, "temperature", {0.2f, 10UL * 60UL * 1000UL}},
+    {Topic::SOIL_HUMIDITY, "soil", {1.0f, 30UL * 60UL * 1000UL}},
+    {Topic::AIR_HUMIDITY, "air", {1.0f, 30UL * 60UL * 1000UL}},
+};
+
+constexpr uint8_t TELEMETRY_COUNT =
+    sizeof(telemetry) / sizeof(telemetry[0]);
+static_assert(TELEMETRY_COUNT == 3, "Greenhouse builds one filter per entry");
+
+uint16_t bootCount() {
+    return static_cast<uint16_t>(sys::resetRecord().bootCount);
+}
+
+/**
+ * @brief Puts the node in its safe state, logs the fault and restarts.
+ * @param code Fault code kept in the retained log.
+ */
+void trap(sys::FaultCode code) {
+    __disable_irq();
+    main_serre_safeState();
+    sys::faultLogPush(sys::retainedFaultLog(), code, HAL_GetTick(),
+                      bootCount());
+    // The fault log is retained: restart instead of spinning forever
+    NVIC_SystemReset();
+}
+
+/**
+ * @brief Initializes USART2 on first use, off the critical boot path.
+ */
+void consoleStart() {
+    if (consoleStarted) {
+        return;
+    }
+    MX_USART2_UART_Init();
+    consoleStarted = true;
+    sys::bootMark(sys::BootMarker::CONSOLE_READY);
+}
+
+void consoleWrite(const char *data, uint16_t length) {
+    consoleStart();
+    HAL_UART_Transmit(&huart2, reinterpret_cast<const uint8_t *>(data),
+                      length, CONSOLE_TIMEOUT_MS);
+}
+
+void airSensorDone(bus::I2cTransaction *transaction) {
+    (void)transaction;
+    scheduler.signal(airTaskId);
+}
+
+void oledDone(bus::I2cTransaction *transaction) {
+    (void)transaction;
+    scheduler.signal(oledTaskId);
+}
+
+void reportDiscovery(const bus::Discovery *discovery) {
+    static const char digits[] = "0123456789abcdef";
+    consoleWrite("I2C:", 4);
+    for (uint8_t i = 0; i < discovery->count; i++) {
+        const bus::DiscoveredDevice &device = discovery->devices[i];
+        char address[] = "@00";
+        address[1] = digits[device.address >> 4];
+        address[2] = digits[device.address & 0x0F];
+        consoleWrite(" ", 1);
+        consoleWrite(device.driver->name,
+                     static_cast<uint16_t>(strlen(device.driver->name)));
+        consoleWrite(address, 3);
+    }
+    if (!discovery->complete) {
+        consoleWrite(" (budget exceeded)", 18);
+    }
+    consoleWrite("\r\n", 2);
+}
+
+#if SERRE_PROFILING
+/**
+ * @brief Measures the interrupt entry latency at 64 MHz, where flash wait
+ * states matter, and prints it on the console. The other interrupts are
+ * masked meanwhile, so it only runs on request.
+ */
+void reportIsrLatency() {
+    sys::ClockProfile previous = sys::clockProfile();
+    if (!sys::clockSetProfile(sys::ClockProfile::PERFORMANCE)) {
+        consoleWrite("ISR latency: bus busy\r\n", 23);
+        return;
+    }
+    sys::IsrLatencyReport report;
+    sys::measureIsrLatency(ISR_LATENCY_SAMPLES, &report);
+    sys::clockSetProfile(previous);
+
+    char line[64];
+    uint32_t coreMHz =
+        sys::clockProfileHz(sys::ClockProfile::PERFORMANCE) / 1000000;
+    size_t length = sys::isrLatencyFormat(&report, coreMHz, line, sizeof(line));
+    consoleWrite(line, static_cast<uint16_t>(length));
+    consoleWrite("\r\n", 2);
+}
+#endif
+
+/**
+ * @brief Components of the greenhouse node, shared by the tasks.
+ */
+struct Greenhouse {
+    Greenhouse()
+        : faults(sys::retainedFaultLog(), bootCount()),
+          actuators(actuatorConfig), tempSensor(tempConfig),
+          soilHumSensor(soilHumConfig),
+          dieSensor(dieTempConfig, sensor::dieTempCalibration()),
+          display(consoleWrite),
+          panel(&settings, &tempSensor, &soilHumSensor, &actuators),
+          menu(&ui::panelMenu, &panel),
+          bus(subscriptions, sizeof(subscriptions) / sizeof(subscriptions[0])),
+          reports{sensor::ReportFilter(telemetry[0].policy),
+                  sensor::ReportFilter(telemetry[1].policy),
+                  sensor::ReportFilter(telemetry[2].policy)} {
+        sys::settingsLoad(&this->settings);
+        this->panel.apply();
+    }
+
+    sys::Watchdog watchdog;                 ///< Task liveness supervisor
+    sys::FaultManager faults;               ///< Retry policy and fault log
+    control::Actuators actuators;           ///< Fan and pump outputs
+    sensor::TempSensor tempSensor;          ///< Air temperature probe (PA1)
+    sensor::SoilHumSensor soilHumSensor;    ///< Soil humidity probe (PA0)
+    sensor::DieTempSensor dieSensor;        ///< MCU internal temperature
+    sensor::ShtSensor *airSensor = nullptr; ///< Air sensor, if found
+    ui::Ssd1306Display *oled = nullptr;     ///< OLED panel, if found
+    ui::Display *screen = nullptr;          ///< Display the menu uses
+    sensor::Snapshot snapshot = {};         ///< Latest measurements
+    AirStep airStep = AirStep::IDLE;        ///< Air measurement progress
+    uint32_t airStepMs = 0;                 ///< Start of the current step
+    uint32_t i2cEpisodes = 0;               ///< Stuck I2C episodes logged
+    uint32_t i2cFailedEpisodes = 0;         ///< Failed recoveries logged
+    uint32_t ramCheckMs = 0;                ///< Last stack headroom check
+    bool ramLowLogged = false;              ///< SYSTEM_RAM_LOW logged
+    sensor::ProbeFault tempFault = {};      ///< Air probe diagnostics
+    sensor::ProbeFault soilFault = {};      ///< Soil probe diagnostics
+    uint32_t soilFallbackMs = 0;            ///< Start of the safe watering
+    bool probeMismatch = false;             ///< Air probe far from the die
+    bool overheated = false;                ///< Clock throttled for heat
+    sys::Settings settings;                 ///< Thresholds and calibration
+    ui::ConsoleDisplay display;             ///< Menu on the UART console
+    ui::PanelModel panel;                   ///< Data behind the menu
+    ui::MenuEngine menu;                    ///< Front panel menu
+    ReadingBus bus;                         ///< Measurement changes
+    sensor::ReportFilter reports[TELEMETRY_COUNT]; ///< Telemetry deadbands
+};
+
+sys::FaultCode adcFaultCode(HAL_StatusTypeDef status) {
+    switch (status) {
+    case HAL_TIMEOUT:
+        return sys::FaultCode::ADC_TIMEOUT;
+    case HAL_BUSY:
+        return sys::FaultCode::ADC_BUSY;
+    default:
+        return sys::FaultCode::ADC_ERROR;
+    }
+}
+
+void recoverAdc() {
+    HAL_ADC_Stop(&hadc1);
+    HAL_ADC_DeInit(&hadc1);
+    MX_ADC1_Init();
+}
+
+/**
+ * @brief Reads a sensor, retrying transient ADC errors with back-off.
+ * @param sensor Sensor to read.
+ * @param faults Fault manager deciding on retries.
+ * @return HAL status of the last read attempt.
+ */
+HAL_StatusTypeDef readWithRetry(sensor::AnalogSensor &sensor,
+                                sys::FaultManager &faults) {
+    HAL_StatusTypeDef status = sensor.readData();
+    while (status != HAL_OK) {
+        sys::FaultAction action =
+            faults.report(adcFaultCode(status), HAL_GetTick());
+        if (action == sys::FaultAction::GIVE_UP) {
+            return status;
+        }
+        if (action == sys::FaultAction::REINITIALIZE) {
+            recoverAdc();
+        }
+        HAL_Delay(faults.retryDelayMs(sys::Subsystem::ANALOG));
+        status = sensor.readData();
+    }
+    faults.clear(sys::Subsystem::ANALOG);
+    return HAL_OK;
+}
+
+sys::FaultCode probeFaultCode(sensor::ProbeFault fault) {
+    switch (fault) {
+    case sensor::ProbeFault::RAIL:
+        return sys::FaultCode::ADC_PROBE_RAIL;
+    case sensor::ProbeFault::STUCK:
+        return sys::FaultCode::ADC_PROBE_STUCK;
+    case sensor::ProbeFault::RATE:
+        return sys::FaultCode::ADC_PROBE_RATE;
+    default:
+        return sys::FaultCode::ADC_PROBE_NOISE;
+    }
+}
+
+/**
+ * @brief Follows the diagnostics of a probe, logging each new fault.
+ * @param sensor Probe just processed.
+ * @param[in,out] last Fault of the previous acquisition.
+ * @param nowMs Current tick in milliseconds.
+ */
+void trackProbe(const sensor::AnalogSensor &sensor, sensor::ProbeFault *last,
+                uint32_t nowMs) {
+    sensor::ProbeFault fault = sensor.probeFault();
+    if ((fault != *last) && (fault != sensor::ProbeFault::NONE)) {
+        sys::faultLogPush(sys::retainedFaultLog(), probeFaultCode(fault),
+                          nowMs, bootCount());
+    }
+    *last = fault;
+}
+
+/**
+ * @brief Publishes a measurement on the bus, waking the bus task if the
+ * value changed.
+ */
+void post(Greenhouse *node, Topic topic, const sensor::Reading &reading) {
+    if (node->bus.publish(topic, reading)) {
+        scheduler.signal(busTaskId);
+    }
+}
+
+/**
+ * @brief Updates a snapshot reading and posts it if the snapshot took it.
+ */
+void publishReading(Greenhouse *node, Topic topic, sensor::Reading *reading,
+                    float value, bool valid, sensor::Source source,
+                    uint32_t nowMs) {
+    if (sensor::publish(reading, value, valid, source, nowMs)) {
+        post(node, topic, *reading);
+    }
+}
+
+/**
+ * @brief Cross-checks the air probe against the die temperature, logging
+ * ADC_PROBE_MISMATCH each time the gap opens.
+ * @return False while the air probe reads implausibly far from the die.
+ */
+bool checkProbeAgainstDie(Greenhouse *node, uint32_t nowMs) {
+    bool mismatch = node->dieSensor.isTemperatureValid() &&
+                    node->tempSensor.isTemperatureValid() &&
+                    (fabsf(node->tempSensor.getTemperatureCelsius() -
+                           node->dieSensor.getTemperatureCelsius()) >
+                     DIE_PROBE_MAX_GAP_C);
+    if (mismatch && !node->probeMismatch) {
+        sys::faultLogPush(sys::retainedFaultLog(),
+                          sys::FaultCode::ADC_PROBE_MISMATCH, nowMs,
+                          bootCount());
+    }
+    node->probeMismatch = mismatch;
+    return !mismatch;
+}
+
+void acquisitionTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+
+    // Die first: the air probe is checked against a fresh value
+    if (readWithRetry(node->dieSensor, node->faults) == HAL_OK) {
+        node->dieSensor.processData();
+    }
+
+    if (readWithRetry(node->tempSensor, node->faults) == HAL_OK) {
+        node->tempSensor.processData();
+        trackProbe(node->tempSensor, &node->tempFault, nowMs);
+        bool plausible = checkProbeAgainstDie(node, nowMs);
+        publishReading(node, Topic::TEMPERATURE, &node->snapshot.temperature,
+                       node->tempSensor.getTemperatureCelsius(),
+                       node->tempSensor.isTemperatureValid() && plausible,
+                       sensor::Source::ANALOG, nowMs);
+    }
+
+    if (readWithRetry(node->soilHumSensor, node->faults) == HAL_OK) {
+        node->soilHumSensor.processData();
+        bool wasFaulted = node->soilFault != sensor::ProbeFault::NONE;
+        trackProbe(node->soilHumSensor, &node->soilFault, nowMs);
+        if (!wasFaulted && (node->soilFault != sensor::ProbeFault::NONE)) {
+            node->soilFallbackMs = nowMs;
+        }
+        publishReading(node, Topic::SOIL_HUMIDITY,
+                       &node->snapshot.soilHumidity,
+                       node->soilHumSensor.getHumidityPercent(),
+                       node->soilHumSensor.isHumidityValid(),
+                       sensor::Source::ANALOG, nowMs);
+        sensor::Reading raw = {
+            static_cast<float>(node->soilHumSensor.getRawAverage()), nowMs,
+            sensor::Source::ANALOG, node->soilHumSensor.isHumidityValid()};
+        post(node, Topic::SOIL_RAW, raw);
+    }
+    node->watchdog.checkIn(sys::WatchdogTask::ACQUISITION, HAL_GetTick());
+}
+
+void airTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+    sensor::ShtSensor &air = *node->airSensor;
+
+    switch (node->airStep) {
+    case AirStep::IDLE:
+        if ((nowMs - node->airStepMs) < ACQUISITION_PERIOD_MS) {
+            return;
+        }
+        node->airStepMs = nowMs;
+        if (air.trigger() == HAL_OK) {
+            node->airStep = AirStep::TRIGGERED;
+        }
+        break;
+    case AirStep::TRIGGERED:
+        if (air.isBusy() ||
+            ((nowMs - node->airStepMs) < air.conversionTimeMs())) {
+            return;
+        }
+        // A missing sensor NACKs the fetch too, reported below
+        node->airStep =
+            (air.fetch() == HAL_OK) ? AirStep::FETCHING : AirStep::IDLE;
+        break;
+    case AirStep::FETCHING: {
+        HAL_StatusTypeDef status = air.readData();
+        if (status == HAL_BUSY) {
+            return;
+        }
+        node->airStep = AirStep::IDLE;
+        if (status != HAL_OK) {
+            node->faults.report((status == HAL_TIMEOUT)
+                                    ? sys::FaultCode::I2C_TIMEOUT
+                                    : sys::FaultCode::I2C_ERROR,
+                                nowMs);
+            return;
+        }
+        node->faults.clear(sys::Subsystem::I2C);
+        air.processData();
+        publishReading(node, Topic::TEMPERATURE, &node->snapshot.temperature,
+                       air.getTemperatureCelsius(), true,
+                       sensor::Source::DIGITAL, nowMs);
+        publishReading(node, Topic::AIR_HUMIDITY, &node->snapshot.airHumidity,
+                       air.getHumidityPercent(), true,
+                       sensor::Source::DIGITAL, nowMs);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Logs SYSTEM_RAM_LOW once per boot when the stack and the heap come
+ * close to colliding, long before an overflow corrupts the static data.
+ */
+void checkRamHeadroom(Greenhouse *node, uint32_t nowMs) {
+    if (node->ramLowLogged || ((nowMs - node->ramCheckMs) < RAM_CHECK_MS)) {
+        return;
+    }
+    node->ramCheckMs = nowMs;
+    sys::RamUsage usage;
+    sys::ramUsageRead(&usage);
+    if (usage.freeBytes < RAM_MIN_FREE_BYTES) {
+        node->ramLowLogged = true;
+        sys::faultLogPush(sys::retainedFaultLog(),
+                          sys::FaultCode::SYSTEM_RAM_LOW, nowMs, bootCount());
+    }
+}
+
+/**
+ * @brief Drops to the ECO clock profile while the die is hot, logging
+ * SYSTEM_OVERHEAT once per episode. A change refused because a transfer
+ * is running is tried again on the next call.
+ */
+void checkOverheat(Greenhouse *node, uint32_t nowMs) {
+    if (!node->dieSensor.isTemperatureValid()) {
+        return;
+    }
+    int16_t tenths = node->dieSensor.getTemperatureTenths();
+    if (!node->overheated && (tenths >= DIE_HOT_TENTHS)) {
+        node->overheated = true;
+        sys::faultLogPush(sys::retainedFaultLog(),
+                          sys::FaultCode::SYSTEM_OVERHEAT, nowMs, bootCount());
+    } else if (node->overheated && (tenths <= DIE_COOLED_TENTHS)) {
+        node->overheated = false;
+    }
+    sys::ClockProfile wanted = node->overheated ? sys::ClockProfile::ECO
+                                                : sys::ClockProfile::NORMAL;
+    if (sys::clockProfile() != wanted) {
+        sys::clockSetProfile(wanted);
+    }
+}
+
+void controlTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+
+    // Without trustworthy readings, hold the actuators in the safe state
+    if (node->faults.isDegraded(sys::Subsystem::ANALOG)) {
+        node->actuators.applySafeState();
+    } else {
+        // A faulted probe no longer drives its actuator: ventilate, and
+        // water on a timer until the soil probe reads plausibly again
+        if (node->tempFault != sensor::ProbeFault::NONE) {
+            node->actuators.setFan(true);
+        } else if (node->actuators.isFanOn() &&
+                   (node->actuators.fanOverride() ==
+                    control::Override::AUTO)) {
+            // Probe back: stop the ventilation it or the safe state started
+            node->actuators.setFan(false);
+        }
+        if (node->soilFault != sensor::ProbeFault::NONE) {
+            node->actuators.setPump(control::scheduledWatering(
+                &safeWatering, nowMs - node->soilFallbackMs));
+        } else if (node->actuators.isPumpOn() &&
+                   (node->actuators.pumpOverride() ==
+                    control::Override::AUTO)) {
+            // Probe back: end a timed watering still running
+            node->actuators.setPump(false);
+        }
+    }
+    checkRamHeadroom(node, nowMs);
+    checkOverheat(node, nowMs);
+    node->watchdog.checkIn(sys::WatchdogTask::CONTROL, nowMs);
+}
+
+void i2cTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+    bus::i2c1().poll(nowMs);
+
+    // One trace per stuck bus episode, not per recovery: a bus that stays
+    // stuck must not push the older entries out of the retained fault log
+    const bus::I2cStats &stats = bus::i2c1().stats();
+    if (stats.stuckEpisodes != node->i2cEpisodes) {
+        node->i2cEpisodes = stats.stuckEpisodes;
+        sys::faultLogPush(sys::retainedFaultLog(), sys::FaultCode::I2C_BUSY,
+                          nowMs, bootCount());
+    }
+    if (stats.failedEpisodes != node->i2cFailedEpisodes) {
+        node->i2cFailedEpisodes = stats.failedEpisodes;
+        sys::faultLogPush(sys::retainedFaultLog(), sys::FaultCode::I2C_STUCK,
+                          nowMs, bootCount());
+    }
+}
+
+/**
+ * @brief Delivers the measurements that changed since the last run.
+ */
+void busTask(void *context, uint32_t nowMs) {
+    (void)nowMs;
+    static_cast<Greenhouse *>(context)->bus.dispatch(context);
+}
+
+/**
+ * @brief Handles the buttons and redraws the menu. Runs only when signaled,
+ * by a button or by the bus when a live value changed.
+ */
+void uiTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+    (void)nowMs;
+
+    bool changed = false;
+    input::ButtonEvent event;
+    while (input::popButtonEvent(&event)) {
+        node->menu.handle(event);
+        changed = true;
+    }
+    if (changed || node->menu.isLive()) {
+        SERRE_PROFILE_BEGIN(UI_RENDER);
+        node->menu.render(node->screen);
+        SERRE_PROFILE_END(UI_RENDER);
+    }
+}
+
+void reportBoot() {
+    char line[80];
+    size_t length = sys::bootMarkersFormat(line, sizeof(line));
+    consoleWrite(line, static_cast<uint16_t>(length));
+    consoleWrite("\r\n", 2);
+}
+
+void oledTask(void *context, uint32_t nowMs) {
+    Greenhouse *node = static_cast<Greenhouse *>(context);
+    (void)nowMs;
+    node->oled->update();
+
+    // The boot timeline is complete once the first frame is on the glass
+    if (node->oled->isReady() &&
+        (sys::bootMarkerUs(sys::BootMarker::DISPLAY_READY) ==
+         sys::BOOT_MARKER_UNSET)) {
+        sys::bootMark(sys::BootMarker::DISPLAY_READY);
+        reportBoot();
+    }
+}
+
+void reportRam() {
+    sys::RamUsage usage;
+    sys::ramUsageRead(&usage);
+    char line[64];
+    size_t length = sys::ramUsageFormat(&usage, line, sizeof(line));
+    consoleWrite(line, static_cast<uint16_t>(length));
+    consoleWrite("\r\n", 2);
+    for (uint8_t i = 0; i < sys::POOL_COUNT; i++) {
+        sys::PoolStats stats = sys::poolStats(i);
+        if (stats.capacity == 0) {
+            continue;
+        }
+        length = sys::poolFormat(&stats, line, sizeof(line));
+        consoleWrite(line, static_cast<uint16_t>(length));
+        consoleWrite("\r\n", 2);
+    }
+}
+
+#if SERRE_PROFILING
+void reportProfile() {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(sys::ProfileRegion::COUNT);
+         i++) {
+        sys::ProfileRegion region = static_cast<sys::ProfileRegion>(i);
+        char line[64];
+        size_t length = sys::profileFormat(region, &sys::profileStats(region),
+                                           line, sizeof(line));
+        consoleWrite(line, static_cast<uint16_t>(length));
+        consoleWrite("\r\n", 2);
+    }
+}
+#endif
+
+/**
+ * @brief Sends a telemetry record for each measurement that moved past its
+ * deadband or reached its heartbeat. Polled rather than subscribed: a
+ * heartbeat is due on time, without any change on the bus.
+ */
+void sendTelemetry(Greenhouse *node, uint32_t nowMs) {
+    for (uint8_t i = 0; i < TELEMETRY_COUNT; i++) {
+        sensor::Reading reading;
+        if (!node->bus.latest(telemetry[i].topic, &reading) ||
+            !node->reports[i].accept(reading, nowMs)) {
+            continue;
+        }
+        char line[48];
+        size_t length =
+            sensor::reportFormat(telemetry[i].name, &reading, line,
+                                 sizeof(line));
+        consoleWrite(line, static_cast<uint16_t>(length));
+        consoleWrite("\r\n", 2);
+    }
+}
+
+/**
+ * @brief Sends the telemetry records and serves the console commands: 'b'
+ * prints the boot timeline, 'm' the RAM high-water marks and the usage of
+ * the pools the build sized; with profiling, 'p' prints the cycles spent in
+ * each profiled region, 'z' clears them and 'l' measures the interrupt
+ * latency.
+ */
+void consoleTask(void *context, uint32_t nowMs) {
+    uint8_t command = 0;
+    consoleStart();
+    sendTelemetry(static_cast<Greenhouse *>(context), nowMs);
+    if (HAL_UART_Receive(&huart2, &command, 1, 0) != HAL_OK) {
+        return;
+    }
+    switch (command & 0x7F) { // 7-bit frames
+    case 'b':
+        reportBoot();
+        break;
+    case 'm':
+        reportRam();
+        break;
+#if SERRE_PROFILING
+    case 'p':
+        reportProfile();
+        break;
+    case 'z':
+        sys::profileReset();
+        break;
+    case 'l':
+        reportIsrLatency();
+        break;
+#endif
+    default:
+        break;
+    }
+}
+} // namespace
 
 void main_serre(void) {
 
-    static sensor::SensorConfig tempConfig = {&hadc1, ADC_CHANNEL_1,
-                                              ADC_SAMPLINGTIME_COMMON_1, 100};
+    static Greenhouse *node = nullptr;
+    if (node == nullptr) {
+        // Stage 1: safe outputs and a first reading, before any slow I/O
+        main_serre_safeState();
+        sys::bootMark(sys::BootMarker::SAFE_OUTPUTS);
+        sys::recordBoot(sys::watchdogReadResetFlags());
+#if SERRE_PROFILING
+        sys::profileStart();
+#endif
+        static Greenhouse greenhouse;
+        node = &greenhouse;
+        // Same outputs, now tracked by the control loop which releases them
+        node->actuators.applySafeState();
+        uint32_t sampleMs = HAL_GetTick();
+        acquisitionTask(node, sampleMs);
+        sys::bootMark(sys::BootMarker::FIRST_SAMPLE);
+
+        // Stage 2: console, then the reports of the previous boot
+        consoleStart();
+        sys::crashEmitReport();
+        if (sys::resetRecord().lastCause & sys::RESET_CAUSE_WATCHDOG) {
+            sys::faultLogPush(sys::retainedFaultLog(),
+                              sys::FaultCode::SYSTEM_WATCHDOG_RESET,
+                              HAL_GetTick(), bootCount());
+        }
 
-    static sensor::SensorConfig soilHumConfig = {
-        &hadc1, ADC_CHANNEL_0, ADC_SAMPLINGTIME_COMMON_1, 100};
+        // Stage 3: I2C bus. Only the devices that answer get a driver and
+        // a task
+        MX_I2C1_Init();
+        sys::bootMark(sys::BootMarker::I2C_READY);
+        bus::Discovery discovery;
+        devices::discoverI2c1(DISCOVERY_BUDGET_MS, &discovery);
+        reportDiscovery(&discovery);
+        node->airSensor = static_cast<sensor::ShtSensor *>(
+            bus::i2cFindDevice(&discovery, bus::DeviceKind::AIR_SENSOR));
+        node->oled = static_cast<ui::Ssd1306Display *>(
+            bus::i2cFindDevice(&discovery, bus::DeviceKind::DISPLAY));
+        node->screen = &node->display;
 
-    static sensor::SoilHumSensor soilHumSensor(soilHumConfig);
-    static sensor::TempSensor tempSensor(tempConfig);
+        uint32_t now = HAL_GetTick();
+        node->watchdog.registerTask(sys::WatchdogTask::ACQUISITION,
+                                    ACQUISITION_DEADLINE_MS, now);
+        node->watchdog.registerTask(sys::WatchdogTask::CONTROL,
+                                    CONTROL_DEADLINE_MS, now);
+        // Sampled in stage 1: the next reading is one period later
+        scheduler.addTask(acquisitionTask, node, ACQUISITION_PERIOD_MS,
+                          sampleMs + ACQUISITION_PERIOD_MS);
+        scheduler.addTask(controlTask, node, ACQUISITION_PERIOD_MS, now);
+        scheduler.addTask(i2cTask, node, I2C_POLL_MS, now);
+        if (node->airSensor != nullptr) {
+            node->airSensor->setCallback(airSensorDone, nullptr);
+            airTaskId = scheduler.addTask(airTask, node, AIR_POLL_MS, now);
+        }
+        if (node->oled != nullptr) {
+            // Each completed page signals the task to send the next one
+            node->oled->setCallback(oledDone, nullptr);
+            oledTaskId = scheduler.addTask(oledTask, node, OLED_RETRY_MS, now);
+            node->screen = node->oled;
+        } else {
+            reportBoot();
+        }
+        // Before the UI: a change delivered in a pass redraws in the same one
+        busTaskId = scheduler.addTask(busTask, node, 0, now);
+        uiTaskId = scheduler.addTask(uiTask, node, 0, now);
+        if (node->bus.isPending()) {
+            // Stage 1 sample, published before the bus task existed
+            scheduler.signal(busTaskId);
+        }
+        scheduler.addTask(consoleTask, node, CONSOLE_POLL_MS, now);
+        node->menu.render(node->screen);
+        sys::watchdogStart(WATCHDOG_TIMEOUT_MS);
+    }
 
-    float temperature = 0.0f;
-    float humidity = 0.0f;
+    SERRE_PROFILE_BEGIN(MAIN_LOOP);
+    scheduler.run(HAL_GetTick());
 
-    if (tempSensor.readData() == HAL_OK) {
-        tempSensor.processData();
-        temperature = tempSensor.getTemperatureCelsius();
+    if (node->watchdog.isHealthy(HAL_GetTick())) {
+        sys::watchdogRefresh();
     }
+    SERRE_PROFILE_END(MAIN_LOOP);
+    // Sleep until the next interrupt, at most one SysTick period away
+    __WFI();
+}
 
-    if (soilHumSensor.readData() == HAL_OK) {
-        soilHumSensor.processData();
-        humidity = soilHumSensor.getHumidityPercent();
+void main_serre_tick(void) {
+    if (input::buttonsTick(HAL_GetTick()) > 0) {
+        scheduler.signal(uiTaskId);
     }
-    HAL_Delay(1000);
+}
+
+void main_serre_errorHandler(void) {
+    trap(sys::FaultCode::SYSTEM_ERROR_HANDLER);
+}
+
+void main_serre_poolFault(void) {
+    trap(sys::FaultCode::SYSTEM_POOL_FAULT);
+}
+
+void main_serre_heapUsed(void) {
+    trap(sys::FaultCode::SYSTEM_HEAP_USED);
+}
+
+void main_serre_safeState(void) {
+    control::Actuators(actuatorConfig).applySafeState();
+}
+
+uint32_t main_serre_i2cTiming(void) {
+    return sys::i2cStandardTiming(HAL_RCC_GetPCLK1Freq());
 }
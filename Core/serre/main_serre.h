@@ -1,12 +1,20 @@
 #ifndef MAIN_SERRE_H
 #define MAIN_SERRE_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 // Function prototypes
 void main_serre(void);
+void main_serre_tick(void);
+void main_serre_errorHandler(void);
+void main_serre_poolFault(void);
+void main_serre_heapUsed(void);
+void main_serre_safeState(void);
+uint32_t main_serre_i2cTiming(void);
 
 #ifdef __cplusplus
 }
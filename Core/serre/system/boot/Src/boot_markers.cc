@@ -0,0 +1,62 @@
+#include "../inc/boot_markers.hh"
+
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint8_t MARKER_COUNT = static_cast<uint8_t>(BootMarker::COUNT);
+
+const char *const markerNames[] = {"safe", "sample", "console", "i2c",
+                                   "display"};
+
+static_assert(sizeof(markerNames) / sizeof(markerNames[0]) == MARKER_COUNT,
+              "One name per boot marker");
+
+uint32_t s_markers[MARKER_COUNT] = {BOOT_MARKER_UNSET, BOOT_MARKER_UNSET,
+                                    BOOT_MARKER_UNSET, BOOT_MARKER_UNSET,
+                                    BOOT_MARKER_UNSET};
+
+} // namespace
+
+void bootMark(BootMarker marker) {
+    bootMarkAt(marker, bootNowUs());
+}
+
+void bootMarkAt(BootMarker marker, uint32_t timeUs) {
+    uint8_t index = static_cast<uint8_t>(marker);
+    if ((index < MARKER_COUNT) && (s_markers[index] == BOOT_MARKER_UNSET)) {
+        s_markers[index] = timeUs;
+    }
+}
+
+uint32_t bootMarkerUs(BootMarker marker) {
+    uint8_t index = static_cast<uint8_t>(marker);
+    return (index < MARKER_COUNT) ? s_markers[index] : BOOT_MARKER_UNSET;
+}
+
+void bootMarkersReset() {
+    for (uint8_t i = 0; i < MARKER_COUNT; i++) {
+        s_markers[i] = BOOT_MARKER_UNSET;
+    }
+}
+
+size_t bootMarkersFormat(char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    out.text("boot");
+    for (uint8_t i = 0; i < MARKER_COUNT; i++) {
+        out.text(" ");
+        out.text(markerNames[i]);
+        out.text("=");
+        if (s_markers[i] == BOOT_MARKER_UNSET) {
+            out.text("-");
+        } else {
+            out.number(s_markers[i]);
+            out.text("us");
+        }
+    }
+    return out.length();
+}
+
+} // namespace sys
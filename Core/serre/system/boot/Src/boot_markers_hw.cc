@@ -0,0 +1,22 @@
+#include "../inc/boot_markers.hh"
+
+#include "../../../../Inc/main.h"
+
+namespace sys {
+
+uint32_t bootNowUs() {
+    // Read the tick and the counter as a pair, retrying across a SysTick
+    uint32_t tick;
+    uint32_t count;
+    do {
+        tick = HAL_GetTick();
+        count = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+
+    // The counter runs down from LOAD, one SysTick period per millisecond
+    uint32_t period = SysTick->LOAD + 1U;
+    uint32_t elapsed = period - 1U - count;
+    return (tick * 1000U) + ((elapsed * 1000U) / period);
+}
+
+} // namespace sys
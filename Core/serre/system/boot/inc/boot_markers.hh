@@ -0,0 +1,67 @@
+#ifndef BOOT_MARKERS_HH
+#define BOOT_MARKERS_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Steps of the staged startup, in their expected order.
+ */
+enum class BootMarker : uint8_t {
+    SAFE_OUTPUTS = 0, ///< Fan and pump driven to their safe state
+    FIRST_SAMPLE,     ///< First analog reading published
+    CONSOLE_READY,    ///< USART2 initialized
+    I2C_READY,        ///< I2C1 initialized, discovery starting
+    DISPLAY_READY,    ///< First OLED frame shown
+    COUNT
+};
+
+constexpr uint32_t BOOT_MARKER_UNSET = 0xFFFFFFFFU; ///< Step not reached.
+
+/**
+ * @brief Gets the time since HAL_Init(), which starts SysTick. The reset
+ * vector, the RAM initialization and HAL_Init() itself come before zero.
+ * @return Microseconds, with the resolution of the SysTick counter.
+ */
+uint32_t bootNowUs();
+
+/**
+ * @brief Records the time a step is reached, the first time only.
+ * @param marker Step reached.
+ */
+void bootMark(BootMarker marker);
+
+/**
+ * @brief Records a step at a given time, the first time only.
+ * @param marker Step reached.
+ * @param timeUs Time since HAL_Init() in microseconds.
+ */
+void bootMarkAt(BootMarker marker, uint32_t timeUs);
+
+/**
+ * @brief Gets the time a step was reached.
+ * @param marker Step.
+ * @return Microseconds since HAL_Init(), BOOT_MARKER_UNSET if not reached.
+ */
+uint32_t bootMarkerUs(BootMarker marker);
+
+/**
+ * @brief Forgets every step.
+ */
+void bootMarkersReset();
+
+/**
+ * @brief Formats the boot timeline, without line ending:
+ * "boot safe=180us sample=1210us console=1390us i2c=2950us display=-".
+ * @param[out] buffer Destination, always NUL-terminated.
+ * @param size Size of the buffer.
+ * @return Length of the text, truncated to size - 1.
+ */
+size_t bootMarkersFormat(char *buffer, size_t size);
+
+} // namespace sys
+
+#endif // BOOT_MARKERS_HH
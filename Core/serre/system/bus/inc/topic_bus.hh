@@ -0,0 +1,175 @@
+#ifndef TOPIC_BUS_HH
+#define TOPIC_BUS_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Subscriber of a topic, one entry of a const table kept in flash.
+ *
+ * @struct Subscription
+ * @var TopicId topic
+ *      Topic the handler receives.
+ * @var Handler handler
+ *      Called with the dispatch() context and the latest payload.
+ */
+template <typename TopicId, typename Payload> struct Subscription {
+    typedef void (*Handler)(void *context, TopicId topic,
+                            const Payload &payload);
+
+    TopicId topic;   ///< Topic received
+    Handler handler; ///< Delivery function
+};
+
+/**
+ * @brief Traffic of a topic bus since boot.
+ *
+ * @struct BusStats
+ * @var uint32_t published
+ *      Calls to publish().
+ * @var uint32_t unchanged
+ *      Publications equal to the previous payload, not delivered.
+ * @var uint32_t deliveries
+ *      Handler calls.
+ */
+typedef struct {
+    uint32_t published;  ///< publish() calls
+    uint32_t unchanged;  ///< Publications dropped as unchanged
+    uint32_t deliveries; ///< Handler calls
+} BusStats;
+
+/**
+ * @class TopicBus
+ * @brief Static publish/subscribe bus with deferred, change-only delivery.
+ *
+ * The topics are the TopicId values below TopicId::COUNT, each carrying
+ * one Payload. publish() keeps the payload and, unless SAME finds it equal
+ * to the previous one, queues the topic. dispatch(), run from a scheduler
+ * task, then calls the subscribers of each queued topic in publication
+ * order. A topic still queued is not queued twice: its subscribers get the
+ * latest payload once, so the queue needs one slot per topic and cannot
+ * overflow. Nothing is allocated; main context only.
+ *
+ * @tparam TopicId Enum class of the topics, ending with COUNT.
+ * @tparam Payload Trivially copyable payload type.
+ * @tparam SAME Tells if two payloads carry the same data.
+ */
+template <typename TopicId, typename Payload,
+          bool (*SAME)(const Payload &, const Payload &)>
+class TopicBus {
+  public:
+    typedef Subscription<TopicId, Payload> Entry; ///< Subscriber table entry.
+
+    static constexpr uint8_t TOPICS = static_cast<uint8_t>(TopicId::COUNT);
+    static_assert(TOPICS > 0, "TopicBus needs at least one topic");
+
+    /**
+     * @brief Constructor for TopicBus.
+     * @param table Subscribers, usually a const array in flash.
+     * @param count Number of subscribers.
+     */
+    TopicBus(const Entry *table, uint8_t count)
+        : m_table(table), m_count(count) {
+    }
+
+    /**
+     * @brief Publishes the latest payload of a topic.
+     * @param topic Topic.
+     * @param payload New payload, kept until the next publication.
+     * @return True if the payload changed and dispatch() must run.
+     */
+    bool publish(TopicId topic, const Payload &payload) {
+        uint8_t index = static_cast<uint8_t>(topic);
+        if (index >= TOPICS) {
+            return false;
+        }
+        this->m_stats.published++;
+        bool changed = !this->m_published[index] ||
+                       !SAME(this->m_latest[index], payload);
+        this->m_latest[index] = payload;
+        this->m_published[index] = true;
+        if (!changed) {
+            this->m_stats.unchanged++;
+            return false;
+        }
+        if (!this->m_pending[index]) {
+            this->m_pending[index] = true;
+            this->m_queue[(this->m_head + this->m_size) % TOPICS] = index;
+            this->m_size++;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Delivers the queued topics to their subscribers.
+     * @param context Pointer passed to every handler.
+     * @return Number of handler calls.
+     */
+    uint8_t dispatch(void *context) {
+        uint8_t delivered = 0;
+        while (this->m_size > 0) {
+            uint8_t index = this->m_queue[this->m_head];
+            this->m_head = static_cast<uint8_t>((this->m_head + 1) % TOPICS);
+            this->m_size--;
+            // A handler publishing the same topic queues it again
+            this->m_pending[index] = false;
+            for (uint8_t i = 0; i < this->m_count; i++) {
+                const Entry &entry = this->m_table[i];
+                if (static_cast<uint8_t>(entry.topic) == index) {
+                    entry.handler(context, entry.topic, this->m_latest[index]);
+                    delivered++;
+                }
+            }
+        }
+        this->m_stats.deliveries += delivered;
+        return delivered;
+    }
+
+    /**
+     * @brief Checks if a topic waits for dispatch().
+     * @return True if the queue is not empty.
+     */
+    bool isPending() const {
+        return this->m_size > 0;
+    }
+
+    /**
+     * @brief Gets the latest payload of a topic.
+     * @param topic Topic.
+     * @param[out] outPayload Pointer to store the payload.
+     * @return False if the topic was never published.
+     */
+    bool latest(TopicId topic, Payload *outPayload) const {
+        uint8_t index = static_cast<uint8_t>(topic);
+        if ((index >= TOPICS) || !this->m_published[index]) {
+            return false;
+        }
+        *outPayload = this->m_latest[index];
+        return true;
+    }
+
+    /**
+     * @brief Gets the traffic counters.
+     * @return Publications, unchanged ones and deliveries since boot.
+     */
+    BusStats stats() const {
+        return this->m_stats;
+    }
+
+  private:
+    const Entry *m_table;           ///< Subscribers.
+    uint8_t m_count;                ///< Number of subscribers.
+    Payload m_latest[TOPICS] = {};  ///< Latest payload of each topic.
+    bool m_published[TOPICS] = {};  ///< Topic published at least once.
+    bool m_pending[TOPICS] = {};    ///< Topic in the queue.
+    uint8_t m_queue[TOPICS] = {};   ///< Topics to deliver, oldest first.
+    uint8_t m_head = 0;             ///< Oldest queued topic.
+    uint8_t m_size = 0;             ///< Queued topics.
+    BusStats m_stats = {};          ///< Traffic counters.
+};
+
+} // namespace sys
+
+#endif // TOPIC_BUS_HH
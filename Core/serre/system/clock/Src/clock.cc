@@ -0,0 +1,78 @@
+#include "../inc/clock.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t HSI_HZ = 16000000;
+constexpr uint32_t MAX_HZ_PER_WAIT_STATE = 24000000; // Range 1
+constexpr uint32_t I2C_TIMING_CLOCK_HZ = 4000000;
+constexpr uint32_t SCL_LOW_NS = 5000;   // tLOW >= 4.7 us
+constexpr uint32_t SCL_HIGH_NS = 4000;  // tHIGH >= 4.0 us
+constexpr uint32_t SDA_HOLD_NS = 500;   // tHD;DAT <= 3.45 us
+constexpr uint32_t SDA_SETUP_NS = 1250; // tSU;DAT >= 250 ns
+
+/**
+ * @brief Converts a duration to timing clock periods, rounded to nearest.
+ */
+uint32_t periods(uint32_t ns, uint32_t clockHz) {
+    uint64_t scaled = static_cast<uint64_t>(ns) * clockHz + 500000000ULL;
+    return static_cast<uint32_t>(scaled / 1000000000ULL);
+}
+
+uint32_t clamp(uint32_t value, uint32_t min, uint32_t max) {
+    if (value < min) {
+        return min;
+    }
+    if (value > max) {
+        return max;
+    }
+    return value;
+}
+
+} // namespace
+
+uint32_t clockProfileHz(ClockProfile profile) {
+    switch (profile) {
+    case ClockProfile::ECO:
+        return HSI_HZ / 4;
+    case ClockProfile::PERFORMANCE:
+        return HSI_HZ * 4;
+    default:
+        return HSI_HZ;
+    }
+}
+
+uint8_t flashWaitStates(uint32_t hclkHz) {
+    uint8_t waitStates = 0;
+    while ((hclkHz > MAX_HZ_PER_WAIT_STATE * (waitStates + 1U)) &&
+           (waitStates < 2)) {
+        waitStates++;
+    }
+    return waitStates;
+}
+
+uint32_t uartBrr(uint32_t pclkHz, uint32_t baudRate) {
+    if (baudRate == 0) {
+        return 0;
+    }
+    return (pclkHz + (baudRate / 2)) / baudRate;
+}
+
+uint32_t i2cStandardTiming(uint32_t i2cClockHz) {
+    // Divider rounded up so that the timing clock stays at most 4 MHz
+    uint32_t prescaler = clamp(
+        (i2cClockHz + I2C_TIMING_CLOCK_HZ - 1) / I2C_TIMING_CLOCK_HZ, 1, 16);
+    uint32_t clockHz = i2cClockHz / prescaler;
+
+    // SCLL, SCLH and SCLDEL count one period more than their value
+    uint32_t sclLow = clamp(periods(SCL_LOW_NS, clockHz), 1, 256) - 1;
+    uint32_t sclHigh = clamp(periods(SCL_HIGH_NS, clockHz), 1, 256) - 1;
+    uint32_t sdaDelay = clamp(periods(SDA_HOLD_NS, clockHz), 0, 15);
+    uint32_t sclDelay = clamp(periods(SDA_SETUP_NS, clockHz), 1, 16) - 1;
+
+    return ((prescaler - 1) << 28) | (sclDelay << 20) | (sdaDelay << 16) |
+           (sclHigh << 8) | sclLow;
+}
+
+} // namespace sys
@@ -0,0 +1,171 @@
+#include "../inc/clock.hh"
+
+#include "../../../../Inc/i2c.h"
+#include "../../../../Inc/usart.h"
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t UART_DRAIN_TIMEOUT_MS = 2; ///< Last byte at 115200 Bd
+
+ClockProfile s_profile = ClockProfile::NORMAL;
+
+uint32_t flashLatency(uint8_t waitStates) {
+    switch (waitStates) {
+    case 0:
+        return FLASH_LATENCY_0;
+    case 1:
+        return FLASH_LATENCY_1;
+    default:
+        return FLASH_LATENCY_2;
+    }
+}
+
+bool selectSysclk(uint32_t source, uint32_t hclkHz) {
+    RCC_ClkInitTypeDef clk = {};
+    clk.ClockType =
+        RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1;
+    clk.SYSCLKSource = source;
+    clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    uint32_t latency = flashLatency(flashWaitStates(hclkHz));
+    // Raises the latency before and lowers it after the switch, and
+    // reloads SysTick from the new SystemCoreClock
+    return HAL_RCC_ClockConfig(&clk, latency) == HAL_OK;
+}
+
+bool runFromPll() {
+    RCC_OscInitTypeDef osc = {};
+    osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    osc.HSIState = RCC_HSI_ON;
+    osc.HSIDiv = RCC_HSI_DIV1;
+    osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    // 16 MHz x 8 = 128 MHz VCO, / 2 = 64 MHz
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+    osc.PLL.PLLM = RCC_PLLM_DIV1;
+    osc.PLL.PLLN = 8;
+    osc.PLL.PLLP = RCC_PLLP_DIV2;
+#if defined(RCC_PLLQ_SUPPORT)
+    osc.PLL.PLLQ = RCC_PLLQ_DIV2;
+#endif
+    osc.PLL.PLLR = RCC_PLLR_DIV2;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+        return false;
+    }
+    return selectSysclk(RCC_SYSCLKSOURCE_PLLCLK,
+                        clockProfileHz(ClockProfile::PERFORMANCE));
+}
+
+bool runFromHsi(uint32_t hsiDiv, uint32_t hclkHz) {
+    // Leave the PLL first: the HSI divider is ignored while it is SYSCLK
+    if ((__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_SYSCLKSOURCE_STATUS_PLLCLK) &&
+        !selectSysclk(RCC_SYSCLKSOURCE_HSI,
+                      clockProfileHz(ClockProfile::NORMAL))) {
+        return false;
+    }
+    RCC_OscInitTypeDef osc = {};
+    osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    osc.HSIState = RCC_HSI_ON;
+    osc.HSIDiv = hsiDiv;
+    osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    osc.PLL.PLLState = RCC_PLL_OFF;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+        return false;
+    }
+    return selectSysclk(RCC_SYSCLKSOURCE_HSI, hclkHz);
+}
+
+// USART2 and I2C1 are initialized on demand: one still in reset is idle,
+// and its init function will time it from the clock in place then
+bool peripheralsIdle() {
+    HAL_I2C_StateTypeDef i2cState = HAL_I2C_GetState(&hi2c1);
+    if ((i2cState != HAL_I2C_STATE_READY) &&
+        (i2cState != HAL_I2C_STATE_RESET)) {
+        return false;
+    }
+    if (huart2.gState == HAL_UART_STATE_RESET) {
+        return true;
+    }
+    if (huart2.gState != HAL_UART_STATE_READY) {
+        return false;
+    }
+    // Let the last byte of a blocking transmit leave the shift register
+    uint32_t start = HAL_GetTick();
+    while (!__HAL_UART_GET_FLAG(&huart2, UART_FLAG_TC)) {
+        if ((HAL_GetTick() - start) > UART_DRAIN_TIMEOUT_MS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void retimePeripherals() {
+    uint32_t pclkHz = HAL_RCC_GetPCLK1Freq();
+
+    if (huart2.gState != HAL_UART_STATE_RESET) {
+        __HAL_UART_DISABLE(&huart2);
+        huart2.Instance->BRR = uartBrr(pclkHz, huart2.Init.BaudRate);
+        __HAL_UART_ENABLE(&huart2);
+    }
+
+    // TIMINGR can only be written with the peripheral disabled
+    if (HAL_I2C_GetState(&hi2c1) != HAL_I2C_STATE_RESET) {
+        hi2c1.Init.Timing = i2cStandardTiming(pclkHz);
+        __HAL_I2C_DISABLE(&hi2c1);
+        hi2c1.Instance->TIMINGR = hi2c1.Init.Timing;
+        __HAL_I2C_ENABLE(&hi2c1);
+    }
+}
+
+} // namespace
+
+bool clockSetProfile(ClockProfile profile) {
+    if (profile == s_profile) {
+        return true;
+    }
+    if (!peripheralsIdle()) {
+        return false;
+    }
+
+    // Range 2 is limited to 16 MHz: leave it before speeding up
+    if (s_profile == ClockProfile::ECO) {
+        HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE1);
+    }
+
+    bool switched;
+    switch (profile) {
+    case ClockProfile::PERFORMANCE:
+        switched = runFromPll();
+        break;
+    case ClockProfile::ECO:
+        switched = runFromHsi(RCC_HSI_DIV4, clockProfileHz(profile));
+        break;
+    default:
+        switched = runFromHsi(RCC_HSI_DIV1, clockProfileHz(profile));
+        break;
+    }
+    if (!switched) {
+        // The RCC keeps a valid configuration, just follow it
+        retimePeripherals();
+        return false;
+    }
+
+    // Prefetch and instruction cache stay on whatever the wait states
+    __HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+    if (profile == ClockProfile::ECO) {
+        HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE2);
+    }
+
+    retimePeripherals();
+    s_profile = profile;
+    return true;
+}
+
+ClockProfile clockProfile() {
+    return s_profile;
+}
+
+} // namespace sys
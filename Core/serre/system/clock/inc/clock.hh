@@ -0,0 +1,76 @@
+#ifndef CLOCK_HH
+#define CLOCK_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief System clock settings selectable at run time.
+ */
+enum class ClockProfile : uint8_t {
+    ECO = 0,    ///< HSI16 / 4 = 4 MHz, regulator range 2
+    NORMAL,     ///< HSI16 = 16 MHz, the reset configuration
+    PERFORMANCE ///< PLL from HSI16 = 64 MHz, 2 flash wait states
+};
+
+/**
+ * @brief Gets the core clock of a profile.
+ * @param profile Clock profile.
+ * @return SYSCLK (= HCLK = PCLK) in Hz.
+ */
+uint32_t clockProfileHz(ClockProfile profile);
+
+/**
+ * @brief Computes the flash wait states needed in regulator range 1.
+ * @param hclkHz AHB clock in Hz, at most 64 MHz.
+ * @return Number of wait states (0 to 2).
+ */
+uint8_t flashWaitStates(uint32_t hclkHz);
+
+/**
+ * @brief Computes the USART BRR value, 16x oversampling, no prescaler.
+ * @param pclkHz USART kernel clock in Hz.
+ * @param baudRate Baud rate.
+ * @return BRR register value, rounded to the nearest.
+ */
+uint32_t uartBrr(uint32_t pclkHz, uint32_t baudRate);
+
+/**
+ * @brief Computes the I2C TIMINGR value for 100 kHz standard mode.
+ *
+ * The prescaler brings the timing clock close to 4 MHz, then the SCL low
+ * and high times (5.0 and 4.0 us), the data hold time (500 ns) and the data
+ * setup time (1250 ns) are rounded to that clock, as in the reference
+ * manual example. 16 MHz gives 0x30420F13.
+ *
+ * @param i2cClockHz I2C kernel clock in Hz, at least 2 MHz.
+ * @return TIMINGR register value.
+ */
+uint32_t i2cStandardTiming(uint32_t i2cClockHz);
+
+/**
+ * @brief Switches the system clock and retimes the clocked peripherals.
+ *
+ * Flash latency and the regulator range follow the profile, prefetch and
+ * the instruction cache are kept enabled.
+ * HAL_RCC_ClockConfig() reloads SysTick from the new core clock, and the
+ * USART2 baud rate and the I2C1 timing are recomputed. Both must be idle:
+ * a transfer in progress would be corrupted.
+ *
+ * @param profile Clock profile to apply.
+ * @return False if USART2 or I2C1 is in use or if the RCC refused the
+ * change.
+ */
+bool clockSetProfile(ClockProfile profile);
+
+/**
+ * @brief Gets the active clock profile.
+ * @return Profile set by the last successful clockSetProfile().
+ */
+ClockProfile clockProfile();
+
+} // namespace sys
+
+#endif // CLOCK_HH
@@ -0,0 +1,128 @@
+#include "../inc/crash.hh"
+
+#include "../../retained.hh"
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t CRASH_RECORD_MAGIC = 0x43525348UL; // "CRSH"
+constexpr uint32_t FRAME_WORDS = 8;
+constexpr uint32_t XPSR_STACK_ALIGN = 1UL << 9; // Frame was padded by 4 bytes
+
+CrashRecord s_crashRecord SERRE_NOINIT;
+
+/**
+ * @brief Appends "name=hhhhhhhh".
+ */
+void writeField(LineWriter &out, const char *name, uint32_t value) {
+    out.text(name);
+    out.put('=');
+    out.hex(value);
+}
+
+} // namespace
+
+void crashCapture(CrashRecord *record, const uint32_t *frame,
+                  uint32_t excReturn, uintptr_t ramStart, uintptr_t ramEnd,
+                  uint32_t bootCount) {
+    if (record == nullptr) {
+        return;
+    }
+    uintptr_t frameAddress = reinterpret_cast<uintptr_t>(frame);
+
+    record->bootCount = bootCount;
+    record->excReturn = excReturn;
+    record->sp = static_cast<uint32_t>(frameAddress);
+    record->r0 = record->r1 = record->r2 = record->r3 = 0;
+    record->r12 = record->lr = record->pc = record->xpsr = 0;
+    record->stackWords = 0;
+
+    if ((frameAddress >= ramStart) && ((frameAddress & 0x3U) == 0) &&
+        (frameAddress + FRAME_WORDS * sizeof(uint32_t) <= ramEnd)) {
+        record->r0 = frame[0];
+        record->r1 = frame[1];
+        record->r2 = frame[2];
+        record->r3 = frame[3];
+        record->r12 = frame[4];
+        record->lr = frame[5];
+        record->pc = frame[6];
+        record->xpsr = frame[7];
+
+        const uint32_t *stack = frame + FRAME_WORDS;
+        uint32_t sp = static_cast<uint32_t>(frameAddress) +
+                      FRAME_WORDS * sizeof(uint32_t);
+        if (record->xpsr & XPSR_STACK_ALIGN) {
+            sp += sizeof(uint32_t);
+        }
+        record->sp = sp;
+
+        while ((record->stackWords < CRASH_STACK_WORDS) &&
+               (reinterpret_cast<uintptr_t>(stack + record->stackWords + 1) <=
+                ramEnd)) {
+            record->stack[record->stackWords] = stack[record->stackWords];
+            record->stackWords++;
+        }
+    }
+    record->magic = CRASH_RECORD_MAGIC;
+}
+
+bool crashIsValid(const CrashRecord *record) {
+    return (record != nullptr) && (record->magic == CRASH_RECORD_MAGIC) &&
+           (record->stackWords <= CRASH_STACK_WORDS);
+}
+
+void crashInvalidate(CrashRecord *record) {
+    if (record != nullptr) {
+        record->magic = 0;
+    }
+}
+
+size_t crashFormat(const CrashRecord *record, char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    if (!crashIsValid(record)) {
+        return 0;
+    }
+    out.text("CRASH ");
+    writeField(out, "boot", record->bootCount);
+    out.text(" ");
+    writeField(out, "exc", record->excReturn);
+    out.text("\r\n");
+
+    writeField(out, "pc", record->pc);
+    out.text(" ");
+    writeField(out, "lr", record->lr);
+    out.text(" ");
+    writeField(out, "xpsr", record->xpsr);
+    out.text(" ");
+    writeField(out, "sp", record->sp);
+    out.text("\r\n");
+
+    writeField(out, "r0", record->r0);
+    out.text(" ");
+    writeField(out, "r1", record->r1);
+    out.text(" ");
+    writeField(out, "r2", record->r2);
+    out.text(" ");
+    writeField(out, "r3", record->r3);
+    out.text(" ");
+    writeField(out, "r12", record->r12);
+    out.text("\r\n");
+
+    out.text("stack=");
+    for (uint32_t i = 0; i < record->stackWords; i++) {
+        if (i > 0) {
+            out.text(" ");
+        }
+        out.hex(record->stack[i]);
+    }
+    out.text("\r\nEND\r\n");
+    return out.length();
+}
+
+CrashRecord *retainedCrashRecord() {
+    return &s_crashRecord;
+}
+
+} // namespace sys
@@ -0,0 +1,73 @@
+#include "../inc/crash.hh"
+
+#include "../../../../Inc/usart.h"
+#include "../../fault/inc/fault.hh"
+#include "../../watchdog/inc/watchdog.hh"
+
+extern "C" {
+extern uint32_t _estack; ///< End of RAM, defined in the linker script
+
+void crash_captureFrame(const uint32_t *frame, uint32_t excReturn);
+void HardFault_Handler(void);
+}
+
+namespace {
+constexpr uint32_t IWDG_KEY_START = 0xCCCC;
+constexpr uint32_t CRASH_UART_TIMEOUT_MS = 100;
+} // namespace
+
+/**
+ * @brief Hard fault entry point.
+ *
+ * Naked so that no prologue touches the stack before the frame address is
+ * known. Bit 2 of EXC_RETURN tells which stack holds the frame. Cortex-M0+
+ * has no `tst` with immediate, hence the detour through r0.
+ */
+extern "C" __attribute__((naked)) void HardFault_Handler(void) {
+    __asm volatile("movs r0, #4               \n"
+                   "mov  r1, lr               \n"
+                   "tst  r0, r1               \n"
+                   "beq  1f                   \n"
+                   "mrs  r0, psp              \n"
+                   "b    2f                   \n"
+                   "1:                        \n"
+                   "mrs  r0, msp              \n"
+                   "2:                        \n"
+                   "bl   crash_captureFrame   \n");
+}
+
+extern "C" void crash_captureFrame(const uint32_t *frame, uint32_t excReturn) {
+    uint32_t bootCount = sys::resetRecord().bootCount;
+    sys::crashCapture(sys::retainedCrashRecord(), frame, excReturn, SRAM_BASE,
+                      reinterpret_cast<uintptr_t>(&_estack), bootCount);
+    sys::faultLogPush(sys::retainedFaultLog(), sys::FaultCode::SYSTEM_HARDFAULT,
+                      HAL_GetTick(), static_cast<uint16_t>(bootCount));
+    main_serre_safeState();
+
+    // Make sure a watchdog reset follows, even if the fault hit before the
+    // supervisor started it. The next boot reports the record.
+    IWDG->KR = IWDG_KEY_START;
+    while (1) {
+    }
+}
+
+namespace sys {
+
+bool crashEmitReport() {
+    CrashRecord *record = retainedCrashRecord();
+    if (!crashIsValid(record)) {
+        return false;
+    }
+    char report[400];
+    size_t length = crashFormat(record, report, sizeof(report));
+    if (HAL_UART_Transmit(&huart2, reinterpret_cast<const uint8_t *>(report),
+                          static_cast<uint16_t>(length),
+                          CRASH_UART_TIMEOUT_MS) != HAL_OK) {
+        // Keep the record for the next boot
+        return false;
+    }
+    crashInvalidate(record);
+    return true;
+}
+
+} // namespace sys
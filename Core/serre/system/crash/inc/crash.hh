@@ -0,0 +1,97 @@
+#ifndef CRASH_HH
+#define CRASH_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+constexpr uint8_t CRASH_STACK_WORDS = 16; ///< Words dumped above the frame.
+
+/**
+ * @brief HardFault post-mortem record, kept in `.noinit` RAM.
+ *
+ * The exception frame is stacked by the core on fault entry: R0-R3, R12,
+ * LR, PC and xPSR. `sp` is the stack pointer of the faulting code, i.e.
+ * the frame address plus the frame size.
+ */
+typedef struct {
+    uint32_t magic;                    ///< Validity marker
+    uint32_t bootCount;                ///< Boot number the fault occurred in
+    uint32_t r0;                       ///< Stacked R0
+    uint32_t r1;                       ///< Stacked R1
+    uint32_t r2;                       ///< Stacked R2
+    uint32_t r3;                       ///< Stacked R3
+    uint32_t r12;                      ///< Stacked R12
+    uint32_t lr;                       ///< Stacked LR (caller return address)
+    uint32_t pc;                       ///< Stacked PC (faulting instruction)
+    uint32_t xpsr;                     ///< Stacked xPSR
+    uint32_t sp;                       ///< Stack pointer before the fault
+    uint32_t excReturn;                ///< EXC_RETURN value (MSP or PSP)
+    uint32_t stackWords;               ///< Valid words in `stack`
+    uint32_t stack[CRASH_STACK_WORDS]; ///< Stack content above the frame
+} CrashRecord;
+
+/**
+ * @brief Fills a crash record from a stacked exception frame.
+ *
+ * Only reads memory inside [ramStart, ramEnd): a corrupted stack pointer
+ * yields a record with the registers left at zero instead of a lockup.
+ * @param[out] record Record to fill.
+ * @param frame Address of the stacked exception frame.
+ * @param excReturn EXC_RETURN value found in LR on handler entry.
+ * @param ramStart First valid RAM address.
+ * @param ramEnd End of RAM (exclusive).
+ * @param bootCount Current boot number.
+ */
+void crashCapture(CrashRecord *record, const uint32_t *frame,
+                  uint32_t excReturn, uintptr_t ramStart, uintptr_t ramEnd,
+                  uint32_t bootCount);
+
+/**
+ * @brief Checks if a record holds an unreported crash.
+ * @param record Record to check.
+ * @return True if the record is valid.
+ */
+bool crashIsValid(const CrashRecord *record);
+
+/**
+ * @brief Marks a record as reported.
+ * @param record Record to invalidate.
+ */
+void crashInvalidate(CrashRecord *record);
+
+/**
+ * @brief Formats a record as text lines for the serial console.
+ *
+ * The format is parsed by `tools/crash_decode.py`:
+ * @verbatim
+ * CRASH boot=00000003 exc=fffffff9
+ * pc=08000a3c lr=08000a21 xpsr=61000003 sp=20001fc8
+ * r0=00000000 r1=20000010 r2=00000001 r3=00000000 r12=00000000
+ * stack=08000c5d 00000000 ...
+ * END
+ * @endverbatim
+ * @param record Record to format.
+ * @param[out] buffer Output buffer, always NUL terminated.
+ * @param size Buffer size in bytes.
+ * @return Number of characters written, excluding the terminator.
+ */
+size_t crashFormat(const CrashRecord *record, char *buffer, size_t size);
+
+/**
+ * @brief Gets the crash record kept in retained RAM.
+ * @return Pointer to the retained record.
+ */
+CrashRecord *retainedCrashRecord();
+
+/**
+ * @brief Sends a pending crash report over USART2, then invalidates it.
+ * @return True if a report was sent.
+ */
+bool crashEmitReport();
+
+} // namespace sys
+
+#endif // CRASH_HH
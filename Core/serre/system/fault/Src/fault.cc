@@ -0,0 +1,132 @@
+#include "../inc/fault.hh"
+
+#include "../../retained.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t FAULT_LOG_MAGIC = 0x464C4F47UL; // "FLOG"
+
+FaultLog s_faultLog SERRE_NOINIT;
+bool s_faultLogChecked = false;
+
+} // namespace
+
+Subsystem faultSubsystem(FaultCode code) {
+    uint8_t index = static_cast<uint8_t>(static_cast<uint16_t>(code) >> 8);
+    if ((index == 0) ||
+        (index > static_cast<uint8_t>(Subsystem::COUNT))) {
+        return Subsystem::COUNT;
+    }
+    return static_cast<Subsystem>(index - 1);
+}
+
+void faultLogInit(FaultLog *log) {
+    if (log == nullptr) {
+        return;
+    }
+    if ((log->magic != FAULT_LOG_MAGIC) || (log->head >= FAULT_LOG_SIZE) ||
+        (log->count > FAULT_LOG_SIZE)) {
+        log->magic = FAULT_LOG_MAGIC;
+        log->head = 0;
+        log->count = 0;
+    }
+}
+
+void faultLogPush(FaultLog *log, FaultCode code, uint32_t timestampMs,
+                  uint16_t bootCount) {
+    if (log == nullptr) {
+        return;
+    }
+    FaultRecord &entry = log->entries[log->head];
+    entry.timestampMs = timestampMs;
+    entry.code = static_cast<uint16_t>(code);
+    entry.bootCount = bootCount;
+    log->head = (log->head + 1) % FAULT_LOG_SIZE;
+    if (log->count < FAULT_LOG_SIZE) {
+        log->count++;
+    }
+}
+
+bool faultLogGet(const FaultLog *log, uint16_t index, FaultRecord *outRecord) {
+    if ((log == nullptr) || (outRecord == nullptr) || (index >= log->count)) {
+        return false;
+    }
+    uint16_t oldest = (log->head + FAULT_LOG_SIZE - log->count) % FAULT_LOG_SIZE;
+    *outRecord = log->entries[(oldest + index) % FAULT_LOG_SIZE];
+    return true;
+}
+
+FaultLog *retainedFaultLog() {
+    if (!s_faultLogChecked) {
+        faultLogInit(&s_faultLog);
+        s_faultLogChecked = true;
+    }
+    return &s_faultLog;
+}
+
+FaultManager::FaultManager(FaultLog *log, uint16_t bootCount) {
+    this->m_log = log;
+    this->m_bootCount = bootCount;
+}
+
+FaultAction FaultManager::report(FaultCode code, uint32_t nowMs) {
+    Subsystem subsystem = faultSubsystem(code);
+    if (subsystem == Subsystem::COUNT) {
+        return FaultAction::GIVE_UP;
+    }
+    uint8_t index = static_cast<uint8_t>(subsystem);
+    if (this->m_degraded & (1U << index)) {
+        // Already logged when the subsystem gave up
+        return FaultAction::GIVE_UP;
+    }
+
+    faultLogPush(this->m_log, code, nowMs, this->m_bootCount);
+    this->m_failures[index]++;
+    if (this->m_failures[index] >= DEGRADED_AFTER) {
+        this->m_degraded |= static_cast<uint8_t>(1U << index);
+        return FaultAction::GIVE_UP;
+    }
+    if (this->m_failures[index] == REINIT_AFTER) {
+        return FaultAction::REINITIALIZE;
+    }
+    return FaultAction::RETRY;
+}
+
+void FaultManager::clear(Subsystem subsystem) {
+    uint8_t index = static_cast<uint8_t>(subsystem);
+    if (index >= SUBSYSTEM_COUNT) {
+        return;
+    }
+    this->m_failures[index] = 0;
+    this->m_degraded &= static_cast<uint8_t>(~(1U << index));
+}
+
+uint32_t FaultManager::retryDelayMs(Subsystem subsystem) const {
+    uint8_t failures = this->failures(subsystem);
+    if (failures == 0) {
+        return 0;
+    }
+    uint32_t delay = BASE_BACKOFF_MS << (failures - 1);
+    if (delay > MAX_BACKOFF_MS) {
+        delay = MAX_BACKOFF_MS;
+    }
+    return delay;
+}
+
+uint8_t FaultManager::failures(Subsystem subsystem) const {
+    uint8_t index = static_cast<uint8_t>(subsystem);
+    return index < SUBSYSTEM_COUNT ? this->m_failures[index] : 0;
+}
+
+bool FaultManager::isDegraded(Subsystem subsystem) const {
+    uint8_t index = static_cast<uint8_t>(subsystem);
+    return (index < SUBSYSTEM_COUNT) && (this->m_degraded & (1U << index));
+}
+
+bool FaultManager::isDegraded() const {
+    return this->m_degraded != 0;
+}
+
+} // namespace sys
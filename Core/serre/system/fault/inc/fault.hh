@@ -0,0 +1,192 @@
+#ifndef FAULT_HH
+#define FAULT_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Subsystems with independent retry and back-off state.
+ */
+enum class Subsystem : uint8_t {
+    ANALOG = 0, ///< ADC1 acquisition
+    I2C,        ///< I2C1 bus
+    UART,       ///< USART2 console
+    CLOCK,      ///< RCC clock tree
+    SYSTEM,     ///< Core and startup
+    COUNT
+};
+
+/**
+ * @brief Fault codes. The high byte is the subsystem index plus one.
+ */
+enum class FaultCode : uint16_t {
+    NONE = 0x0000,
+    ADC_ERROR = 0x0101,   ///< Channel configuration or start failed
+    ADC_TIMEOUT = 0x0102, ///< Conversion did not complete in time
+    ADC_BUSY = 0x0103,    ///< Peripheral locked by another operation
+    ADC_PROBE_RAIL = 0x0104,     ///< Probe at a supply rail, open or shorted
+    ADC_PROBE_STUCK = 0x0105,    ///< Probe value frozen
+    ADC_PROBE_RATE = 0x0106,     ///< Probe value jumped implausibly fast
+    ADC_PROBE_NOISE = 0x0107,    ///< Probe noise above its limit
+    ADC_PROBE_MISMATCH = 0x0108, ///< Air probe far from the die temperature
+    I2C_ERROR = 0x0201,   ///< Bus error, arbitration loss or NACK
+    I2C_TIMEOUT = 0x0202, ///< Transfer did not complete in time
+    I2C_BUSY = 0x0203,    ///< Bus held busy
+    I2C_STUCK = 0x0204,   ///< Bus recovery failed, a line stays low
+    UART_ERROR = 0x0301,  ///< Transmission failed
+    CLOCK_ERROR = 0x0401, ///< Oscillator or bus clock configuration failed
+    SYSTEM_ERROR_HANDLER = 0x0501,  ///< Error_Handler() reached
+    SYSTEM_WATCHDOG_RESET = 0x0502, ///< Previous boot ended in an IWDG reset
+    SYSTEM_HARDFAULT = 0x0503,      ///< HardFault captured in the crash record
+    SYSTEM_RAM_LOW = 0x0504,        ///< Stack and heap close to colliding
+    SYSTEM_POOL_FAULT = 0x0505,     ///< Pool exhausted or foreign block freed
+    SYSTEM_HEAP_USED = 0x0506,      ///< _sbrk() called in a strict heap build
+    SYSTEM_OVERHEAT = 0x0507        ///< Die too hot, clock throttled
+};
+
+/**
+ * @brief What the caller should do after reporting a fault.
+ */
+enum class FaultAction : uint8_t {
+    RETRY = 0,    ///< Retry after retryDelayMs()
+    REINITIALIZE, ///< Reinitialize the peripheral, then retry
+    GIVE_UP       ///< Stop retrying, the subsystem is degraded
+};
+
+constexpr uint8_t FAULT_LOG_SIZE = 16; ///< Fault ring buffer capacity.
+
+/**
+ * @brief One fault log entry.
+ */
+typedef struct {
+    uint32_t timestampMs; ///< HAL tick at the time of the fault
+    uint16_t code;        ///< FaultCode value
+    uint16_t bootCount;   ///< Boot number the fault occurred in
+} FaultRecord;
+
+/**
+ * @brief Fault ring buffer, kept in `.noinit` RAM to survive resets.
+ */
+typedef struct {
+    uint32_t magic;                      ///< Validity marker
+    uint16_t head;                       ///< Next write index
+    uint16_t count;                      ///< Number of valid entries
+    FaultRecord entries[FAULT_LOG_SIZE]; ///< Oldest entry is overwritten
+} FaultLog;
+
+/**
+ * @brief Gets the subsystem a fault code belongs to.
+ * @param code Fault code.
+ * @return Subsystem, Subsystem::COUNT for FaultCode::NONE.
+ */
+Subsystem faultSubsystem(FaultCode code);
+
+/**
+ * @brief Validates a fault log, clearing it if its content is garbage.
+ * @param log Fault log to check.
+ */
+void faultLogInit(FaultLog *log);
+
+/**
+ * @brief Appends an entry, overwriting the oldest one when full.
+ * @param log Fault log.
+ * @param code Fault code.
+ * @param timestampMs HAL tick at the time of the fault.
+ * @param bootCount Current boot number.
+ */
+void faultLogPush(FaultLog *log, FaultCode code, uint32_t timestampMs,
+                  uint16_t bootCount);
+
+/**
+ * @brief Reads an entry, 0 being the oldest one.
+ * @param log Fault log.
+ * @param index Entry index.
+ * @param[out] outRecord Pointer to store the entry.
+ * @return True if the entry exists.
+ */
+bool faultLogGet(const FaultLog *log, uint16_t index, FaultRecord *outRecord);
+
+/**
+ * @brief Gets the fault log kept in retained RAM.
+ * @return Pointer to the retained log, validated on first access.
+ */
+FaultLog *retainedFaultLog();
+
+/**
+ * @class FaultManager
+ * @brief Tracks faults per subsystem and decides on retry and back-off.
+ *
+ * Consecutive failures of a subsystem get an exponential back-off. The
+ * second failure asks for a peripheral reinitialization and the fourth one
+ * marks the subsystem degraded until the next success. While degraded,
+ * every report returns GIVE_UP so the caller tries once per cycle only.
+ */
+class FaultManager {
+  public:
+    /**
+     * @brief Constructor for FaultManager.
+     * @param log Fault log receiving the reports, may be nullptr.
+     * @param bootCount Boot number stamped on each log entry.
+     */
+    FaultManager(FaultLog *log, uint16_t bootCount);
+
+    /**
+     * @brief Reports a fault.
+     * @param code Fault code.
+     * @param nowMs Current tick in milliseconds.
+     * @return Action the caller should take.
+     */
+    FaultAction report(FaultCode code, uint32_t nowMs);
+
+    /**
+     * @brief Reports a successful operation, ending any degraded state.
+     * @param subsystem Subsystem that succeeded.
+     */
+    void clear(Subsystem subsystem);
+
+    /**
+     * @brief Gets the delay to wait before the next attempt.
+     * @param subsystem Subsystem to query.
+     * @return Back-off delay in milliseconds.
+     */
+    uint32_t retryDelayMs(Subsystem subsystem) const;
+
+    /**
+     * @brief Gets the number of consecutive failures.
+     * @param subsystem Subsystem to query.
+     * @return Failures since the last success.
+     */
+    uint8_t failures(Subsystem subsystem) const;
+
+    /**
+     * @brief Checks if a subsystem gave up retrying.
+     * @param subsystem Subsystem to query.
+     * @return True if degraded.
+     */
+    bool isDegraded(Subsystem subsystem) const;
+
+    /**
+     * @brief Checks if any subsystem is degraded.
+     * @return True if at least one subsystem is degraded.
+     */
+    bool isDegraded() const;
+
+  private:
+    static constexpr uint8_t SUBSYSTEM_COUNT =
+        static_cast<uint8_t>(Subsystem::COUNT);
+    static constexpr uint8_t REINIT_AFTER = 2;     ///< Failures before reinit
+    static constexpr uint8_t DEGRADED_AFTER = 4;   ///< Failures before giving up
+    static constexpr uint32_t BASE_BACKOFF_MS = 1; ///< First retry delay
+    static constexpr uint32_t MAX_BACKOFF_MS = 50; ///< Retry delay ceiling
+
+    FaultLog *m_log = nullptr;                 ///< Log receiving the reports.
+    uint16_t m_bootCount = 0;                  ///< Stamped on log entries.
+    uint8_t m_failures[SUBSYSTEM_COUNT] = {0}; ///< Consecutive failures.
+    uint8_t m_degraded = 0;                    ///< Degraded subsystem bits.
+};
+
+} // namespace sys
+
+#endif // FAULT_HH
@@ -0,0 +1,52 @@
+#include "../inc/isr_latency.hh"
+
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+namespace {
+
+/**
+ * @brief Appends the spread of a set of samples, "min-max".
+ */
+void writeRange(LineWriter &out, const LatencyStats &stats) {
+    out.number(stats.minCycles);
+    out.put('-');
+    out.number(stats.maxCycles);
+}
+
+} // namespace
+
+void latencyAdd(LatencyStats *stats, uint32_t cycles) {
+    if ((stats->samples == 0) || (cycles < stats->minCycles)) {
+        stats->minCycles = cycles;
+    }
+    if ((stats->samples == 0) || (cycles > stats->maxCycles)) {
+        stats->maxCycles = cycles;
+    }
+    stats->totalCycles += cycles;
+    stats->samples++;
+}
+
+uint32_t sysTickElapsed(uint32_t start, uint32_t end, uint32_t reload) {
+    if (end <= start) {
+        return start - end;
+    }
+    // The counter wrapped through zero and restarted from reload
+    return start + (reload + 1U - end);
+}
+
+size_t isrLatencyFormat(const IsrLatencyReport *report, uint32_t coreMHz,
+                        char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    out.text("ISR latency @");
+    out.number(coreMHz);
+    out.text("MHz: ram ");
+    writeRange(out, report->ram);
+    out.text(" flash ");
+    writeRange(out, report->flash);
+    out.text(" cycles");
+    return out.length();
+}
+
+} // namespace sys
@@ -0,0 +1,76 @@
+#include "../inc/isr_latency.hh"
+
+#include "../../../../Inc/main.h"
+#include "../../ramfunc.hh"
+
+namespace {
+
+volatile uint32_t s_entryTicks = 0; ///< SysTick value at handler entry
+
+void flushInstructionCache() {
+    __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+    __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+}
+
+/**
+ * @brief Pends an interrupt and returns the SysTick values around its
+ * entry. In RAM so that only the handler fetch differs between vectors.
+ */
+SERRE_RAMFUNC uint32_t pendAndWait(IRQn_Type irq) {
+    uint32_t start = SysTick->VAL;
+    NVIC->ISPR[0] = 1UL << static_cast<uint32_t>(irq);
+    __DSB();
+    __ISB();
+    return start;
+}
+
+uint32_t sample(IRQn_Type irq, bool cold) {
+    if (cold) {
+        flushInstructionCache();
+    }
+    uint32_t start = pendAndWait(irq);
+    return sys::sysTickElapsed(start, s_entryTicks, SysTick->LOAD);
+}
+
+void enableVector(IRQn_Type irq) {
+    NVIC_SetPriority(irq, 0);
+    NVIC_ClearPendingIRQ(irq);
+    NVIC_EnableIRQ(irq);
+}
+
+} // namespace
+
+// Spare vectors: TIM16 and TIM17 are not used by the application
+extern "C" SERRE_RAMFUNC void TIM16_IRQHandler(void) {
+    s_entryTicks = SysTick->VAL;
+}
+
+extern "C" void TIM17_IRQHandler(void) {
+    s_entryTicks = SysTick->VAL;
+}
+
+namespace sys {
+
+void measureIsrLatency(uint16_t samples, IsrLatencyReport *report) {
+    IsrLatencyReport empty = {};
+    *report = empty;
+
+    // Only the measured vectors may run, SysTick keeps counting
+    uint32_t enabled = NVIC->ISER[0];
+    NVIC->ICER[0] = enabled;
+    enableVector(TIM16_IRQn);
+    enableVector(TIM17_IRQn);
+
+    for (uint16_t i = 0; i < samples; i++) {
+        bool cold = (i & 1U) != 0;
+        latencyAdd(&report->ram, sample(TIM16_IRQn, cold));
+        latencyAdd(&report->flash, sample(TIM17_IRQn, cold));
+    }
+
+    NVIC_DisableIRQ(TIM16_IRQn);
+    NVIC_DisableIRQ(TIM17_IRQn);
+    NVIC->ISER[0] = enabled;
+}
+
+} // namespace sys
@@ -0,0 +1,85 @@
+#ifndef ISR_LATENCY_HH
+#define ISR_LATENCY_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Spread of a set of latency samples.
+ *
+ * @struct LatencyStats
+ * @var uint32_t minCycles
+ *      Shortest sample.
+ * @var uint32_t maxCycles
+ *      Longest sample.
+ * @var uint32_t totalCycles
+ *      Sum of the samples, for the mean.
+ * @var uint16_t samples
+ *      Number of samples.
+ */
+typedef struct {
+    uint32_t minCycles;   ///< Shortest sample
+    uint32_t maxCycles;   ///< Longest sample
+    uint32_t totalCycles; ///< Sum of the samples
+    uint16_t samples;     ///< Number of samples
+} LatencyStats;
+
+/**
+ * @brief Interrupt entry latency of a handler in RAM and of one in flash.
+ */
+typedef struct {
+    LatencyStats ram;   ///< SERRE_RAMFUNC handler
+    LatencyStats flash; ///< Handler left in flash
+} IsrLatencyReport;
+
+/**
+ * @brief Adds a sample to a set.
+ * @param stats Set of samples, zero-initialized before the first sample.
+ * @param cycles Sample, in core cycles.
+ */
+void latencyAdd(LatencyStats *stats, uint32_t cycles);
+
+/**
+ * @brief Computes the cycles elapsed between two SysTick readings.
+ * @param start Counter value at the start (SysTick counts down).
+ * @param end Counter value at the end, at most one reload later.
+ * @param reload SysTick reload value.
+ * @return Elapsed core cycles.
+ */
+uint32_t sysTickElapsed(uint32_t start, uint32_t end, uint32_t reload);
+
+/**
+ * @brief Formats a report as one line for the serial console.
+ *
+ * @verbatim
+ * ISR latency @64MHz: ram 20-20 flash 20-31 cycles
+ * @endverbatim
+ * @param report Report to format.
+ * @param coreMHz Core clock during the measurement, in MHz.
+ * @param[out] buffer Output buffer, always NUL terminated.
+ * @param size Buffer size in bytes.
+ * @return Number of characters written, excluding the terminator.
+ */
+size_t isrLatencyFormat(const IsrLatencyReport *report, uint32_t coreMHz,
+                        char *buffer, size_t size);
+
+/**
+ * @brief Measures the delay from pending an interrupt to its handler.
+ *
+ * Two spare vectors (TIM16 and TIM17) are pended by software, one with its
+ * handler in RAM and one in flash. Every other sample starts with the
+ * instruction cache flushed, as after a burst of unrelated code, so the
+ * spread of the flash handler shows the cost of wait states and cache
+ * misses. Runs with the other interrupts masked.
+ *
+ * @param samples Samples per handler.
+ * @param[out] report Results, in core cycles.
+ */
+void measureIsrLatency(uint16_t samples, IsrLatencyReport *report);
+
+} // namespace sys
+
+#endif // ISR_LATENCY_HH
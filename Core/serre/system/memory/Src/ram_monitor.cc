@@ -0,0 +1,29 @@
+#include "../inc/ram_monitor.hh"
+
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+uint32_t stackPeakBytes(const uint32_t *bottom, const uint32_t *top,
+                        uint32_t paint) {
+    const uint32_t *word = bottom;
+    while ((word < top) && (*word == paint)) {
+        word++;
+    }
+    return static_cast<uint32_t>(top - word) * sizeof(uint32_t);
+}
+
+size_t ramUsageFormat(const RamUsage *usage, char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    out.text("ram static=");
+    out.number(usage->staticBytes);
+    out.text(" heap=");
+    out.number(usage->heapBytes);
+    out.text(" stack=");
+    out.number(usage->stackBytes);
+    out.text(" free=");
+    out.number(usage->freeBytes);
+    return out.length();
+}
+
+} // namespace sys
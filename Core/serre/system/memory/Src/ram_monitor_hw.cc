@@ -0,0 +1,31 @@
+#include "../inc/ram_monitor.hh"
+
+#include "../../../../Inc/main.h"
+
+extern "C" {
+extern uint32_t _end;    ///< Heap start, defined in the linker script
+extern uint32_t _estack; ///< End of RAM, defined in the linker script
+
+uint8_t *sysmem_heapPeak(void);
+}
+
+namespace sys {
+
+void ramUsageRead(RamUsage *usage) {
+    uintptr_t heapStart = reinterpret_cast<uintptr_t>(&_end);
+    uintptr_t heapPeak = reinterpret_cast<uintptr_t>(sysmem_heapPeak());
+    uintptr_t stackTop = reinterpret_cast<uintptr_t>(&_estack);
+
+    // The heap overwrote the paint below its high-water mark
+    const uint32_t *bottom =
+        reinterpret_cast<const uint32_t *>((heapPeak + 3U) & ~3U);
+    uint32_t stack = stackPeakBytes(bottom, &_estack, STACK_PAINT);
+
+    usage->staticBytes = static_cast<uint32_t>(heapStart - SRAM_BASE);
+    usage->heapBytes = static_cast<uint32_t>(heapPeak - heapStart);
+    usage->stackBytes = stack;
+    usage->freeBytes = static_cast<uint32_t>(
+        stackTop - stack - reinterpret_cast<uintptr_t>(bottom));
+}
+
+} // namespace sys
@@ -0,0 +1,68 @@
+#ifndef RAM_MONITOR_HH
+#define RAM_MONITOR_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Word written by the startup code over the free RAM between the
+ * heap start (`_end`) and the top of the stack. Must match the value in
+ * startup_stm32g031k8tx.s.
+ */
+constexpr uint32_t STACK_PAINT = 0xC5C5C5C5U;
+
+/**
+ * @brief RAM use since boot.
+ *
+ * @struct RamUsage
+ * @var uint32_t staticBytes
+ *      .data, .bss, .noinit and .ramfunc, fixed at link time.
+ * @var uint32_t heapBytes
+ *      Largest heap handed out by _sbrk().
+ * @var uint32_t stackBytes
+ *      Deepest main stack use, interrupts included.
+ * @var uint32_t freeBytes
+ *      RAM never touched between the heap and the stack.
+ */
+typedef struct {
+    uint32_t staticBytes; ///< Link-time data, fixed
+    uint32_t heapBytes;   ///< Heap high-water mark
+    uint32_t stackBytes;  ///< Stack high-water mark
+    uint32_t freeBytes;   ///< Headroom left
+} RamUsage;
+
+/**
+ * @brief Finds the deepest stack use in painted RAM. The stack grows down
+ * from top: the first word above bottom that lost the paint is the lowest
+ * one ever written.
+ * @param bottom Lowest word the stack may reach (heap high-water mark).
+ * @param top End of the stack, exclusive (`_estack`).
+ * @param paint Value written at startup.
+ * @return Bytes between the deepest written word and top.
+ */
+uint32_t stackPeakBytes(const uint32_t *bottom, const uint32_t *top,
+                        uint32_t paint);
+
+/**
+ * @brief Formats the RAM use, without line ending:
+ * "ram static=3412 heap=0 stack=612 free=4168".
+ * @param usage RAM use.
+ * @param[out] buffer Destination, always NUL-terminated.
+ * @param size Size of the buffer.
+ * @return Length of the text, truncated to size - 1.
+ */
+size_t ramUsageFormat(const RamUsage *usage, char *buffer, size_t size);
+
+/**
+ * @brief Measures the RAM use. Scans the painted stack area, a few hundred
+ * microseconds at 16 MHz: call it from a low-rate task.
+ * @param[out] usage Pointer to store the result.
+ */
+void ramUsageRead(RamUsage *usage);
+
+} // namespace sys
+
+#endif // RAM_MONITOR_HH
@@ -0,0 +1,65 @@
+#include "../inc/pool_heap.hh"
+
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+namespace {
+
+BlockPool<16, SERRE_POOL_SMALL> s_small;
+BlockPool<32, SERRE_POOL_MEDIUM> s_medium;
+BlockPool<64, SERRE_POOL_LARGE> s_large;
+
+} // namespace
+
+void *poolAllocate(size_t size) {
+    void *block = nullptr;
+    if (size <= 16) {
+        block = s_small.allocate();
+    }
+    if ((block == nullptr) && (size <= 32)) {
+        block = s_medium.allocate();
+    }
+    if ((block == nullptr) && (size <= 64)) {
+        block = s_large.allocate();
+    }
+    return block;
+}
+
+bool poolRelease(void *pointer) {
+    if (pointer == nullptr) {
+        return true;
+    }
+    return s_small.release(pointer) || s_medium.release(pointer) ||
+           s_large.release(pointer);
+}
+
+PoolStats poolStats(uint8_t index) {
+    switch (index) {
+    case 0:
+        return s_small.stats();
+    case 1:
+        return s_medium.stats();
+    case 2:
+        return s_large.stats();
+    default:
+        return PoolStats();
+    }
+}
+
+size_t poolFormat(const PoolStats *stats, char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    out.text("pool ");
+    out.number(stats->blockSize);
+    out.text(" used=");
+    out.number(stats->used);
+    out.text(" peak=");
+    out.number(stats->peak);
+    out.text(" max=");
+    out.number(stats->capacity);
+    out.text(" fail=");
+    out.number(stats->failures);
+    return out.length();
+}
+
+} // namespace sys
@@ -0,0 +1,40 @@
+#include "../inc/pool_heap.hh"
+
+#include "../../../main_serre.h"
+
+#include <new>
+
+// Every C++ allocation of the firmware is served by the block pools: an
+// exhausted pool or a foreign pointer given back is a bug, trapped loudly.
+// The pools are empty unless the build sizes them, so by default any call
+// to operator new is trapped.
+
+void *operator new(size_t size) {
+    void *block = sys::poolAllocate(size);
+    if (block == nullptr) {
+        main_serre_poolFault();
+    }
+    return block;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return sys::poolAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return sys::poolAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    if (!sys::poolRelease(pointer)) {
+        main_serre_poolFault();
+    }
+}
+
+void operator delete[](void *pointer) noexcept {
+    operator delete(pointer);
+}
@@ -0,0 +1,167 @@
+#ifndef BLOCK_POOL_HH
+#define BLOCK_POOL_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Usage of a block pool.
+ *
+ * @struct PoolStats
+ * @var uint16_t blockSize
+ *      Bytes per block.
+ * @var uint16_t capacity
+ *      Number of blocks.
+ * @var uint16_t used
+ *      Blocks currently handed out.
+ * @var uint16_t peak
+ *      Highest used count since boot.
+ * @var uint32_t failures
+ *      Allocations refused because every block was used.
+ */
+typedef struct {
+    uint16_t blockSize; ///< Bytes per block
+    uint16_t capacity;  ///< Number of blocks
+    uint16_t used;      ///< Blocks handed out
+    uint16_t peak;      ///< High-water mark
+    uint32_t failures;  ///< Refused allocations
+} PoolStats;
+
+/**
+ * @class BlockPool
+ * @brief Fixed-size block allocator with compile-time storage.
+ *
+ * Free blocks are chained through their first word, so allocate() and
+ * release() are O(1) and the pool cannot fragment. Blocks never handed out
+ * are taken in order once the free list is empty, so the pool needs no
+ * set-up: in static storage it is constant-initialized and already works
+ * in the first static constructor. Main context only, not reentrant.
+ *
+ * @tparam SIZE Bytes per block, rounded up to 8.
+ * @tparam COUNT Number of blocks.
+ */
+template <size_t SIZE, uint16_t COUNT> class BlockPool {
+    static_assert(SIZE > 0, "BlockPool blocks must not be empty");
+
+  public:
+    /**
+     * @brief Takes a free block.
+     * @return Uninitialized block, 8-byte aligned, nullptr if none is left.
+     */
+    void *allocate() {
+        Block *block = this->m_free;
+        if (block != nullptr) {
+            this->m_free = block->next;
+        } else if (this->m_fresh < COUNT) {
+            block = &this->m_blocks[this->m_fresh++];
+        } else {
+            this->m_failures++;
+            return nullptr;
+        }
+        if (++this->m_used > this->m_peak) {
+            this->m_peak = this->m_used;
+        }
+        return block;
+    }
+
+    /**
+     * @brief Gives a block back.
+     * @param pointer Block from allocate().
+     * @return False if the pointer is not a block of this pool.
+     */
+    bool release(void *pointer) {
+        if (!this->owns(pointer)) {
+            return false;
+        }
+        Block *block = static_cast<Block *>(pointer);
+        block->next = this->m_free;
+        this->m_free = block;
+        this->m_used--;
+        return true;
+    }
+
+    /**
+     * @brief Checks if a pointer is the start of a block of this pool.
+     * @param pointer Pointer to check.
+     * @return True for a block of this pool.
+     */
+    bool owns(const void *pointer) const {
+        uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        uintptr_t first = reinterpret_cast<uintptr_t>(this->m_blocks);
+        return (address >= first) &&
+               (address < first + sizeof(this->m_blocks)) &&
+               (((address - first) % sizeof(Block)) == 0);
+    }
+
+    /**
+     * @brief Gets the usage of the pool.
+     * @return Block size, capacity, used, peak and failure counts.
+     */
+    PoolStats stats() const {
+        PoolStats stats = {static_cast<uint16_t>(sizeof(Block)), COUNT,
+                           this->m_used, this->m_peak, this->m_failures};
+        return stats;
+    }
+
+  private:
+    /**
+     * @brief Block storage, or link to the next free block.
+     */
+    union Block {
+        Block *next; ///< While free
+        alignas(8) uint8_t bytes[(SIZE + 7) & ~static_cast<size_t>(7)];
+    };
+
+    Block m_blocks[COUNT] = {}; ///< Storage.
+    Block *m_free = nullptr;    ///< Released blocks.
+    uint16_t m_fresh = 0;       ///< Blocks never handed out start here.
+    uint16_t m_used = 0;        ///< Blocks handed out.
+    uint16_t m_peak = 0;        ///< High-water mark.
+    uint32_t m_failures = 0;    ///< Refused allocations.
+};
+
+/**
+ * @class BlockPool
+ * @brief Pool without blocks: takes no RAM and refuses every allocation.
+ *
+ * Lets a size class be configured out at build time while its callers and
+ * its statistics stay in place.
+ *
+ * @tparam SIZE Bytes per block, rounded up to 8.
+ */
+template <size_t SIZE> class BlockPool<SIZE, 0> {
+    static_assert(SIZE > 0, "BlockPool blocks must not be empty");
+
+  public:
+    void *allocate() {
+        this->m_failures++;
+        return nullptr;
+    }
+
+    bool release(void *pointer) {
+        (void)pointer;
+        return false;
+    }
+
+    bool owns(const void *pointer) const {
+        (void)pointer;
+        return false;
+    }
+
+    PoolStats stats() const {
+        PoolStats stats = {
+            static_cast<uint16_t>((SIZE + 7) & ~static_cast<size_t>(7)), 0, 0,
+            0, this->m_failures};
+        return stats;
+    }
+
+  private:
+    uint32_t m_failures = 0; ///< Refused allocations.
+};
+
+} // namespace sys
+
+#endif // BLOCK_POOL_HH
@@ -0,0 +1,66 @@
+#ifndef POOL_HEAP_HH
+#define POOL_HEAP_HH
+
+// Includes
+#include "block_pool.hh"
+
+namespace sys {
+
+/**
+ * @brief Blocks of each size class.
+ *
+ * Drivers are constructed in place (driver/devices) and nothing in the
+ * firmware calls `operator new`, so the classes are empty by default and
+ * cost no RAM: a stray allocation still ends in main_serre_poolFault(). A
+ * build that needs dynamic objects sizes them (make POOLS=1).
+ */
+#ifndef SERRE_POOL_SMALL
+#define SERRE_POOL_SMALL 0 ///< 16-byte blocks
+#endif
+#ifndef SERRE_POOL_MEDIUM
+#define SERRE_POOL_MEDIUM 0 ///< 32-byte blocks
+#endif
+#ifndef SERRE_POOL_LARGE
+#define SERRE_POOL_LARGE 0 ///< 64-byte blocks
+#endif
+
+constexpr uint8_t POOL_COUNT = 3; ///< Size classes: 16, 32 and 64 bytes.
+
+/**
+ * @brief Allocates from the size-class pools that back `operator new`.
+ *
+ * The smallest class that fits is tried first, then the larger ones: at
+ * most POOL_COUNT O(1) attempts, no search through a heap.
+ *
+ * @param size Bytes requested.
+ * @return Block, nullptr if no pool can serve the request.
+ */
+void *poolAllocate(size_t size);
+
+/**
+ * @brief Gives a block back to its pool.
+ * @param pointer Block from poolAllocate(), nullptr is ignored.
+ * @return False if the pointer belongs to no pool.
+ */
+bool poolRelease(void *pointer);
+
+/**
+ * @brief Gets the usage of a size-class pool.
+ * @param index Pool index, smallest blocks first.
+ * @return Pool usage, all zero for an invalid index.
+ */
+PoolStats poolStats(uint8_t index);
+
+/**
+ * @brief Formats the usage of a pool, without line ending:
+ * "pool 16 used=1 peak=3 max=4 fail=0".
+ * @param stats Pool usage.
+ * @param[out] buffer Destination, always NUL-terminated.
+ * @param size Size of the buffer.
+ * @return Length of the text, truncated to size - 1.
+ */
+size_t poolFormat(const PoolStats *stats, char *buffer, size_t size);
+
+} // namespace sys
+
+#endif // POOL_HEAP_HH
@@ -0,0 +1,71 @@
+#include "../inc/profile.hh"
+
+#include "../../text/inc/line_writer.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint8_t REGION_COUNT = static_cast<uint8_t>(ProfileRegion::COUNT);
+
+const char *const regionNames[] = {"MAIN_LOOP", "ADC_POLL", "TEMP_MATH",
+                                   "SOIL_MATH", "UI_RENDER"};
+
+static_assert(sizeof(regionNames) / sizeof(regionNames[0]) == REGION_COUNT,
+              "One name per profile region");
+
+ProfileStats s_profile[REGION_COUNT];
+
+} // namespace
+
+void profileRecord(ProfileRegion region, uint32_t cycles) {
+    uint8_t index = static_cast<uint8_t>(region);
+    if (index >= REGION_COUNT) {
+        return;
+    }
+    ProfileStats &stats = s_profile[index];
+    if ((stats.count == 0) || (cycles < stats.minCycles)) {
+        stats.minCycles = cycles;
+    }
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+    stats.totalCycles += cycles;
+    stats.count++;
+}
+
+const ProfileStats &profileStats(ProfileRegion region) {
+    uint8_t index = static_cast<uint8_t>(region);
+    return s_profile[(index < REGION_COUNT) ? index : 0];
+}
+
+void profileReset() {
+    for (uint8_t i = 0; i < REGION_COUNT; i++) {
+        s_profile[i] = ProfileStats();
+    }
+}
+
+const char *profileRegionName(ProfileRegion region) {
+    uint8_t index = static_cast<uint8_t>(region);
+    return (index < REGION_COUNT) ? regionNames[index] : "?";
+}
+
+size_t profileFormat(ProfileRegion region, const ProfileStats *stats,
+                     char *buffer, size_t size) {
+    LineWriter out(buffer, size);
+    out.text("prof ");
+    out.text(profileRegionName(region));
+    out.text(" n=");
+    out.number(stats->count);
+    if (stats->count > 0) {
+        out.text(" min=");
+        out.number(stats->minCycles);
+        out.text(" mean=");
+        out.number(static_cast<uint32_t>(stats->totalCycles / stats->count));
+        out.text(" max=");
+        out.number(stats->maxCycles);
+    }
+    return out.length();
+}
+
+} // namespace sys
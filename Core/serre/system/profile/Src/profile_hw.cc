@@ -0,0 +1,18 @@
+#include "../inc/profile.hh"
+
+namespace sys {
+
+void profileStart() {
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    // Do not count the time spent halted at a breakpoint
+    __HAL_RCC_DBGMCU_CLK_ENABLE();
+    __HAL_DBGMCU_FREEZE_TIM2();
+
+    PROFILE_TIMER->CR1 = 0;
+    PROFILE_TIMER->PSC = 0;
+    PROFILE_TIMER->ARR = 0xFFFFFFFFU;
+    PROFILE_TIMER->EGR = TIM_EGR_UG; // Loads the prescaler
+    PROFILE_TIMER->CR1 = TIM_CR1_CEN;
+}
+
+} // namespace sys
@@ -0,0 +1,130 @@
+#ifndef PROFILE_HH
+#define PROFILE_HH
+
+// Includes
+#include "../../../../Inc/main.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Region profiling switch: on in debug builds, compiled out when
+ * NDEBUG is defined (release).
+ */
+#ifdef NDEBUG
+#define SERRE_PROFILING 0
+#else
+#define SERRE_PROFILING 1
+#endif
+
+namespace sys {
+
+/**
+ * @brief Timer counting core cycles while profiling: 32-bit TIM2, no
+ * prescaler, clocked by HCLK (APB prescaler 1).
+ */
+#define PROFILE_TIMER TIM2
+
+/**
+ * @brief Code regions timed by the SERRE_PROFILE_* probes.
+ */
+enum class ProfileRegion : uint8_t {
+    MAIN_LOOP = 0, ///< One main_serre() pass, without the sleep
+    ADC_POLL,      ///< HAL_ADC_PollForConversion()
+    TEMP_MATH,     ///< TempSensor::processData()
+    SOIL_MATH,     ///< SoilHumSensor::processData()
+    UI_RENDER,     ///< Menu rendering
+    COUNT
+};
+
+/**
+ * @brief Timing of a region.
+ *
+ * @struct ProfileStats
+ * @var uint32_t count
+ *      Number of passes.
+ * @var uint32_t minCycles
+ *      Shortest pass.
+ * @var uint32_t maxCycles
+ *      Longest pass.
+ * @var uint64_t totalCycles
+ *      Sum of the passes, for the mean.
+ */
+typedef struct {
+    uint32_t count;       ///< Number of passes
+    uint32_t minCycles;   ///< Shortest pass
+    uint32_t maxCycles;   ///< Longest pass
+    uint64_t totalCycles; ///< Sum of the passes
+} ProfileStats;
+
+/**
+ * @brief Reads the profiling timer.
+ * @return Free-running cycle count, wraps every 2^32 cycles.
+ */
+inline uint32_t profileNow() {
+    return PROFILE_TIMER->CNT;
+}
+
+/**
+ * @brief Adds a pass to a region. Main context only, not reentrant.
+ * @param region Region timed.
+ * @param cycles Duration of the pass.
+ */
+void profileRecord(ProfileRegion region, uint32_t cycles);
+
+/**
+ * @brief Gets the timing of a region.
+ * @param region Region.
+ * @return Statistics since boot or the last profileReset().
+ */
+const ProfileStats &profileStats(ProfileRegion region);
+
+/**
+ * @brief Clears the statistics of every region.
+ */
+void profileReset();
+
+/**
+ * @brief Gets the name of a region.
+ * @param region Region.
+ * @return Name printed in the report.
+ */
+const char *profileRegionName(ProfileRegion region);
+
+/**
+ * @brief Formats one report line, without line ending:
+ * "prof ADC_POLL n=12 min=80 mean=95 max=240".
+ * @param region Region.
+ * @param stats Statistics of the region.
+ * @param[out] buffer Destination, always NUL-terminated.
+ * @param size Size of the buffer.
+ * @return Length of the text, truncated to size - 1.
+ */
+size_t profileFormat(ProfileRegion region, const ProfileStats *stats,
+                     char *buffer, size_t size);
+
+/**
+ * @brief Starts the profiling timer.
+ */
+void profileStart();
+
+} // namespace sys
+
+#if SERRE_PROFILING
+/**
+ * @brief Opens a region: one timer read into a local variable.
+ */
+#define SERRE_PROFILE_BEGIN(region)                                            \
+    const uint32_t serreProfile_##region = sys::profileNow()
+/**
+ * @brief Closes a region opened in the same scope and records the pass.
+ */
+#define SERRE_PROFILE_END(region)                                              \
+    sys::profileRecord(sys::ProfileRegion::region,                             \
+                       sys::profileNow() - serreProfile_##region)
+#else
+#define SERRE_PROFILE_BEGIN(region) ((void)0)
+#define SERRE_PROFILE_END(region) ((void)0)
+#endif
+
+#endif // PROFILE_HH
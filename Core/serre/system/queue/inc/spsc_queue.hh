@@ -0,0 +1,86 @@
+#ifndef SPSC_QUEUE_HH
+#define SPSC_QUEUE_HH
+
+// Includes
+#include <atomic>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @class SpscQueue
+ * @brief Lock-free single-producer single-consumer ring buffer.
+ *
+ * Meant for passing events from one interrupt context to the main loop (or
+ * the other way round) without masking interrupts. Only the producer calls
+ * push() and only the consumer calls pop(). One slot is kept free to tell a
+ * full queue from an empty one, so the capacity is N - 1 items.
+ *
+ * @tparam T Trivially copyable item type.
+ * @tparam N Number of slots, a power of two between 2 and 128.
+ */
+template <typename T, uint8_t N> class SpscQueue {
+    static_assert((N >= 2) && (N <= 128) && ((N & (N - 1)) == 0),
+                  "SpscQueue size must be a power of two in [2, 128]");
+
+  public:
+    /**
+     * @brief Appends an item (producer side).
+     * @param item Item to copy into the queue.
+     * @return False if the queue is full and the item was dropped.
+     */
+    bool push(const T &item) {
+        uint8_t head = this->m_head.load(std::memory_order_relaxed);
+        uint8_t next = static_cast<uint8_t>((head + 1) & (N - 1));
+        if (next == this->m_tail.load(std::memory_order_acquire)) {
+            this->m_dropped++;
+            return false;
+        }
+        this->m_items[head] = item;
+        this->m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item (consumer side).
+     * @param[out] outItem Pointer to store the item.
+     * @return False if the queue is empty.
+     */
+    bool pop(T *outItem) {
+        uint8_t tail = this->m_tail.load(std::memory_order_relaxed);
+        if (tail == this->m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        *outItem = this->m_items[tail];
+        this->m_tail.store(static_cast<uint8_t>((tail + 1) & (N - 1)),
+                           std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Checks if the queue holds no item.
+     * @return True if empty.
+     */
+    bool isEmpty() const {
+        return this->m_head.load(std::memory_order_acquire) ==
+               this->m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Gets the number of items dropped because the queue was full.
+     * @return Dropped item count, updated by the producer only.
+     */
+    uint32_t dropped() const {
+        return this->m_dropped;
+    }
+
+  private:
+    T m_items[N];                    ///< Item storage.
+    std::atomic<uint8_t> m_head{0};  ///< Next slot to write (producer).
+    std::atomic<uint8_t> m_tail{0};  ///< Next slot to read (consumer).
+    volatile uint32_t m_dropped = 0; ///< Items rejected on a full queue.
+};
+
+} // namespace sys
+
+#endif // SPSC_QUEUE_HH
@@ -0,0 +1,15 @@
+#ifndef RAMFUNC_HH
+#define RAMFUNC_HH
+
+/**
+ * @brief Places a function in the `.ramfunc` section.
+ *
+ * The startup code copies the section from flash to RAM before main(), so
+ * the function runs without flash wait states or instruction cache misses:
+ * its timing no longer depends on the clock profile or on what ran before.
+ * Reserve it for short interrupt paths and inner loops, RAM is scarce.
+ * Calls to flash functions still pay the flash timing.
+ */
+#define SERRE_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+
+#endif // RAMFUNC_HH
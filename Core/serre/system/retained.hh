@@ -0,0 +1,14 @@
+#ifndef RETAINED_HH
+#define RETAINED_HH
+
+/**
+ * @brief Places a variable in the `.noinit` RAM section.
+ *
+ * The section is declared NOLOAD in the linker script and is skipped by the
+ * startup code, so its content survives a watchdog or software reset. It is
+ * garbage after a power-on reset: every retained structure must carry its own
+ * validity marker.
+ */
+#define SERRE_NOINIT __attribute__((section(".noinit")))
+
+#endif // RETAINED_HH
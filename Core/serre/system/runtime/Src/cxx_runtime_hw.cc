@@ -0,0 +1,23 @@
+#include "../../../../Inc/main.h"
+
+// Bare-metal C++ runtime hooks. main() never returns, so nothing is ever
+// destroyed: the destructors of static objects are not registered, which
+// keeps newlib's exit handler table and its code out of the image.
+
+extern "C" int atexit(void (*function)(void)) {
+    (void)function;
+    return 0;
+}
+
+extern "C" int __cxa_atexit(void (*destructor)(void *), void *object,
+                            void *dso) {
+    (void)destructor;
+    (void)object;
+    (void)dso;
+    return 0;
+}
+
+// A pure virtual call is a bug: trap it instead of linking std::terminate
+extern "C" void __cxa_pure_virtual(void) {
+    Error_Handler();
+}
@@ -0,0 +1,54 @@
+#include "../inc/scheduler.hh"
+
+namespace sys {
+
+int8_t Scheduler::addTask(TaskFunction function, void *context,
+                          uint32_t periodMs, uint32_t nowMs) {
+    if ((function == nullptr) || (this->m_count >= MAX_TASKS)) {
+        return INVALID_TASK;
+    }
+    Task &task = this->m_tasks[this->m_count];
+    task.function = function;
+    task.context = context;
+    task.periodMs = periodMs;
+    // Periodic tasks are due right away
+    task.lastRunMs = nowMs - periodMs;
+    this->m_pending[this->m_count] = false;
+    return static_cast<int8_t>(this->m_count++);
+}
+
+void Scheduler::signal(int8_t taskId) {
+    if ((taskId < 0) || (taskId >= static_cast<int8_t>(MAX_TASKS))) {
+        return;
+    }
+    this->m_pending[taskId] = true;
+}
+
+uint8_t Scheduler::run(uint32_t nowMs) {
+    uint8_t ran = 0;
+    for (uint8_t i = 0; i < this->m_count; i++) {
+        Task &task = this->m_tasks[i];
+        bool due = (task.periodMs != 0) &&
+                   ((nowMs - task.lastRunMs) >= task.periodMs);
+        // Clear before running so that a signal raised meanwhile is kept
+        bool signaled = this->m_pending[i];
+        if (signaled) {
+            this->m_pending[i] = false;
+        }
+        if (!due && !signaled) {
+            continue;
+        }
+        if (due) {
+            // Keep the cadence, but do not try to catch up missed periods
+            task.lastRunMs += task.periodMs;
+            if ((nowMs - task.lastRunMs) >= task.periodMs) {
+                task.lastRunMs = nowMs;
+            }
+        }
+        task.function(task.context, nowMs);
+        ran++;
+    }
+    return ran;
+}
+
+} // namespace sys
@@ -0,0 +1,72 @@
+#ifndef SCHEDULER_HH
+#define SCHEDULER_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief Task entry point.
+ * @param context Pointer given at registration.
+ * @param nowMs Current tick in milliseconds.
+ */
+typedef void (*TaskFunction)(void *context, uint32_t nowMs);
+
+constexpr int8_t INVALID_TASK = -1; ///< Returned when the table is full.
+
+/**
+ * @class Scheduler
+ * @brief Cooperative run-to-completion scheduler with a static task table.
+ *
+ * A task runs when its period has elapsed or when it has been signaled,
+ * typically from an interrupt that produced work for it. Tasks registered
+ * with a zero period only run when signaled.
+ */
+class Scheduler {
+  public:
+    /**
+     * @brief Registers a task.
+     * @param function Task entry point.
+     * @param context Pointer passed back to the task.
+     * @param periodMs Run period in milliseconds, 0 for signal-only tasks.
+     * @param nowMs Current tick. Periodic tasks first run at this tick.
+     * @return Task identifier, INVALID_TASK if the table is full.
+     */
+    int8_t addTask(TaskFunction function, void *context, uint32_t periodMs,
+                   uint32_t nowMs);
+
+    /**
+     * @brief Requests a task to run at the next pass. Interrupt-safe.
+     * @param taskId Task identifier returned by addTask().
+     */
+    void signal(int8_t taskId);
+
+    /**
+     * @brief Runs every due or signaled task once, in registration order.
+     * @param nowMs Current tick in milliseconds.
+     * @return Number of tasks that ran.
+     */
+    uint8_t run(uint32_t nowMs);
+
+  private:
+    static constexpr uint8_t MAX_TASKS = 8;
+
+    /**
+     * @brief Task table entry.
+     */
+    struct Task {
+        TaskFunction function; ///< Entry point
+        void *context;         ///< Pointer passed back to the task
+        uint32_t periodMs;     ///< Run period, 0 for signal-only
+        uint32_t lastRunMs;    ///< Tick of the last periodic run
+    };
+
+    Task m_tasks[MAX_TASKS] = {};            ///< Task table.
+    volatile bool m_pending[MAX_TASKS] = {}; ///< Signaled tasks.
+    uint8_t m_count = 0;                     ///< Registered tasks.
+};
+
+} // namespace sys
+
+#endif // SCHEDULER_HH
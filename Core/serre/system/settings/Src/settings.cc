@@ -0,0 +1,88 @@
+#include "../inc/settings.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint16_t SETTINGS_MAGIC = 0x5345; // "SE"
+constexpr uint16_t ERASED_HALFWORD = 0xFFFF;
+
+uint16_t crc16(const uint8_t *data, uint16_t length) {
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (crc & 0x8000) {
+                crc = static_cast<uint16_t>((crc << 1) ^ 0x1021);
+            } else {
+                crc = static_cast<uint16_t>(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+uint16_t settingsCrc(const Settings *settings) {
+    return crc16(reinterpret_cast<const uint8_t *>(settings),
+                 sizeof(Settings) - sizeof(settings->crc));
+}
+
+bool isErased(const Settings *settings) {
+    const uint16_t *halfwords = reinterpret_cast<const uint16_t *>(settings);
+    for (uint8_t i = 0; i < sizeof(Settings) / sizeof(uint16_t); i++) {
+        if (halfwords[i] != ERASED_HALFWORD) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void settingsDefaults(Settings *settings) {
+    // Same limits as the sensor drivers use before any calibration
+    settings->magic = 0;
+    settings->sequence = 0;
+    settings->tempMinDeci = -400;
+    settings->tempMaxDeci = 850;
+    settings->soilDry = 4095;
+    settings->soilWet = 0;
+    settings->reserved = 0;
+    settings->crc = 0;
+}
+
+void settingsSeal(Settings *settings) {
+    settings->magic = SETTINGS_MAGIC;
+    settings->reserved = 0;
+    settings->crc = settingsCrc(settings);
+}
+
+bool settingsIsValid(const Settings *settings) {
+    return (settings->magic == SETTINGS_MAGIC) &&
+           (settings->crc == settingsCrc(settings));
+}
+
+int16_t settingsFindLatest(const Settings *slots, uint16_t count) {
+    int16_t latest = -1;
+    for (uint16_t i = 0; i < count; i++) {
+        if (isErased(&slots[i])) {
+            break;
+        }
+        // A torn write leaves an invalid slot: keep the previous record
+        if (settingsIsValid(&slots[i])) {
+            latest = static_cast<int16_t>(i);
+        }
+    }
+    return latest;
+}
+
+int16_t settingsFindFree(const Settings *slots, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (isErased(&slots[i])) {
+            return static_cast<int16_t>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace sys
@@ -0,0 +1,80 @@
+#include "../inc/settings.hh"
+
+#include "../../../../Inc/main.h"
+
+#include <string.h>
+
+namespace sys {
+
+namespace {
+
+// Last flash page, removed from the program area by the linker script
+constexpr uint32_t SETTINGS_PAGE = 31;
+constexpr uint32_t SETTINGS_ADDRESS =
+    FLASH_BASE + (SETTINGS_PAGE * FLASH_PAGE_SIZE);
+constexpr uint16_t SETTINGS_SLOTS = FLASH_PAGE_SIZE / sizeof(Settings);
+
+const Settings *settingsSlots() {
+    return reinterpret_cast<const Settings *>(SETTINGS_ADDRESS);
+}
+
+HAL_StatusTypeDef erasePage() {
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = FLASH_BANK_1;
+    erase.Page = SETTINGS_PAGE;
+    erase.NbPages = 1;
+    uint32_t pageError = 0;
+    return HAL_FLASHEx_Erase(&erase, &pageError);
+}
+
+HAL_StatusTypeDef programRecord(uint16_t slot, const Settings *settings) {
+    uint32_t address = SETTINGS_ADDRESS + (slot * sizeof(Settings));
+    uint64_t words[sizeof(Settings) / sizeof(uint64_t)];
+    memcpy(words, settings, sizeof(words));
+    for (uint8_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        HAL_StatusTypeDef status =
+            HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD,
+                              address + (i * sizeof(uint64_t)), words[i]);
+        if (status != HAL_OK) {
+            return status;
+        }
+    }
+    return HAL_OK;
+}
+
+} // namespace
+
+void settingsLoad(Settings *settings) {
+    int16_t latest = settingsFindLatest(settingsSlots(), SETTINGS_SLOTS);
+    if (latest < 0) {
+        settingsDefaults(settings);
+        return;
+    }
+    memcpy(settings, &settingsSlots()[latest], sizeof(Settings));
+}
+
+bool settingsSave(Settings *settings) {
+    settings->sequence++;
+    settingsSeal(settings);
+
+    if (HAL_FLASH_Unlock() != HAL_OK) {
+        return false;
+    }
+    HAL_StatusTypeDef status = HAL_OK;
+    int16_t slot = settingsFindFree(settingsSlots(), SETTINGS_SLOTS);
+    if (slot < 0) {
+        // Page full: erase it, the record in RAM is the only copy meanwhile
+        status = erasePage();
+        slot = 0;
+    }
+    if (status == HAL_OK) {
+        status = programRecord(static_cast<uint16_t>(slot), settings);
+    }
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) &&
+           (memcmp(&settingsSlots()[slot], settings, sizeof(Settings)) == 0);
+}
+
+} // namespace sys
@@ -0,0 +1,100 @@
+#ifndef SETTINGS_HH
+#define SETTINGS_HH
+
+// Includes
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @brief User settings persisted in flash.
+ *
+ * The record is 16 bytes so that it is written as two flash double words.
+ * Temperatures are stored in tenths of a degree Celsius.
+ *
+ * @struct Settings
+ * @var uint16_t magic
+ *      Marks a written record.
+ * @var uint16_t sequence
+ *      Incremented by each save.
+ * @var int16_t tempMinDeci
+ *      Lowest valid temperature, in 0.1 °C.
+ * @var int16_t tempMaxDeci
+ *      Highest valid temperature, in 0.1 °C.
+ * @var uint16_t soilDry
+ *      Raw ADC value of dry soil.
+ * @var uint16_t soilWet
+ *      Raw ADC value of wet soil.
+ * @var uint16_t reserved
+ *      Keeps the record size, written as zero.
+ * @var uint16_t crc
+ *      CRC-16/CCITT of the previous fields.
+ */
+typedef struct {
+    uint16_t magic;      ///< Marks a written record
+    uint16_t sequence;   ///< Save counter
+    int16_t tempMinDeci; ///< Lowest valid temperature (0.1 °C)
+    int16_t tempMaxDeci; ///< Highest valid temperature (0.1 °C)
+    uint16_t soilDry;    ///< Raw ADC value of dry soil
+    uint16_t soilWet;    ///< Raw ADC value of wet soil
+    uint16_t reserved;   ///< Written as zero
+    uint16_t crc;        ///< CRC-16/CCITT of the previous fields
+} Settings;
+
+static_assert(sizeof(Settings) == 16, "Settings must be two double words");
+
+/**
+ * @brief Fills settings with the factory defaults.
+ * @param[out] settings Settings to fill.
+ */
+void settingsDefaults(Settings *settings);
+
+/**
+ * @brief Stamps the magic and CRC of a record about to be written.
+ * @param settings Record to seal.
+ */
+void settingsSeal(Settings *settings);
+
+/**
+ * @brief Checks the magic and CRC of a record.
+ * @param settings Record to check.
+ * @return True if the record was written completely.
+ */
+bool settingsIsValid(const Settings *settings);
+
+/**
+ * @brief Finds the most recent record of a settings page.
+ *
+ * Records are appended to the page, so the latest is the last valid one
+ * before the first erased slot.
+ *
+ * @param slots Records of the page.
+ * @param count Number of slots.
+ * @return Index of the latest record, -1 if none is valid.
+ */
+int16_t settingsFindLatest(const Settings *slots, uint16_t count);
+
+/**
+ * @brief Finds the first erased slot of a settings page.
+ * @param slots Records of the page.
+ * @param count Number of slots.
+ * @return Index of the free slot, -1 if the page is full.
+ */
+int16_t settingsFindFree(const Settings *slots, uint16_t count);
+
+/**
+ * @brief Loads the settings from flash, or the defaults if none was saved.
+ * @param[out] settings Settings to fill.
+ */
+void settingsLoad(Settings *settings);
+
+/**
+ * @brief Appends the settings to flash, erasing the page when it is full.
+ * @param settings Settings to save. Its sequence and CRC are updated.
+ * @return True if the record was written and reads back valid.
+ */
+bool settingsSave(Settings *settings);
+
+} // namespace sys
+
+#endif // SETTINGS_HH
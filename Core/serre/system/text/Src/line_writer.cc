@@ -0,0 +1,62 @@
+#include "../inc/line_writer.hh"
+
+namespace sys {
+
+LineWriter::LineWriter(char *buffer, size_t size) {
+    this->m_buffer = buffer;
+    this->m_size = size;
+    if ((buffer != nullptr) && (size > 0)) {
+        buffer[0] = '\0';
+    }
+}
+
+void LineWriter::put(char c) {
+    if ((this->m_buffer == nullptr) || (this->m_length + 1 >= this->m_size)) {
+        return;
+    }
+    this->m_buffer[this->m_length++] = c;
+    this->m_buffer[this->m_length] = '\0';
+}
+
+void LineWriter::text(const char *str) {
+    while (*str != '\0') {
+        this->put(*str++);
+    }
+}
+
+void LineWriter::number(uint32_t value) {
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) {
+        this->put(digits[--count]);
+    }
+}
+
+void LineWriter::hex(uint32_t value) {
+    static const char digits[] = "0123456789abcdef";
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        this->put(digits[(value >> shift) & 0xF]);
+    }
+}
+
+void LineWriter::fixed(float value) {
+    if (value < 0.0f) {
+        this->put('-');
+        value = -value;
+    }
+    uint32_t hundredths = static_cast<uint32_t>(value * 100.0f + 0.5f);
+    this->number(hundredths / 100);
+    this->put('.');
+    this->put(static_cast<char>('0' + (hundredths / 10) % 10));
+    this->put(static_cast<char>('0' + hundredths % 10));
+}
+
+size_t LineWriter::length() const {
+    return this->m_length;
+}
+
+} // namespace sys
@@ -0,0 +1,71 @@
+#ifndef LINE_WRITER_HH
+#define LINE_WRITER_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sys {
+
+/**
+ * @class LineWriter
+ * @brief Appends text and numbers to a bounded buffer.
+ *
+ * Shared by the console report formatters, which avoid the newlib stdio.
+ * The buffer stays NUL-terminated after every write and the text is
+ * truncated to size - 1 characters.
+ */
+class LineWriter {
+  public:
+    /**
+     * @brief Constructor for LineWriter, empties the buffer.
+     * @param buffer Destination, nullptr to write nothing.
+     * @param size Size of the buffer.
+     */
+    LineWriter(char *buffer, size_t size);
+
+    /**
+     * @brief Appends a character.
+     * @param c Character.
+     */
+    void put(char c);
+
+    /**
+     * @brief Appends a string.
+     * @param str NUL-terminated string.
+     */
+    void text(const char *str);
+
+    /**
+     * @brief Appends an unsigned decimal number.
+     * @param value Number.
+     */
+    void number(uint32_t value);
+
+    /**
+     * @brief Appends a number as eight lowercase hex digits.
+     * @param value Number.
+     */
+    void hex(uint32_t value);
+
+    /**
+     * @brief Appends a number with two decimals, rounded, e.g. "-3.05".
+     * @param value Number, below 4e7 in magnitude.
+     */
+    void fixed(float value);
+
+    /**
+     * @brief Gets the length of the text.
+     * @return Characters written, without the terminator.
+     */
+    size_t length() const;
+
+  private:
+    char *m_buffer = nullptr; ///< Destination.
+    size_t m_size = 0;        ///< Size of the destination.
+    size_t m_length = 0;      ///< Characters written.
+};
+
+} // namespace sys
+
+#endif // LINE_WRITER_HH
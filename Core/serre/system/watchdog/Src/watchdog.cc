@@ -0,0 +1,131 @@
+#include "../inc/watchdog.hh"
+
+#include "../../retained.hh"
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t RESET_RECORD_MAGIC = 0x57444F47UL; // "WDOG"
+
+// RCC CSR reset flag positions (RM0444, RCC_CSR)
+constexpr uint32_t CSR_OBLRSTF = 1UL << 25;
+constexpr uint32_t CSR_PINRSTF = 1UL << 26;
+constexpr uint32_t CSR_PWRRSTF = 1UL << 27;
+constexpr uint32_t CSR_SFTRSTF = 1UL << 28;
+constexpr uint32_t CSR_IWDGRSTF = 1UL << 29;
+constexpr uint32_t CSR_WWDGRSTF = 1UL << 30;
+constexpr uint32_t CSR_LPWRRSTF = 1UL << 31;
+
+constexpr uint32_t LSI_FREQUENCY_KHZ = 32;
+constexpr uint32_t IWDG_MAX_PRESCALER = 6; // divider 256
+constexpr uint32_t IWDG_MAX_RELOAD = 0x0FFF;
+
+ResetRecord s_resetRecord SERRE_NOINIT;
+
+} // namespace
+
+uint32_t decodeResetCause(uint32_t csr) {
+    uint32_t cause = RESET_CAUSE_NONE;
+    if (csr & CSR_OBLRSTF) {
+        cause |= RESET_CAUSE_OPTION_BYTE;
+    }
+    if (csr & CSR_PINRSTF) {
+        cause |= RESET_CAUSE_PIN;
+    }
+    if (csr & CSR_PWRRSTF) {
+        cause |= RESET_CAUSE_POWER;
+    }
+    if (csr & CSR_SFTRSTF) {
+        cause |= RESET_CAUSE_SOFTWARE;
+    }
+    if (csr & CSR_IWDGRSTF) {
+        cause |= RESET_CAUSE_WATCHDOG;
+    }
+    if (csr & CSR_WWDGRSTF) {
+        cause |= RESET_CAUSE_WINDOW_WATCHDOG;
+    }
+    if (csr & CSR_LPWRRSTF) {
+        cause |= RESET_CAUSE_LOW_POWER;
+    }
+    return cause;
+}
+
+void updateResetRecord(ResetRecord *record, uint32_t cause) {
+    if (record == nullptr) {
+        return;
+    }
+    if ((record->magic != RESET_RECORD_MAGIC) || (cause & RESET_CAUSE_POWER)) {
+        record->magic = RESET_RECORD_MAGIC;
+        record->bootCount = 0;
+        record->watchdogResets = 0;
+    }
+    record->bootCount++;
+    if (cause & RESET_CAUSE_WATCHDOG) {
+        record->watchdogResets++;
+    }
+    record->lastCause = cause;
+}
+
+IwdgConfig computeIwdgConfig(uint32_t timeoutMs) {
+    IwdgConfig config = {IWDG_MAX_PRESCALER, IWDG_MAX_RELOAD};
+    for (uint32_t prescaler = 0; prescaler <= IWDG_MAX_PRESCALER;
+         prescaler++) {
+        // One counter tick lasts (4 << prescaler) / 32 kHz
+        uint32_t divider = 4UL << prescaler;
+        uint32_t ticks = (timeoutMs * LSI_FREQUENCY_KHZ) / divider;
+        if (ticks <= IWDG_MAX_RELOAD + 1) {
+            config.prescaler = prescaler;
+            config.reload = ticks > 0 ? ticks - 1 : 0;
+            return config;
+        }
+    }
+    return config;
+}
+
+void Watchdog::registerTask(WatchdogTask task, uint32_t deadlineMs,
+                            uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(task);
+    if (index >= TASK_COUNT) {
+        return;
+    }
+    this->m_deadlineMs[index] = deadlineMs;
+    this->m_lastCheckIn[index] = nowMs;
+    this->m_registered |= static_cast<uint8_t>(1U << index);
+}
+
+void Watchdog::checkIn(WatchdogTask task, uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(task);
+    if (index >= TASK_COUNT) {
+        return;
+    }
+    this->m_lastCheckIn[index] = nowMs;
+}
+
+uint8_t Watchdog::lateTasks(uint32_t nowMs) const {
+    uint8_t late = 0;
+    for (uint8_t i = 0; i < TASK_COUNT; i++) {
+        if ((this->m_registered & (1U << i)) == 0) {
+            continue;
+        }
+        // Unsigned difference stays correct across the 49-day tick wrap
+        if ((nowMs - this->m_lastCheckIn[i]) > this->m_deadlineMs[i]) {
+            late |= static_cast<uint8_t>(1U << i);
+        }
+    }
+    return late;
+}
+
+bool Watchdog::isHealthy(uint32_t nowMs) const {
+    return this->lateTasks(nowMs) == 0;
+}
+
+void recordBoot(uint32_t csr) {
+    updateResetRecord(&s_resetRecord, decodeResetCause(csr));
+}
+
+const ResetRecord &resetRecord() {
+    return s_resetRecord;
+}
+
+} // namespace sys
@@ -0,0 +1,43 @@
+#include "../inc/watchdog.hh"
+
+#include "../../../../Inc/main.h"
+
+namespace sys {
+
+namespace {
+
+// IWDG key register values (RM0444, IWDG_KR)
+constexpr uint32_t IWDG_KEY_RELOAD = 0xAAAA;
+constexpr uint32_t IWDG_KEY_WRITE_ACCESS = 0x5555;
+constexpr uint32_t IWDG_KEY_START = 0xCCCC;
+
+} // namespace
+
+uint32_t watchdogReadResetFlags() {
+    uint32_t csr = RCC->CSR;
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+    return csr;
+}
+
+void watchdogStart(uint32_t timeoutMs) {
+    IwdgConfig config = computeIwdgConfig(timeoutMs);
+
+    // Keep the watchdog quiet while the core is halted by the debugger
+    __HAL_RCC_DBGMCU_CLK_ENABLE();
+    __HAL_DBGMCU_FREEZE_IWDG();
+
+    IWDG->KR = IWDG_KEY_START;
+    IWDG->KR = IWDG_KEY_WRITE_ACCESS;
+    IWDG->PR = config.prescaler;
+    IWDG->RLR = config.reload;
+    while (IWDG->SR != 0U) {
+        // Wait for the prescaler and reload values to reach the LSI domain
+    }
+    IWDG->KR = IWDG_KEY_RELOAD;
+}
+
+void watchdogRefresh() {
+    IWDG->KR = IWDG_KEY_RELOAD;
+}
+
+} // namespace sys
@@ -0,0 +1,169 @@
+#ifndef WATCHDOG_HH
+#define WATCHDOG_HH
+
+// Includes
+#include <stdint.h>
+
+/**
+ * @namespace sys
+ * @brief Contains system services (supervision, fault handling, clocks).
+ */
+namespace sys {
+
+/**
+ * @brief Periodic tasks supervised by the watchdog.
+ */
+enum class WatchdogTask : uint8_t {
+    ACQUISITION = 0, ///< Sensor acquisition
+    CONTROL,         ///< Actuator control
+    COMMS,           ///< Serial communication
+    COUNT
+};
+
+/**
+ * @brief Reset cause bits, decoded from the RCC CSR register.
+ */
+enum ResetCause : uint32_t {
+    RESET_CAUSE_NONE = 0,
+    RESET_CAUSE_OPTION_BYTE = 1U << 0,     ///< Option byte loader reset
+    RESET_CAUSE_PIN = 1U << 1,             ///< NRST pin reset
+    RESET_CAUSE_POWER = 1U << 2,           ///< BOR or POR/PDR reset
+    RESET_CAUSE_SOFTWARE = 1U << 3,        ///< NVIC_SystemReset()
+    RESET_CAUSE_WATCHDOG = 1U << 4,        ///< Independent watchdog reset
+    RESET_CAUSE_WINDOW_WATCHDOG = 1U << 5, ///< Window watchdog reset
+    RESET_CAUSE_LOW_POWER = 1U << 6        ///< Illegal low-power mode entry
+};
+
+/**
+ * @brief Reset bookkeeping kept in `.noinit` RAM across resets.
+ *
+ * @struct ResetRecord
+ * @var uint32_t magic
+ *      Validity marker, anything else means the RAM content is garbage.
+ * @var uint32_t bootCount
+ *      Number of boots since the last power-on.
+ * @var uint32_t watchdogResets
+ *      Number of independent watchdog resets since the last power-on.
+ * @var uint32_t lastCause
+ *      ResetCause bits of the latest boot.
+ */
+typedef struct {
+    uint32_t magic;          ///< Validity marker
+    uint32_t bootCount;      ///< Boots since the last power-on
+    uint32_t watchdogResets; ///< IWDG resets since the last power-on
+    uint32_t lastCause;      ///< ResetCause bits of the latest boot
+} ResetRecord;
+
+/**
+ * @brief IWDG prescaler and reload register values.
+ */
+typedef struct {
+    uint32_t prescaler; ///< PR register value (divider = 4 << prescaler)
+    uint32_t reload;    ///< RLR register value (12 bits)
+} IwdgConfig;
+
+/**
+ * @brief Translates RCC CSR reset flags into ResetCause bits.
+ * @param csr Raw RCC CSR register value.
+ * @return Combination of ResetCause bits.
+ */
+uint32_t decodeResetCause(uint32_t csr);
+
+/**
+ * @brief Updates the retained reset record with the cause of this boot.
+ *
+ * The counters restart from zero when the record is invalid or when the
+ * boot follows a power-on reset.
+ * @param record Retained record to update.
+ * @param cause ResetCause bits of the current boot.
+ */
+void updateResetRecord(ResetRecord *record, uint32_t cause);
+
+/**
+ * @brief Computes the IWDG configuration for a timeout.
+ * @param timeoutMs Requested timeout in milliseconds, clamped to the
+ * hardware range (about 32 s at 32 kHz LSI).
+ * @return Prescaler and reload values.
+ */
+IwdgConfig computeIwdgConfig(uint32_t timeoutMs);
+
+/**
+ * @class Watchdog
+ * @brief Task liveness supervisor gating the independent watchdog refresh.
+ *
+ * Each registered task must check in within its own deadline. The hardware
+ * watchdog is only refreshed while every registered task is on time, so a
+ * hung task (or an interrupt-disabled spin) ends in an IWDG reset.
+ */
+class Watchdog {
+  public:
+    /**
+     * @brief Adds a task to the supervision set.
+     * @param task Task identifier.
+     * @param deadlineMs Maximum time allowed between two check-ins.
+     * @param nowMs Current tick, counted as the first check-in.
+     */
+    void registerTask(WatchdogTask task, uint32_t deadlineMs, uint32_t nowMs);
+
+    /**
+     * @brief Records that a task is alive.
+     * @param task Task identifier.
+     * @param nowMs Current tick in milliseconds.
+     */
+    void checkIn(WatchdogTask task, uint32_t nowMs);
+
+    /**
+     * @brief Gets the tasks that missed their deadline.
+     * @param nowMs Current tick in milliseconds.
+     * @return Bitmask of late tasks (bit n = WatchdogTask n).
+     */
+    uint8_t lateTasks(uint32_t nowMs) const;
+
+    /**
+     * @brief Checks if the hardware watchdog may be refreshed.
+     * @param nowMs Current tick in milliseconds.
+     * @return True if every registered task is within its deadline.
+     */
+    bool isHealthy(uint32_t nowMs) const;
+
+  private:
+    static constexpr uint8_t TASK_COUNT =
+        static_cast<uint8_t>(WatchdogTask::COUNT);
+
+    uint32_t m_deadlineMs[TASK_COUNT] = {0};  ///< Per-task deadline.
+    uint32_t m_lastCheckIn[TASK_COUNT] = {0}; ///< Per-task last check-in.
+    uint8_t m_registered = 0;                 ///< Registered task bitmask.
+};
+
+/**
+ * @brief Records the reset cause of this boot in retained RAM.
+ * @param csr Raw RCC CSR register value read at boot.
+ */
+void recordBoot(uint32_t csr);
+
+/**
+ * @brief Gets the retained reset record.
+ * @return Reference to the record updated by recordBoot().
+ */
+const ResetRecord &resetRecord();
+
+/**
+ * @brief Reads the RCC reset flags and clears them for the next boot.
+ * @return Raw RCC CSR register value.
+ */
+uint32_t watchdogReadResetFlags();
+
+/**
+ * @brief Starts the independent watchdog. It cannot be stopped afterwards.
+ * @param timeoutMs Timeout in milliseconds.
+ */
+void watchdogStart(uint32_t timeoutMs);
+
+/**
+ * @brief Reloads the independent watchdog counter.
+ */
+void watchdogRefresh();
+
+} // namespace sys
+
+#endif // WATCHDOG_HH
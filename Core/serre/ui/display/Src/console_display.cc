@@ -0,0 +1,56 @@
+#include "../inc/console_display.hh"
+
+#include <string.h>
+
+namespace ui {
+
+namespace {
+
+const char CLEAR_SCREEN[] = "\033[H\033[2J";
+
+} // namespace
+
+ConsoleDisplay::ConsoleDisplay(ConsoleWrite write) {
+    this->m_write = write;
+}
+
+uint8_t ConsoleDisplay::rows() const {
+    return ROWS;
+}
+
+uint8_t ConsoleDisplay::columns() const {
+    return COLUMNS;
+}
+
+void ConsoleDisplay::clear() {
+    memset(this->m_lines, 0, sizeof(this->m_lines));
+    memset(this->m_highlighted, 0, sizeof(this->m_highlighted));
+}
+
+void ConsoleDisplay::drawText(uint8_t row, const char *text,
+                              bool highlighted) {
+    if ((row >= ROWS) || (text == nullptr)) {
+        return;
+    }
+    strncpy(this->m_lines[row], text, COLUMNS);
+    this->m_lines[row][COLUMNS] = '\0';
+    this->m_highlighted[row] = highlighted;
+}
+
+void ConsoleDisplay::flush() {
+    if (this->m_write == nullptr) {
+        return;
+    }
+    this->m_write(CLEAR_SCREEN, sizeof(CLEAR_SCREEN) - 1);
+    for (uint8_t row = 0; row < ROWS; row++) {
+        this->m_write(this->m_highlighted[row] ? "> " : "  ", 2);
+        this->m_write(this->m_lines[row],
+                      static_cast<uint16_t>(strlen(this->m_lines[row])));
+        this->m_write("\r\n", 2);
+    }
+}
+
+ConsoleDisplay::~ConsoleDisplay() {
+}
+
+} // namespace ui
@@ -0,0 +1,8 @@
+#include "../inc/display.hh"
+
+namespace ui {
+
+Display::~Display() {
+}
+
+} // namespace ui
@@ -0,0 +1,230 @@
+#include "../inc/ssd1306_display.hh"
+
+#include <string.h>
+
+namespace ui {
+
+namespace {
+
+constexpr uint8_t CONTROL_COMMAND = 0x80; // Co = 1: one command byte follows
+constexpr uint8_t CONTROL_DATA = 0x40;    // Co = 0: data bytes until STOP
+
+// Sent once after reset, the panel stays off until the first frame is drawn
+const uint8_t initSequence[] = {
+    0x00,       // Command stream
+    0xAE,       // Display off
+    0xD5, 0x80, // Oscillator frequency, clock divide ratio 1
+    0xA8, 0x3F, // Multiplex ratio: 64 lines
+    0xD3, 0x00, // No display offset
+    0x40,       // Start line 0
+    0x8D, 0x14, // Charge pump on
+    0x20, 0x02, // Page addressing mode
+    0xA1,       // Column 0 on the left
+    0xC8,       // Page 0 at the top
+    0xDA, 0x12, // Alternative COM pin configuration
+    0x81, 0xCF, // Contrast
+    0xD9, 0xF1, // Pre-charge period
+    0xDB, 0x40, // VCOMH deselect level
+    0xA4,       // Display follows the RAM
+    0xA6,       // Normal, not inverted
+};
+
+const uint8_t powerOn[] = {0x00, 0xAF};
+
+} // namespace
+
+Ssd1306Display::Ssd1306Display(Ssd1306Config config) {
+    this->m_config = config;
+    this->m_transaction.address = config.address;
+    this->m_transaction.timeoutMs = config.timeoutMs;
+    this->m_transaction.result = bus::I2cResult::IDLE;
+    memset(this->m_text, ' ', sizeof(this->m_text));
+    memset(this->m_shown, ' ', sizeof(this->m_shown));
+}
+
+void Ssd1306Display::setCallback(bus::I2cCallback callback, void *context) {
+    this->m_transaction.callback = callback;
+    this->m_transaction.context = context;
+}
+
+void Ssd1306Display::update() {
+    if (this->isBusy()) {
+        return;
+    }
+
+    // Outcome of the previous transfer
+    bool ok = this->m_transaction.result == bus::I2cResult::OK;
+    switch (this->m_sent) {
+    case Sent::INIT:
+        this->m_initialized = ok;
+        break;
+    case Sent::PAGE:
+        if (!ok) {
+            this->m_stale |= static_cast<uint8_t>(1U << this->m_sentPage);
+        }
+        break;
+    case Sent::POWER_ON:
+        this->m_on = ok;
+        break;
+    default:
+        break;
+    }
+    this->m_sent = Sent::NOTHING;
+
+    if (!this->m_initialized) {
+        // The RAM content is unknown after a reset
+        this->m_stale = ALL_PAGES;
+        this->submit(Sent::INIT, initSequence, sizeof(initSequence));
+        return;
+    }
+    if (this->sendPage()) {
+        return;
+    }
+    if (!this->m_on) {
+        this->submit(Sent::POWER_ON, powerOn, sizeof(powerOn));
+    }
+}
+
+bool Ssd1306Display::isBusy() const {
+    return this->m_transaction.result == bus::I2cResult::PENDING;
+}
+
+bool Ssd1306Display::isReady() const {
+    return this->m_on;
+}
+
+uint32_t Ssd1306Display::bytesSent() const {
+    return this->m_bytesSent;
+}
+
+uint8_t Ssd1306Display::rows() const {
+    return PAGES;
+}
+
+uint8_t Ssd1306Display::columns() const {
+    return COLUMNS;
+}
+
+void Ssd1306Display::clear() {
+    memset(this->m_text, ' ', sizeof(this->m_text));
+    this->m_highlighted = 0;
+}
+
+void Ssd1306Display::drawText(uint8_t row, const char *text,
+                              bool highlighted) {
+    if ((row >= PAGES) || (text == nullptr)) {
+        return;
+    }
+    char *line = this->m_text[row];
+    uint8_t column = 0;
+    while ((column < COLUMNS) && (text[column] != '\0')) {
+        line[column] = text[column];
+        column++;
+    }
+    memset(&line[column], ' ', COLUMNS - column);
+
+    uint8_t bit = static_cast<uint8_t>(1U << row);
+    if (highlighted) {
+        this->m_highlighted |= bit;
+    } else {
+        this->m_highlighted &= static_cast<uint8_t>(~bit);
+    }
+}
+
+void Ssd1306Display::flush() {
+    this->update();
+}
+
+bool Ssd1306Display::sendPage() {
+    // A stale page or a highlight change needs the whole width
+    uint8_t full = this->m_stale |
+                   static_cast<uint8_t>(this->m_highlighted ^
+                                        this->m_shownHighlighted);
+    for (uint8_t page = 0; page < PAGES; page++) {
+        uint8_t bit = static_cast<uint8_t>(1U << page);
+        uint8_t start = 0;
+        uint8_t end = WIDTH;
+        if ((full & bit) == 0) {
+            const char *text = this->m_text[page];
+            const char *shown = this->m_shown[page];
+            uint8_t first = 0;
+            while ((first < COLUMNS) && (text[first] == shown[first])) {
+                first++;
+            }
+            if (first == COLUMNS) {
+                continue;
+            }
+            uint8_t last = COLUMNS - 1;
+            while (text[last] == shown[last]) {
+                last--;
+            }
+            start = static_cast<uint8_t>(first * CELL_WIDTH);
+            end = static_cast<uint8_t>((last + 1) * CELL_WIDTH);
+        }
+
+        memcpy(this->m_shown[page], this->m_text[page], COLUMNS);
+        this->m_shownHighlighted = static_cast<uint8_t>(
+            (this->m_shownHighlighted & ~bit) | (this->m_highlighted & bit));
+        this->m_stale &= static_cast<uint8_t>(~bit);
+        this->m_sentPage = page;
+
+        uint16_t length = this->renderBand(page, start, end);
+        if (!this->submit(Sent::PAGE, this->m_band, length)) {
+            // Queue full: redraw the page at the next update
+            this->m_stale |= bit;
+        }
+        return true;
+    }
+    return false;
+}
+
+uint16_t Ssd1306Display::renderBand(uint8_t page, uint8_t start,
+                                    uint8_t end) {
+    uint8_t *band = this->m_band;
+    band[0] = CONTROL_COMMAND;
+    band[1] = static_cast<uint8_t>(0xB0 | page); // Page start address
+    band[2] = CONTROL_COMMAND;
+    band[3] = static_cast<uint8_t>(start & 0x0F); // Column, low nibble
+    band[4] = CONTROL_COMMAND;
+    band[5] = static_cast<uint8_t>(0x10 | (start >> 4)); // High nibble
+    band[6] = CONTROL_DATA;
+
+    const char *text = this->m_shown[page];
+    uint8_t invert = (this->m_shownHighlighted & (1U << page)) ? 0xFF : 0x00;
+    uint8_t *out = &band[BAND_HEADER];
+    uint8_t cell = start / CELL_WIDTH;
+    uint8_t x = start % CELL_WIDTH;
+    for (uint8_t column = start; column < end; column++) {
+        uint8_t bits = 0;
+        if ((cell < COLUMNS) && (x < FONT_WIDTH)) {
+            bits = fontGlyph(text[cell])[x];
+        }
+        *out++ = static_cast<uint8_t>(bits ^ invert);
+        if (++x == CELL_WIDTH) {
+            x = 0;
+            cell++;
+        }
+    }
+    return static_cast<uint16_t>(BAND_HEADER + end - start);
+}
+
+bool Ssd1306Display::submit(Sent sent, const uint8_t *data, uint16_t length) {
+    if (this->m_config.bus == nullptr) {
+        return false;
+    }
+    this->m_transaction.txData = data;
+    this->m_transaction.txLength = length;
+    this->m_transaction.rxData = nullptr;
+    this->m_transaction.rxLength = 0;
+    if (!this->m_config.bus->submit(&this->m_transaction)) {
+        return false;
+    }
+    this->m_sent = sent;
+    this->m_bytesSent += length;
+    return true;
+}
+
+Ssd1306Display::~Ssd1306Display() {
+}
+
+} // namespace ui
@@ -0,0 +1,49 @@
+#ifndef CONSOLE_DISPLAY_HH
+#define CONSOLE_DISPLAY_HH
+
+// Includes
+#include "display.hh"
+
+namespace ui {
+
+/**
+ * @brief Output function of the console, e.g. a UART transmit.
+ * @param data Characters to send.
+ * @param length Number of characters.
+ */
+typedef void (*ConsoleWrite)(const char *data, uint16_t length);
+
+/**
+ * @class ConsoleDisplay
+ * @brief Display rendered on a serial terminal.
+ *
+ * Each flush() homes the cursor and clears the screen with ANSI sequences,
+ * then prints the rows; the highlighted row is prefixed with '>'.
+ */
+class ConsoleDisplay final : public Display {
+  public:
+    /**
+     * @brief Constructor for ConsoleDisplay.
+     * @param write Function sending characters to the terminal.
+     */
+    explicit ConsoleDisplay(ConsoleWrite write);
+    virtual ~ConsoleDisplay() override;
+
+    uint8_t rows() const override;
+    uint8_t columns() const override;
+    void clear() override;
+    void drawText(uint8_t row, const char *text, bool highlighted) override;
+    void flush() override;
+
+  private:
+    static constexpr uint8_t ROWS = 6;
+    static constexpr uint8_t COLUMNS = 20;
+
+    ConsoleWrite m_write = nullptr;       ///< Terminal output.
+    char m_lines[ROWS][COLUMNS + 1] = {}; ///< Frame being drawn.
+    bool m_highlighted[ROWS] = {};        ///< Rows under the cursor.
+};
+
+} // namespace ui
+
+#endif // CONSOLE_DISPLAY_HH
@@ -0,0 +1,60 @@
+#ifndef DISPLAY_HH
+#define DISPLAY_HH
+
+// Includes
+#include <stdint.h>
+
+/**
+ * @namespace ui
+ * @brief Contains the local user interface (displays and menu).
+ */
+namespace ui {
+
+/**
+ * @class Display
+ * @brief Abstract text display the menu renders to.
+ *
+ * A frame is drawn with clear(), then drawText() for each row, and becomes
+ * visible on flush(). Back-ends decide how a highlighted row is shown.
+ */
+class Display {
+  public:
+    /**
+     * @brief Virtual destructor for Display.
+     */
+    virtual ~Display();
+
+    /**
+     * @brief Gets the number of text rows.
+     * @return Number of rows.
+     */
+    virtual uint8_t rows() const = 0;
+
+    /**
+     * @brief Gets the number of characters per row.
+     * @return Number of columns.
+     */
+    virtual uint8_t columns() const = 0;
+
+    /**
+     * @brief Starts a new frame with every row blank.
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief Draws one row of the frame.
+     * @param row Row index, 0 at the top.
+     * @param text Text, truncated to columns().
+     * @param highlighted True for the row under the cursor.
+     */
+    virtual void drawText(uint8_t row, const char *text, bool highlighted) = 0;
+
+    /**
+     * @brief Makes the frame visible.
+     */
+    virtual void flush() = 0;
+};
+
+} // namespace ui
+
+#endif // DISPLAY_HH
@@ -0,0 +1,26 @@
+#ifndef FONT_HH
+#define FONT_HH
+
+// Includes
+#include <stdint.h>
+
+namespace ui {
+
+constexpr uint8_t FONT_WIDTH = 5;  ///< Glyph width in pixels
+constexpr uint8_t FONT_HEIGHT = 7; ///< Glyph height in pixels
+
+/**
+ * @brief Gets the glyph of a character in the 5x7 font.
+ *
+ * The font covers printable ASCII and is a constant table, so it stays in
+ * flash. A glyph is FONT_WIDTH column bytes, bit 0 at the top, which is the
+ * layout of an SSD1306 page.
+ *
+ * @param character Character to draw.
+ * @return Glyph columns, the '?' glyph for characters outside the font.
+ */
+const uint8_t *fontGlyph(char character);
+
+} // namespace ui
+
+#endif // FONT_HH
@@ -0,0 +1,122 @@
+#ifndef SSD1306_DISPLAY_HH
+#define SSD1306_DISPLAY_HH
+
+// Includes
+#include "../../../driver/i2c/inc/i2c_bus.hh"
+#include "display.hh"
+#include "font.hh"
+
+namespace ui {
+
+/**
+ * @brief Configuration structure for an SSD1306 display on an I2C bus.
+ *
+ * @struct Ssd1306Config
+ * @var bus::I2cEngine *bus
+ *      Engine of the bus the display is on.
+ * @var uint8_t address
+ *      7-bit address (0x3C or 0x3D).
+ * @var uint16_t timeoutMs
+ *      Timeout of each I2C transaction, one page at most.
+ */
+typedef struct {
+    bus::I2cEngine *bus; ///< Engine of the bus
+    uint8_t address;     ///< 7-bit address
+    uint16_t timeoutMs;  ///< I2C transaction timeout
+} Ssd1306Config;
+
+/**
+ * @class Ssd1306Display
+ * @brief 128x64 SSD1306 OLED used as an 8 x 21 text display.
+ *
+ * No framebuffer is kept: the driver holds the text of the frame being
+ * drawn and the text shown on the glass, and renders one page (8 pixel
+ * rows, one text row) at a time into a band buffer. Only the columns
+ * between the first and last changed characters of a page are rendered and
+ * sent, through the asynchronous I2C engine.
+ *
+ * flush() starts sending, and update() sends the next changed page once the
+ * previous transfer has completed; call it when the completion callback
+ * fires. A page whose transfer failed is redrawn in full.
+ */
+class Ssd1306Display final : public Display {
+  public:
+    /**
+     * @brief Constructor for Ssd1306Display.
+     * @param config Display configuration: bus, address and timeout.
+     */
+    explicit Ssd1306Display(Ssd1306Config config);
+    virtual ~Ssd1306Display() override;
+
+    /**
+     * @brief Sets a callback for the end of each I2C transaction.
+     * @param callback Called from interrupt context, may be nullptr.
+     * @param context Passed back through I2cTransaction::context.
+     */
+    void setCallback(bus::I2cCallback callback, void *context);
+
+    /**
+     * @brief Sends the next pending transfer: the initialization sequence,
+     * a changed page, or the display-on command after the first frame.
+     */
+    void update();
+
+    /**
+     * @brief Checks if an I2C transaction is pending.
+     * @return True while a transfer is queued or on the bus.
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief Checks if the panel is on, i.e. the first frame is shown.
+     * @return True once the display-on command was accepted.
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Gets the number of bytes sent to the display.
+     * @return Bytes written since construction, control bytes included.
+     */
+    uint32_t bytesSent() const;
+
+    uint8_t rows() const override;
+    uint8_t columns() const override;
+    void clear() override;
+    void drawText(uint8_t row, const char *text, bool highlighted) override;
+    void flush() override;
+
+  private:
+    static constexpr uint8_t WIDTH = 128;                   ///< Pixels
+    static constexpr uint8_t PAGES = 8;                     ///< Text rows
+    static constexpr uint8_t CELL_WIDTH = FONT_WIDTH + 1;   ///< With spacing
+    static constexpr uint8_t COLUMNS = WIDTH / CELL_WIDTH;  ///< Characters
+    static constexpr uint8_t BAND_HEADER = 7;               ///< Address bytes
+    static constexpr uint8_t ALL_PAGES = 0xFF;              ///< Page mask
+
+    /**
+     * @brief Last transaction queued.
+     */
+    enum class Sent : uint8_t { NOTHING = 0, INIT, PAGE, POWER_ON };
+
+    bool sendPage();
+    uint16_t renderBand(uint8_t page, uint8_t start, uint8_t end);
+    bool submit(Sent sent, const uint8_t *data, uint16_t length);
+
+    Ssd1306Config m_config = {};                ///< Display configuration.
+    bus::I2cTransaction m_transaction = {};     ///< Descriptor on the bus.
+    Sent m_sent = Sent::NOTHING;                ///< Last transaction queued.
+    bool m_initialized = false;                 ///< Init sequence accepted.
+    bool m_on = false;                          ///< Panel switched on.
+    uint8_t m_sentPage = 0;                     ///< Page of the last band.
+    uint8_t m_highlighted = 0;                  ///< Inverted rows, drawn.
+    uint8_t m_shownHighlighted = 0;             ///< Inverted rows, on glass.
+    uint8_t m_stale = ALL_PAGES;                ///< Pages to redraw in full.
+    char m_text[PAGES][COLUMNS] = {};           ///< Frame being drawn.
+    char m_shown[PAGES][COLUMNS] = {};          ///< Text on the glass.
+    uint8_t m_band[BAND_HEADER + WIDTH] = {};   ///< Page being sent.
+    uint32_t m_bytesSent = 0;                   ///< Bytes written.
+};
+
+} // namespace ui
+
+#endif // SSD1306_DISPLAY_HH
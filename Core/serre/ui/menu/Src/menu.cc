@@ -0,0 +1,263 @@
+#include "../inc/menu.hh"
+
+namespace ui {
+
+namespace {
+
+/**
+ * @brief Formats a fixed-point value, e.g. 185 with 1 decimal as "18.5".
+ * @return Number of characters written, without the terminator.
+ */
+uint8_t formatValue(int16_t value, uint8_t decimals, char *buffer) {
+    char digits[8];
+    uint8_t count = 0;
+    int32_t magnitude = value;
+    bool negative = magnitude < 0;
+    if (negative) {
+        magnitude = -magnitude;
+    }
+    do {
+        if ((decimals > 0) && (count == decimals)) {
+            digits[count++] = '.';
+        }
+        digits[count++] = static_cast<char>('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while ((magnitude > 0) || (count <= decimals));
+
+    uint8_t length = 0;
+    if (negative) {
+        buffer[length++] = '-';
+    }
+    while (count > 0) {
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+} // namespace
+
+MenuModel::~MenuModel() {
+}
+
+MenuEngine::MenuEngine(const Menu *root, MenuModel *model) {
+    this->m_model = model;
+    this->m_stack[0] = root;
+}
+
+void MenuEngine::handle(input::ButtonEvent event) {
+    this->m_status = nullptr;
+    bool held = event.type != input::ButtonEventType::SHORT_PRESS;
+
+    switch (event.button) {
+    case input::ButtonId::UP:
+        if (this->m_editing) {
+            this->adjust(1);
+        } else {
+            this->move(-1);
+        }
+        break;
+    case input::ButtonId::DOWN:
+        if (this->m_editing) {
+            this->adjust(-1);
+        } else {
+            this->move(1);
+        }
+        break;
+    case input::ButtonId::SEL:
+        if (!held) {
+            this->select();
+        } else if (event.type == input::ButtonEventType::LONG_PRESS) {
+            this->back();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void MenuEngine::render(Display *display) const {
+    if (display == nullptr) {
+        return;
+    }
+    char line[MAX_COLUMNS + 1];
+    uint8_t columns = display->columns();
+    if (columns > MAX_COLUMNS) {
+        columns = MAX_COLUMNS;
+    }
+
+    display->clear();
+    const Menu *menu = this->menu();
+    display->drawText(0, (this->m_status != nullptr) ? this->m_status
+                                                     : menu->title,
+                      false);
+
+    // Scroll so that the cursor stays on the last visible row
+    uint8_t visible = static_cast<uint8_t>(display->rows() - 1);
+    uint8_t cursor = this->m_cursor[this->m_depth];
+    uint8_t first = 0;
+    if (cursor >= visible) {
+        first = static_cast<uint8_t>(cursor - visible + 1);
+    }
+    for (uint8_t row = 0; row < visible; row++) {
+        uint8_t index = static_cast<uint8_t>(first + row);
+        if (index >= menu->count) {
+            break;
+        }
+        this->formatItem(&menu->items[index], index == cursor, line, columns);
+        display->drawText(static_cast<uint8_t>(row + 1), line,
+                          index == cursor);
+    }
+    display->flush();
+}
+
+bool MenuEngine::isLive() const {
+    const Menu *menu = this->menu();
+    for (uint8_t i = 0; i < menu->count; i++) {
+        if (menu->items[i].kind == ItemKind::READOUT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MenuEngine::isEditing() const {
+    return this->m_editing;
+}
+
+const Menu *MenuEngine::menu() const {
+    return this->m_stack[this->m_depth];
+}
+
+const MenuItem *MenuEngine::item() const {
+    return &this->menu()->items[this->m_cursor[this->m_depth]];
+}
+
+void MenuEngine::select() {
+    const MenuItem *item = this->item();
+    if (this->m_editing) {
+        this->m_model->setValue(item->id, this->m_editValue);
+        this->m_editing = false;
+        return;
+    }
+
+    switch (item->kind) {
+    case ItemKind::SUBMENU:
+        if ((item->submenu != nullptr) && (this->m_depth + 1 < MAX_DEPTH)) {
+            this->m_depth++;
+            this->m_stack[this->m_depth] = item->submenu;
+            this->m_cursor[this->m_depth] = 0;
+        }
+        break;
+    case ItemKind::VALUE:
+        this->m_editValue = this->m_model->getValue(item->id);
+        this->m_editing = true;
+        break;
+    case ItemKind::ACTION:
+        this->m_status = this->m_model->runAction(item->id);
+        break;
+    case ItemKind::BACK:
+        this->back();
+        break;
+    default:
+        break;
+    }
+}
+
+void MenuEngine::back() {
+    if (this->m_editing) {
+        // Cancel the edit, the model keeps its value
+        this->m_editing = false;
+    } else if (this->m_depth > 0) {
+        this->m_depth--;
+    }
+}
+
+void MenuEngine::move(int8_t direction) {
+    uint8_t count = this->menu()->count;
+    uint8_t &cursor = this->m_cursor[this->m_depth];
+    if (direction > 0) {
+        cursor = static_cast<uint8_t>((cursor + 1 < count) ? cursor + 1 : 0);
+    } else {
+        cursor = static_cast<uint8_t>((cursor > 0) ? cursor - 1 : count - 1);
+    }
+}
+
+void MenuEngine::adjust(int8_t direction) {
+    const MenuItem *item = this->item();
+    int32_t value =
+        static_cast<int32_t>(this->m_editValue) + (direction * item->step);
+    if (item->choices != nullptr) {
+        // Choice lists wrap around, numbers stop at their limits
+        if (value > item->max) {
+            value = item->min;
+        } else if (value < item->min) {
+            value = item->max;
+        }
+    } else if (value > item->max) {
+        value = item->max;
+    } else if (value < item->min) {
+        value = item->min;
+    }
+    this->m_editValue = static_cast<int16_t>(value);
+}
+
+void MenuEngine::formatItem(const MenuItem *item, bool selected, char *line,
+                            uint8_t columns) const {
+    char value[12] = "";
+    uint8_t valueLength = 0;
+    bool editing = selected && this->m_editing;
+    int16_t current = 0;
+
+    switch (item->kind) {
+    case ItemKind::SUBMENU:
+        value[0] = '>';
+        value[1] = '\0';
+        valueLength = 1;
+        break;
+    case ItemKind::VALUE:
+    case ItemKind::READOUT:
+        current = this->m_editValue;
+        if (!editing) {
+            current = this->m_model->getValue(item->id);
+        }
+        if ((item->choices != nullptr) && (current >= item->min) &&
+            (current <= item->max)) {
+            const char *name = item->choices[current - item->min];
+            while ((name[valueLength] != '\0') && (valueLength < 8)) {
+                value[valueLength] = name[valueLength];
+                valueLength++;
+            }
+            value[valueLength] = '\0';
+        } else {
+            valueLength = formatValue(current, item->decimals, value);
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Label on the left, value right-aligned, brackets while editing
+    uint8_t width = static_cast<uint8_t>(valueLength + (editing ? 2 : 0));
+    uint8_t length = 0;
+    const char *label = item->label;
+    while ((label[length] != '\0') && (length + width + 1 < columns)) {
+        line[length] = label[length];
+        length++;
+    }
+    while (length + width < columns) {
+        line[length++] = ' ';
+    }
+    if (editing) {
+        line[length++] = '[';
+    }
+    for (uint8_t i = 0; i < valueLength; i++) {
+        line[length++] = value[i];
+    }
+    if (editing) {
+        line[length++] = ']';
+    }
+    line[length] = '\0';
+}
+
+} // namespace ui
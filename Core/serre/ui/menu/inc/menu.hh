@@ -0,0 +1,147 @@
+#ifndef MENU_HH
+#define MENU_HH
+
+// Includes
+#include "../../../driver/buttons/inc/buttons.hh"
+#include "../../display/inc/display.hh"
+
+namespace ui {
+
+/**
+ * @brief Behavior of a menu entry.
+ */
+enum class ItemKind : uint8_t {
+    SUBMENU = 0, ///< Opens another menu
+    VALUE,       ///< Value edited with UP/DOWN, committed with SEL
+    READOUT,     ///< Live read-only value
+    ACTION,      ///< Command run by SEL
+    BACK         ///< Returns to the parent menu
+};
+
+struct Menu;
+
+/**
+ * @brief Menu entry.
+ *
+ * Entries are constant aggregates, so whole menus stay in flash.
+ */
+struct MenuItem {
+    const char *label;          ///< Text shown on the left
+    ItemKind kind;              ///< Behavior
+    uint8_t id;                 ///< Value or action identifier for the model
+    int16_t min;                ///< Lowest value
+    int16_t max;                ///< Highest value
+    int16_t step;               ///< Increment of UP/DOWN
+    uint8_t decimals;           ///< Digits after the decimal point
+    const char *const *choices; ///< Names of min..max, nullptr if numeric
+    const Menu *submenu;        ///< Menu opened by a SUBMENU entry
+};
+
+/**
+ * @brief List of entries under a title.
+ */
+struct Menu {
+    const char *title;     ///< Top row text
+    const MenuItem *items; ///< Entries
+    uint8_t count;         ///< Number of entries
+};
+
+/**
+ * @class MenuModel
+ * @brief Application data behind the menu entries.
+ */
+class MenuModel {
+  public:
+    /**
+     * @brief Virtual destructor for MenuModel.
+     */
+    virtual ~MenuModel();
+
+    /**
+     * @brief Reads a value.
+     * @param id Value identifier of the entry.
+     * @return Current value.
+     */
+    virtual int16_t getValue(uint8_t id) const = 0;
+
+    /**
+     * @brief Writes a value confirmed by the user.
+     * @param id Value identifier of the entry.
+     * @param value New value, within the entry limits.
+     */
+    virtual void setValue(uint8_t id, int16_t value) = 0;
+
+    /**
+     * @brief Runs a command.
+     * @param id Action identifier of the entry.
+     * @return Message shown in the title row, nullptr for none.
+     */
+    virtual const char *runAction(uint8_t id) = 0;
+};
+
+/**
+ * @class MenuEngine
+ * @brief Navigates constant menu tables with the three push buttons.
+ *
+ * UP and DOWN move the cursor, SEL opens, edits or runs the entry and a
+ * long SEL goes back. While editing, UP and DOWN change the value (held
+ * buttons repeat), SEL commits it and a long SEL cancels.
+ */
+class MenuEngine {
+  public:
+    /**
+     * @brief Constructor for MenuEngine.
+     * @param root Top level menu.
+     * @param model Data behind the entries.
+     */
+    MenuEngine(const Menu *root, MenuModel *model);
+
+    /**
+     * @brief Applies a button event.
+     * @param event Event from the button queue.
+     */
+    void handle(input::ButtonEvent event);
+
+    /**
+     * @brief Draws the current menu.
+     * @param display Display to draw on.
+     */
+    void render(Display *display) const;
+
+    /**
+     * @brief Checks if the screen shows live values.
+     * @return True if the current menu holds a READOUT entry.
+     */
+    bool isLive() const;
+
+    /**
+     * @brief Checks if a value is being edited.
+     * @return True while editing.
+     */
+    bool isEditing() const;
+
+  private:
+    static constexpr uint8_t MAX_DEPTH = 4;
+    static constexpr uint8_t MAX_COLUMNS = 21;
+
+    const Menu *menu() const;
+    const MenuItem *item() const;
+    void select();
+    void back();
+    void move(int8_t direction);
+    void adjust(int8_t direction);
+    void formatItem(const MenuItem *item, bool selected, char *line,
+                    uint8_t columns) const;
+
+    MenuModel *m_model = nullptr;        ///< Application data.
+    const Menu *m_stack[MAX_DEPTH] = {}; ///< Opened menus, root first.
+    uint8_t m_cursor[MAX_DEPTH] = {};    ///< Cursor in each opened menu.
+    uint8_t m_depth = 0;                 ///< Index of the current menu.
+    bool m_editing = false;              ///< Editing the current entry.
+    int16_t m_editValue = 0;             ///< Value being edited.
+    const char *m_status = nullptr;      ///< Message of the last action.
+};
+
+} // namespace ui
+
+#endif // MENU_HH
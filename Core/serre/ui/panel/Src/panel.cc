@@ -0,0 +1,184 @@
+#include "../inc/panel.hh"
+
+namespace ui {
+
+namespace {
+
+/**
+ * @brief Values shown by the panel menu.
+ */
+enum PanelValue : uint8_t {
+    VALUE_TEMP_MIN = 0, ///< Lowest valid temperature (0.1 °C)
+    VALUE_TEMP_MAX,     ///< Highest valid temperature (0.1 °C)
+    VALUE_SOIL_RAW,     ///< Current raw soil reading
+    VALUE_SOIL_DRY,     ///< Dry calibration point
+    VALUE_SOIL_WET,     ///< Wet calibration point
+    VALUE_FAN_MODE,     ///< Fan override
+    VALUE_PUMP_MODE     ///< Pump override
+};
+
+/**
+ * @brief Commands of the panel menu.
+ */
+enum PanelAction : uint8_t {
+    ACTION_CAPTURE_DRY = 0, ///< Current reading becomes the dry point
+    ACTION_CAPTURE_WET,     ///< Current reading becomes the wet point
+    ACTION_SAVE             ///< Writes the settings to flash
+};
+
+constexpr int16_t TEMP_LIMIT_MIN = -400; ///< Sensor range, 0.1 °C
+constexpr int16_t TEMP_LIMIT_MAX = 850;  ///< Sensor range, 0.1 °C
+constexpr int16_t ADC_LIMIT_MAX = 4095;  ///< 12-bit ADC
+
+const char *const overrideNames[] = {"Auto", "Off", "On"};
+
+const MenuItem thresholdItems[] = {
+    {"Temp min", ItemKind::VALUE, VALUE_TEMP_MIN, TEMP_LIMIT_MIN,
+     TEMP_LIMIT_MAX, 5, 1, nullptr, nullptr},
+    {"Temp max", ItemKind::VALUE, VALUE_TEMP_MAX, TEMP_LIMIT_MIN,
+     TEMP_LIMIT_MAX, 5, 1, nullptr, nullptr},
+    {"Back", ItemKind::BACK, 0, 0, 0, 0, 0, nullptr, nullptr},
+};
+
+const MenuItem calibrationItems[] = {
+    {"Reading", ItemKind::READOUT, VALUE_SOIL_RAW, 0, ADC_LIMIT_MAX, 0, 0,
+     nullptr, nullptr},
+    {"Capture dry", ItemKind::ACTION, ACTION_CAPTURE_DRY, 0, 0, 0, 0, nullptr,
+     nullptr},
+    {"Capture wet", ItemKind::ACTION, ACTION_CAPTURE_WET, 0, 0, 0, 0, nullptr,
+     nullptr},
+    {"Dry", ItemKind::VALUE, VALUE_SOIL_DRY, 0, ADC_LIMIT_MAX, 10, 0, nullptr,
+     nullptr},
+    {"Wet", ItemKind::VALUE, VALUE_SOIL_WET, 0, ADC_LIMIT_MAX, 10, 0, nullptr,
+     nullptr},
+    {"Back", ItemKind::BACK, 0, 0, 0, 0, 0, nullptr, nullptr},
+};
+
+const MenuItem manualItems[] = {
+    {"Fan", ItemKind::VALUE, VALUE_FAN_MODE, 0, 2, 1, 0, overrideNames,
+     nullptr},
+    {"Pump", ItemKind::VALUE, VALUE_PUMP_MODE, 0, 2, 1, 0, overrideNames,
+     nullptr},
+    {"Back", ItemKind::BACK, 0, 0, 0, 0, 0, nullptr, nullptr},
+};
+
+const Menu thresholdMenu = {
+    "Thresholds", thresholdItems,
+    sizeof(thresholdItems) / sizeof(thresholdItems[0])};
+
+const Menu calibrationMenu = {
+    "Soil calibration", calibrationItems,
+    sizeof(calibrationItems) / sizeof(calibrationItems[0])};
+
+const Menu manualMenu = {"Manual", manualItems,
+                         sizeof(manualItems) / sizeof(manualItems[0])};
+
+const MenuItem panelItems[] = {
+    {"Thresholds", ItemKind::SUBMENU, 0, 0, 0, 0, 0, nullptr, &thresholdMenu},
+    {"Soil calib", ItemKind::SUBMENU, 0, 0, 0, 0, 0, nullptr,
+     &calibrationMenu},
+    {"Manual", ItemKind::SUBMENU, 0, 0, 0, 0, 0, nullptr, &manualMenu},
+    {"Save", ItemKind::ACTION, ACTION_SAVE, 0, 0, 0, 0, nullptr, nullptr},
+};
+
+} // namespace
+
+const Menu panelMenu = {"Serre", panelItems,
+                        sizeof(panelItems) / sizeof(panelItems[0])};
+
+PanelModel::PanelModel(sys::Settings *settings,
+                       sensor::TempSensor *tempSensor,
+                       sensor::SoilHumSensor *soilHumSensor,
+                       control::Actuators *actuators) {
+    this->m_settings = settings;
+    this->m_tempSensor = tempSensor;
+    this->m_soilHumSensor = soilHumSensor;
+    this->m_actuators = actuators;
+}
+
+void PanelModel::apply() {
+    this->m_tempSensor->setThreshold(
+        static_cast<float>(this->m_settings->tempMinDeci) / 10.0f,
+        static_cast<float>(this->m_settings->tempMaxDeci) / 10.0f);
+    // Rejected by the sensor while the dry point is not above the wet one
+    this->m_soilHumSensor->calibrate(this->m_settings->soilDry,
+                                     this->m_settings->soilWet);
+}
+
+int16_t PanelModel::getValue(uint8_t id) const {
+    switch (id) {
+    case VALUE_TEMP_MIN:
+        return this->m_settings->tempMinDeci;
+    case VALUE_TEMP_MAX:
+        return this->m_settings->tempMaxDeci;
+    case VALUE_SOIL_RAW:
+        return static_cast<int16_t>(this->m_soilHumSensor->getRawAverage());
+    case VALUE_SOIL_DRY:
+        return static_cast<int16_t>(this->m_settings->soilDry);
+    case VALUE_SOIL_WET:
+        return static_cast<int16_t>(this->m_settings->soilWet);
+    case VALUE_FAN_MODE:
+        return static_cast<int16_t>(this->m_actuators->fanOverride());
+    case VALUE_PUMP_MODE:
+        return static_cast<int16_t>(this->m_actuators->pumpOverride());
+    default:
+        return 0;
+    }
+}
+
+void PanelModel::setValue(uint8_t id, int16_t value) {
+    switch (id) {
+    case VALUE_TEMP_MIN:
+        if (value < this->m_settings->tempMaxDeci) {
+            this->m_settings->tempMinDeci = value;
+        }
+        break;
+    case VALUE_TEMP_MAX:
+        if (value > this->m_settings->tempMinDeci) {
+            this->m_settings->tempMaxDeci = value;
+        }
+        break;
+    case VALUE_SOIL_DRY:
+        this->m_settings->soilDry = static_cast<uint16_t>(value);
+        break;
+    case VALUE_SOIL_WET:
+        this->m_settings->soilWet = static_cast<uint16_t>(value);
+        break;
+    case VALUE_FAN_MODE:
+        this->m_actuators->setFanOverride(
+            static_cast<control::Override>(value));
+        return;
+    case VALUE_PUMP_MODE:
+        this->m_actuators->setPumpOverride(
+            static_cast<control::Override>(value));
+        return;
+    default:
+        return;
+    }
+    this->apply();
+}
+
+const char *PanelModel::runAction(uint8_t id) {
+    switch (id) {
+    case ACTION_CAPTURE_DRY:
+        this->m_settings->soilDry = this->m_soilHumSensor->getRawAverage();
+        this->apply();
+        return "Dry point set";
+    case ACTION_CAPTURE_WET:
+        this->m_settings->soilWet = this->m_soilHumSensor->getRawAverage();
+        this->apply();
+        return "Wet point set";
+    case ACTION_SAVE:
+        if (this->m_settings->soilDry <= this->m_settings->soilWet) {
+            return "Dry must be > wet";
+        }
+        return sys::settingsSave(this->m_settings) ? "Saved" : "Save failed";
+    default:
+        return nullptr;
+    }
+}
+
+PanelModel::~PanelModel() {
+}
+
+} // namespace ui
@@ -0,0 +1,59 @@
+#ifndef PANEL_HH
+#define PANEL_HH
+
+// Includes
+#include "../../../control/actuators/inc/actuators.hh"
+#include "../../../driver/sensors/soil_hum_sensor/inc/soil_hum.hh"
+#include "../../../driver/sensors/temp_sensor/inc/temp_sensor.hh"
+#include "../../../system/settings/inc/settings.hh"
+#include "../../menu/inc/menu.hh"
+
+namespace ui {
+
+/**
+ * @brief Front panel menu: thresholds, soil calibration, manual overrides.
+ */
+extern const Menu panelMenu;
+
+/**
+ * @class PanelModel
+ * @brief Binds the front panel menu to the settings and the hardware.
+ *
+ * Thresholds and calibration points are edited in the settings record and
+ * applied to the sensors immediately; they reach flash only through the
+ * Save entry. Manual overrides act on the actuators directly and are not
+ * saved, so a forgotten override does not survive a reset.
+ */
+class PanelModel final : public MenuModel {
+  public:
+    /**
+     * @brief Constructor for PanelModel.
+     * @param settings Settings edited by the menu.
+     * @param tempSensor Sensor receiving the temperature thresholds.
+     * @param soilHumSensor Sensor receiving the calibration points.
+     * @param actuators Actuators receiving the manual overrides.
+     */
+    PanelModel(sys::Settings *settings, sensor::TempSensor *tempSensor,
+               sensor::SoilHumSensor *soilHumSensor,
+               control::Actuators *actuators);
+    virtual ~PanelModel() override;
+
+    /**
+     * @brief Applies the settings to the sensors.
+     */
+    void apply();
+
+    int16_t getValue(uint8_t id) const override;
+    void setValue(uint8_t id, int16_t value) override;
+    const char *runAction(uint8_t id) override;
+
+  private:
+    sys::Settings *m_settings = nullptr;              ///< Edited settings.
+    sensor::TempSensor *m_tempSensor = nullptr;       ///< Air temperature.
+    sensor::SoilHumSensor *m_soilHumSensor = nullptr; ///< Soil humidity.
+    control::Actuators *m_actuators = nullptr;        ///< Fan and pump.
+};
+
+} // namespace ui
+
+#endif // PANEL_HH
@@ -0,0 +1,315 @@
+#include "bench.hh"
+
+#include "../board/board.hh"
+#include "../hal/hal_mock.hh"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint16_t MAX_BENCHES = 64;
+constexpr uint32_t DEFAULT_ITERATIONS = 200000;
+constexpr uint16_t SYNTHETIC_LENGTH = 256;
+constexpr uint16_t ADC_FULL_SCALE = 4095;
+
+/**
+ * @brief Registered benchmark.
+ */
+struct Bench {
+    const char *name;          ///< "Class.method"
+    bench::BenchFunction fn;   ///< Body
+};
+
+/**
+ * @brief Measurement of one benchmark on one stream.
+ */
+struct Result {
+    double nsPerOp;           ///< Wall time per operation
+    double instructionsPerOp; ///< Negative when not counted
+    double allocationsPerOp;  ///< operator new calls per operation
+};
+
+Bench s_benches[MAX_BENCHES];
+uint16_t s_benchCount = 0;
+volatile float s_sink = 0;
+size_t s_allocations = 0;
+
+/**
+ * @brief Instructions retired by this thread, in user space.
+ */
+class InstructionCounter {
+  public:
+    InstructionCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        this->m_fd = static_cast<int>(
+            syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter() {
+#ifdef __linux__
+        if (this->m_fd >= 0) {
+            close(this->m_fd);
+        }
+#endif
+    }
+
+    bool isAvailable() const {
+        return this->m_fd >= 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        if (this->m_fd >= 0) {
+            ioctl(this->m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(this->m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (this->m_fd >= 0) {
+            ioctl(this->m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(this->m_fd, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+    int m_fd = -1; ///< perf event, -1 when not available.
+};
+
+std::vector<uint16_t> syntheticStream(const char *name) {
+    std::vector<uint16_t> samples(SYNTHETIC_LENGTH);
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < SYNTHETIC_LENGTH; i++) {
+        if (strcmp(name, "constant") == 0) {
+            samples[i] = 2048;
+        } else if (strcmp(name, "ramp") == 0) {
+            samples[i] = static_cast<uint16_t>((i * ADC_FULL_SCALE) /
+                                               (SYNTHETIC_LENGTH - 1));
+        } else if (strcmp(name, "noise") == 0) {
+            // 2048 +/- 200 counts, linear congruential generator
+            seed = (seed * 1103515245U) + 12345U;
+            samples[i] = static_cast<uint16_t>(1848 + ((seed >> 16) % 401));
+        } else {
+            // Dry then wet soil: crosses both calibration clamps
+            samples[i] = (i < SYNTHETIC_LENGTH / 2) ? 3900 : 300;
+        }
+    }
+    return samples;
+}
+
+bool loadRecording(const char *path, std::vector<uint16_t> *samples) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[64];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if ((line[0] == '#') || (line[0] == '\n')) {
+            continue;
+        }
+        long value = strtol(line, nullptr, 0);
+        if ((value >= 0) && (value <= ADC_FULL_SCALE)) {
+            samples->push_back(static_cast<uint16_t>(value));
+        }
+    }
+    fclose(file);
+    return !samples->empty();
+}
+
+Result measure(const Bench &bench, const bench::Stream &stream,
+               uint32_t iterations, InstructionCounter *counter) {
+    mock::halReset();
+    mock::boardReset();
+    bench.fn(stream, iterations / 10 + 1); // Warm the caches up
+
+    size_t allocationsBefore = s_allocations;
+    counter->start();
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    bench.fn(stream, iterations);
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    uint64_t instructions = counter->stop();
+
+    Result result;
+    result.nsPerOp =
+        std::chrono::duration<double, std::nano>(end - start).count() /
+        iterations;
+    result.instructionsPerOp =
+        counter->isAvailable()
+            ? static_cast<double>(instructions) / iterations
+            : -1.0;
+    result.allocationsPerOp =
+        static_cast<double>(s_allocations - allocationsBefore) / iterations;
+    return result;
+}
+
+void usage(const char *program) {
+    printf("Usage: %s [--json] [--iterations N] [--record FILE]... "
+           "[filter]\n"
+           "  --json        One JSON object per line, for regression "
+           "tracking\n"
+           "  --iterations  Operations per measurement (default %u)\n"
+           "  --record      ADC recording, one value per line\n"
+           "  filter        Substring of the benchmark names to run\n",
+           program, DEFAULT_ITERATIONS);
+}
+
+} // namespace
+
+// Every operator new of the process is counted, firmware code included
+void *operator new(size_t size) {
+    s_allocations++;
+    void *block = malloc((size > 0) ? size : 1);
+    if (block == nullptr) {
+        abort();
+    }
+    return block;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *block) noexcept {
+    free(block);
+}
+
+void operator delete[](void *block) noexcept {
+    free(block);
+}
+
+void operator delete(void *block, size_t size) noexcept {
+    (void)size;
+    free(block);
+}
+
+void operator delete[](void *block, size_t size) noexcept {
+    (void)size;
+    free(block);
+}
+
+namespace bench {
+
+Registrar::Registrar(const char *name, BenchFunction function) {
+    if (s_benchCount < MAX_BENCHES) {
+        s_benches[s_benchCount++] = {name, function};
+    }
+}
+
+void keep(float value) {
+    s_sink = value;
+}
+
+} // namespace bench
+
+/**
+ * @brief Runs the registered benchmarks on every stream.
+ */
+int main(int argc, char **argv) {
+    bool json = false;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    const char *filter = nullptr;
+    std::vector<std::string> names = {"constant", "ramp", "noise", "step"};
+    std::vector<std::vector<uint16_t>> samples;
+    for (const std::string &name : names) {
+        samples.push_back(syntheticStream(name.c_str()));
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if ((strcmp(argv[i], "--iterations") == 0) && (i + 1 < argc)) {
+            iterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        } else if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc)) {
+            std::vector<uint16_t> recording;
+            if (!loadRecording(argv[++i], &recording)) {
+                fprintf(stderr, "cannot read ADC samples from %s\n", argv[i]);
+                return 1;
+            }
+            const char *slash = strrchr(argv[i], '/');
+            names.push_back((slash != nullptr) ? slash + 1 : argv[i]);
+            samples.push_back(recording);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    InstructionCounter counter;
+    if (!json) {
+        printf("%-28s %-12s %10s %12s %10s\n", "benchmark", "stream",
+               "ns/op", "instr/op", "allocs/op");
+    }
+    for (uint16_t b = 0; b < s_benchCount; b++) {
+        const Bench &bench = s_benches[b];
+        if ((filter != nullptr) && (strstr(bench.name, filter) == nullptr)) {
+            continue;
+        }
+        for (size_t s = 0; s < names.size(); s++) {
+            bench::Stream stream = {names[s].c_str(), samples[s].data(),
+                                    samples[s].size()};
+            Result result = measure(bench, stream, iterations, &counter);
+            if (json) {
+                printf("{\"benchmark\": \"%s\", \"stream\": \"%s\", "
+                       "\"iterations\": %u, \"ns_per_op\": %.2f, ",
+                       bench.name, stream.name, iterations, result.nsPerOp);
+                if (result.instructionsPerOp < 0) {
+                    printf("\"instructions_per_op\": null, ");
+                } else {
+                    printf("\"instructions_per_op\": %.1f, ",
+                           result.instructionsPerOp);
+                }
+                printf("\"allocations_per_op\": %.3f}\n",
+                       result.allocationsPerOp);
+            } else {
+                char instructions[16] = "n/a";
+                if (result.instructionsPerOp >= 0) {
+                    snprintf(instructions, sizeof(instructions), "%.1f",
+                             result.instructionsPerOp);
+                }
+                printf("%-28s %-12s %10.1f %12s %10.3f\n", bench.name,
+                       stream.name, result.nsPerOp, instructions,
+                       result.allocationsPerOp);
+            }
+        }
+    }
+    if (!json && !counter.isAvailable()) {
+        printf("(instructions: perf counters not available here)\n");
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef BENCH_HH
+#define BENCH_HH
+
+// Includes
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @namespace bench
+ * @brief Micro-benchmarks of the firmware kernels, run on the host.
+ *
+ * Each benchmark registered with BENCH() runs once per ADC stream: the
+ * synthetic ones below, then the recordings given on the command line.
+ * The runner reports the time, the instructions retired (Linux perf
+ * counters, when the kernel allows them) and the operator new calls per
+ * operation.
+ */
+namespace bench {
+
+/**
+ * @brief ADC samples fed to a benchmark.
+ *
+ * @struct Stream
+ * @var const char *name
+ *      Stream name in the report.
+ * @var const uint16_t *samples
+ *      12-bit conversion results.
+ * @var size_t count
+ *      Number of samples, replayed in a loop.
+ */
+typedef struct {
+    const char *name;        ///< Stream name
+    const uint16_t *samples; ///< 12-bit conversion results
+    size_t count;            ///< Number of samples
+} Stream;
+
+/**
+ * @brief Benchmark body: sets up its objects, then runs the operation
+ * measured `iterations` times over the stream.
+ */
+typedef void (*BenchFunction)(const Stream &stream, uint32_t iterations);
+
+/**
+ * @brief Registers a benchmark, used through BENCH().
+ */
+class Registrar {
+  public:
+    /**
+     * @brief Constructor for Registrar.
+     * @param name Benchmark name, "Class.method" by convention.
+     * @param function Benchmark body.
+     */
+    Registrar(const char *name, BenchFunction function);
+};
+
+/**
+ * @brief Keeps a result alive so the compiler cannot drop its computation.
+ * @param value Result of the operation.
+ */
+void keep(float value);
+
+} // namespace bench
+
+#define BENCH(name, function)                                                  \
+    static bench::Registrar function##_registrar(name, function)
+
+#endif // BENCH_HH
@@ -0,0 +1,59 @@
+#include "../../Core/Inc/adc.h"
+#include "../../Core/serre/driver/sensors/soil_hum_sensor/inc/soil_hum.hh"
+#include "../../Core/serre/driver/sensors/temp_sensor/inc/temp_sensor.hh"
+#include "../hal/hal_mock.hh"
+#include "bench.hh"
+
+// Each operation reads one stream sample through the mocked ADC, then
+// processes the sample window. AnalogSensor.readData measures the read
+// alone: subtract it to get the cost of the processing.
+
+namespace {
+
+const sensor::SensorConfig adcConfig = {&hadc1, ADC_CHANNEL_0,
+                                        ADC_SAMPLINGTIME_COMMON_1, 100};
+
+void readData(const bench::Stream &stream, uint32_t iterations) {
+    mock::adcSetStream(ADC_CHANNEL_0, stream.samples, stream.count);
+    sensor::TempSensor temp(adcConfig);
+    for (uint32_t i = 0; i < iterations; i++) {
+        temp.readData();
+    }
+}
+
+void analogProcessData(const bench::Stream &stream, uint32_t iterations) {
+    mock::adcSetStream(ADC_CHANNEL_0, stream.samples, stream.count);
+    sensor::TempSensor temp(adcConfig);
+    for (uint32_t i = 0; i < iterations; i++) {
+        temp.readData();
+        temp.sensor::AnalogSensor::processData();
+    }
+}
+
+void tempProcessData(const bench::Stream &stream, uint32_t iterations) {
+    mock::adcSetStream(ADC_CHANNEL_0, stream.samples, stream.count);
+    sensor::TempSensor temp(adcConfig);
+    for (uint32_t i = 0; i < iterations; i++) {
+        temp.readData();
+        temp.processData();
+        bench::keep(temp.getTemperatureCelsius());
+    }
+}
+
+void soilProcessData(const bench::Stream &stream, uint32_t iterations) {
+    mock::adcSetStream(ADC_CHANNEL_0, stream.samples, stream.count);
+    sensor::SoilHumSensor soil(adcConfig);
+    soil.calibrate(3500, 800);
+    for (uint32_t i = 0; i < iterations; i++) {
+        soil.readData();
+        soil.processData();
+        bench::keep(soil.getHumidityPercent());
+    }
+}
+
+} // namespace
+
+BENCH("AnalogSensor.readData", readData);
+BENCH("AnalogSensor.processData", analogProcessData);
+BENCH("TempSensor.processData", tempProcessData);
+BENCH("SoilHumSensor.processData", soilProcessData);
@@ -0,0 +1,31 @@
+#include "board.hh"
+
+#include "../../Core/serre/system/clock/inc/clock.hh"
+
+#include <string.h>
+
+namespace {
+
+mock::Board s_board;
+
+} // namespace
+
+namespace mock {
+
+Board &board() {
+    return s_board;
+}
+
+void boardReset() {
+    memset(&s_board, 0, sizeof(s_board));
+    memset(s_board.settingsPage, 0xFF, sizeof(s_board.settingsPage));
+    s_board.ramUsage.staticBytes = 3072;
+    s_board.ramUsage.stackBytes = 512;
+    s_board.ramUsage.freeBytes = 8192 - 3072 - 512;
+    // Datasheet typical: 760 mV at 30 °C, 2.5 mV/°C, read with VDDA = 3.0 V
+    s_board.dieTempCalibration.cal1 = 1037;
+    s_board.dieTempCalibration.cal2 = 1378;
+    sys::clockSetProfile(sys::ClockProfile::NORMAL);
+}
+
+} // namespace mock
@@ -0,0 +1,66 @@
+#ifndef BOARD_HH
+#define BOARD_HH
+
+// Includes
+#include "../../Core/serre/driver/sensors/die_temp_sensor/inc/die_temp.hh"
+#include "../../Core/serre/system/memory/inc/ram_monitor.hh"
+#include "../../Core/serre/system/settings/inc/settings.hh"
+
+/**
+ * @namespace mock
+ * @brief Simulated board behind the host build of the firmware.
+ *
+ * The *_host.cc files of this directory stand in for the hardware layers
+ * that program registers or read linker symbols directly (*_hw.cc files
+ * of boot, clock, crash, die temperature, latency, memory, profile,
+ * settings and watchdog).
+ * The other hardware layers run unchanged on top of the mocked HAL.
+ */
+namespace mock {
+
+constexpr uint16_t SETTINGS_PAGE_SIZE = 2048; ///< One flash page.
+constexpr uint16_t SETTINGS_SLOTS =
+    SETTINGS_PAGE_SIZE / sizeof(sys::Settings);
+
+/**
+ * @brief State of the simulated parts that the tests inspect or preset.
+ *
+ * @struct Board
+ * @var sys::Settings settingsPage
+ *      Settings flash page, erased to 0xFF.
+ * @var uint32_t resetFlags
+ *      RCC_CSR returned by the next watchdogReadResetFlags().
+ * @var uint32_t watchdogTimeoutMs
+ *      Timeout given to watchdogStart(), 0 while not started.
+ * @var uint32_t watchdogRefreshes
+ *      Calls to watchdogRefresh().
+ * @var sys::RamUsage ramUsage
+ *      Returned by ramUsageRead().
+ * @var sensor::DieTempCalibration dieTempCalibration
+ *      Returned by dieTempCalibration().
+ */
+typedef struct {
+    sys::Settings settingsPage[SETTINGS_SLOTS];    ///< Settings flash page
+    uint32_t resetFlags;                           ///< Next RCC_CSR read
+    uint32_t watchdogTimeoutMs;                    ///< 0 while not started
+    uint32_t watchdogRefreshes;                    ///< Refresh count
+    sys::RamUsage ramUsage;                        ///< Simulated RAM use
+    sensor::DieTempCalibration dieTempCalibration; ///< TS_CAL1, TS_CAL2
+} Board;
+
+/**
+ * @brief Gets the simulated board.
+ * @return Board state.
+ */
+Board &board();
+
+/**
+ * @brief Puts the board back to its power-on state: erased settings page,
+ * no reset flag, watchdog stopped, NORMAL clock profile, a RAM use
+ * with comfortable headroom and a typical die temperature calibration.
+ */
+void boardReset();
+
+} // namespace mock
+
+#endif // BOARD_HH
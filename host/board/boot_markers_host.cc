@@ -0,0 +1,12 @@
+#include "../../Core/serre/system/boot/inc/boot_markers.hh"
+
+#include "stm32g0xx_hal.h"
+
+namespace sys {
+
+// The simulated tick only moves in whole milliseconds
+uint32_t bootNowUs() {
+    return HAL_GetTick() * 1000U;
+}
+
+} // namespace sys
@@ -0,0 +1,32 @@
+#include "../../Core/serre/system/clock/inc/clock.hh"
+
+#include "../../Core/Inc/i2c.h"
+#include "../hal/hal_mock.hh"
+
+namespace {
+
+sys::ClockProfile s_profile = sys::ClockProfile::NORMAL;
+
+} // namespace
+
+namespace sys {
+
+bool clockSetProfile(ClockProfile profile) {
+    if (profile == s_profile) {
+        return true;
+    }
+    // Same rule as the target: no switch under a running transfer
+    if (mock::i2cPending()) {
+        return false;
+    }
+    s_profile = profile;
+    SystemCoreClock = clockProfileHz(profile);
+    hi2c1.Init.Timing = i2cStandardTiming(HAL_RCC_GetPCLK1Freq());
+    return true;
+}
+
+ClockProfile clockProfile() {
+    return s_profile;
+}
+
+} // namespace sys
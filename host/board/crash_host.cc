@@ -0,0 +1,21 @@
+#include "../../Core/serre/system/crash/inc/crash.hh"
+
+#include "../../Core/Inc/usart.h"
+
+namespace sys {
+
+// Host faults end the process, only the report of a retained record is kept
+bool crashEmitReport() {
+    CrashRecord *record = retainedCrashRecord();
+    if (!crashIsValid(record)) {
+        return false;
+    }
+    char report[400];
+    size_t length = crashFormat(record, report, sizeof(report));
+    HAL_UART_Transmit(&huart2, reinterpret_cast<const uint8_t *>(report),
+                      static_cast<uint16_t>(length), HAL_MAX_DELAY);
+    crashInvalidate(record);
+    return true;
+}
+
+} // namespace sys
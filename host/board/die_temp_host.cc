@@ -0,0 +1,11 @@
+#include "../../Core/serre/driver/sensors/die_temp_sensor/inc/die_temp.hh"
+#include "board.hh"
+
+namespace sensor {
+
+// No system memory on the host: the tests preset the calibration
+DieTempCalibration dieTempCalibration() {
+    return mock::board().dieTempCalibration;
+}
+
+} // namespace sensor
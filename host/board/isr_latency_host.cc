@@ -0,0 +1,12 @@
+#include "../../Core/serre/system/latency/inc/isr_latency.hh"
+
+namespace sys {
+
+// No vector table on the host: the report stays empty
+void measureIsrLatency(uint16_t samples, IsrLatencyReport *report) {
+    (void)samples;
+    IsrLatencyReport empty = {};
+    *report = empty;
+}
+
+} // namespace sys
@@ -0,0 +1,10 @@
+#include "../../Core/serre/system/profile/inc/profile.hh"
+
+namespace sys {
+
+// TIM2 is a plain variable on the host, the tests set its count
+void profileStart() {
+    PROFILE_TIMER->CNT = 0;
+}
+
+} // namespace sys
@@ -0,0 +1,11 @@
+#include "../../Core/serre/system/memory/inc/ram_monitor.hh"
+#include "board.hh"
+
+namespace sys {
+
+// No painted stack on the host: the tests preset the figures
+void ramUsageRead(RamUsage *usage) {
+    *usage = mock::board().ramUsage;
+}
+
+} // namespace sys
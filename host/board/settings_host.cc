@@ -0,0 +1,32 @@
+#include "board.hh"
+
+#include <string.h>
+
+namespace sys {
+
+void settingsLoad(Settings *settings) {
+    const Settings *page = mock::board().settingsPage;
+    int16_t latest = settingsFindLatest(page, mock::SETTINGS_SLOTS);
+    if (latest < 0) {
+        settingsDefaults(settings);
+        return;
+    }
+    memcpy(settings, &page[latest], sizeof(Settings));
+}
+
+bool settingsSave(Settings *settings) {
+    settings->sequence++;
+    settingsSeal(settings);
+
+    Settings *page = mock::board().settingsPage;
+    int16_t slot = settingsFindFree(page, mock::SETTINGS_SLOTS);
+    if (slot < 0) {
+        // Page full: erased, as on the target
+        memset(page, 0xFF, mock::SETTINGS_PAGE_SIZE);
+        slot = 0;
+    }
+    memcpy(&page[slot], settings, sizeof(Settings));
+    return true;
+}
+
+} // namespace sys
@@ -0,0 +1,21 @@
+#include "../../Core/serre/system/watchdog/inc/watchdog.hh"
+
+#include "board.hh"
+
+namespace sys {
+
+uint32_t watchdogReadResetFlags() {
+    uint32_t csr = mock::board().resetFlags;
+    mock::board().resetFlags = 0;
+    return csr;
+}
+
+void watchdogStart(uint32_t timeoutMs) {
+    mock::board().watchdogTimeoutMs = timeoutMs;
+}
+
+void watchdogRefresh() {
+    mock::board().watchdogRefreshes++;
+}
+
+} // namespace sys
@@ -0,0 +1,456 @@
+#include "hal_mock.hh"
+
+#include "../../Core/Inc/adc.h"
+#include "../../Core/Inc/i2c.h"
+#include "../../Core/Inc/usart.h"
+
+#include <map>
+#include <string.h>
+
+// CubeMX peripheral handles, defined by Core/Src on the target
+ADC_HandleTypeDef hadc1;
+I2C_HandleTypeDef hi2c1;
+UART_HandleTypeDef huart2;
+
+GPIO_TypeDef mock_gpioA;
+GPIO_TypeDef mock_gpioB;
+GPIO_TypeDef mock_gpioC;
+GPIO_TypeDef mock_gpioF;
+TIM_TypeDef mock_tim2;
+
+uint32_t SystemCoreClock = 16000000UL;
+
+namespace {
+
+constexpr uint32_t RESET_CLOCK_HZ = 16000000UL; // HSI16 after reset
+constexpr uint32_t INPUTS_HIGH = 0xFFFF;        // Pull-ups everywhere
+
+/**
+ * @brief DMA transfer waiting for mock::i2cComplete().
+ */
+struct PendingTransfer {
+    bool active;      ///< A transfer is in flight
+    bool receive;     ///< Read transfer, write otherwise
+    uint8_t address;  ///< 7-bit target address
+    uint8_t *data;    ///< Transfer buffer
+    uint16_t length;  ///< Number of bytes
+};
+
+/**
+ * @brief Conversion results of one ADC channel.
+ */
+struct AdcChannel {
+    uint16_t value;         ///< Result without a stream
+    const uint16_t *stream; ///< Successive results, replayed in a loop
+    size_t count;           ///< Length of the stream
+    size_t next;            ///< Index of the next stream result
+};
+
+uint32_t s_tick = 0;
+void (*s_tickHook)() = nullptr;
+uint32_t s_primask = 0;
+uint32_t s_resetRequests = 0;
+
+std::map<uint32_t, AdcChannel> s_adcChannels;
+HAL_StatusTypeDef s_adcFailStatus = HAL_OK;
+uint8_t s_adcFailCount = 0;
+uint32_t s_adcConversions = 0;
+
+std::string s_uartOutput;
+std::string s_uartInput;
+bool s_uartReady = false;
+
+std::map<uint8_t, mock::I2cDevice *> s_i2cDevices;
+PendingTransfer s_i2cPending = {};
+
+mock::I2cDevice *i2cDevice(uint16_t devAddress) {
+    std::map<uint8_t, mock::I2cDevice *>::iterator it =
+        s_i2cDevices.find(static_cast<uint8_t>(devAddress >> 1));
+    return (it == s_i2cDevices.end()) ? nullptr : it->second;
+}
+
+bool i2cTransfer(uint8_t address, bool receive, uint8_t *data,
+                 uint16_t length) {
+    mock::I2cDevice *device = i2cDevice(static_cast<uint16_t>(address << 1));
+    if (device == nullptr) {
+        return false;
+    }
+    return receive ? device->read(data, length) : device->write(data, length);
+}
+
+HAL_StatusTypeDef i2cStart(I2C_HandleTypeDef *hi2c, uint16_t devAddress,
+                           uint8_t *data, uint16_t size, bool receive) {
+    if (s_i2cPending.active) {
+        return HAL_BUSY;
+    }
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    s_i2cPending.active = true;
+    s_i2cPending.receive = receive;
+    s_i2cPending.address = static_cast<uint8_t>(devAddress >> 1);
+    s_i2cPending.data = data;
+    s_i2cPending.length = size;
+    return HAL_OK;
+}
+
+} // namespace
+
+namespace mock {
+
+I2cDevice::~I2cDevice() {
+}
+
+void halReset() {
+    s_tick = 0;
+    s_tickHook = nullptr;
+    s_primask = 0;
+    s_resetRequests = 0;
+    SystemCoreClock = RESET_CLOCK_HZ;
+
+    GPIO_TypeDef *ports[] = {GPIOA, GPIOB, GPIOC, GPIOF};
+    for (GPIO_TypeDef *port : ports) {
+        port->IDR = INPUTS_HIGH;
+        port->ODR = 0;
+    }
+
+    s_adcChannels.clear();
+    s_adcFailStatus = HAL_OK;
+    s_adcFailCount = 0;
+    s_adcConversions = 0;
+    memset(&hadc1, 0, sizeof(hadc1));
+
+    s_uartOutput.clear();
+    s_uartInput.clear();
+    s_uartReady = false;
+    mock_tim2.CNT = 0;
+
+    s_i2cDevices.clear();
+    s_i2cPending = PendingTransfer();
+    memset(&hi2c1, 0, sizeof(hi2c1));
+}
+
+void halAdvanceMs(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        s_tick++;
+        i2cComplete();
+        if (s_tickHook != nullptr) {
+            s_tickHook();
+        }
+    }
+}
+
+void halSetTickHook(void (*hook)()) {
+    s_tickHook = hook;
+}
+
+void adcSetValue(uint32_t channel, uint16_t value) {
+    AdcChannel adc = {value, nullptr, 0, 0};
+    s_adcChannels[channel] = adc;
+}
+
+void adcSetStream(uint32_t channel, const uint16_t *values, size_t count) {
+    AdcChannel adc = {0, values, count, 0};
+    s_adcChannels[channel] = adc;
+}
+
+void adcFailNext(HAL_StatusTypeDef status, uint8_t count) {
+    s_adcFailStatus = status;
+    s_adcFailCount = count;
+}
+
+uint32_t adcConversions() {
+    return s_adcConversions;
+}
+
+void gpioSetInput(GPIO_TypeDef *port, uint16_t pin, bool high) {
+    bool wasHigh = (port->IDR & pin) != 0;
+    if (high) {
+        port->IDR |= pin;
+    } else {
+        port->IDR &= ~static_cast<uint32_t>(pin);
+    }
+    if (high && !wasHigh) {
+        HAL_GPIO_EXTI_Rising_Callback(pin);
+    } else if (!high && wasHigh) {
+        HAL_GPIO_EXTI_Falling_Callback(pin);
+    }
+}
+
+bool gpioOutput(GPIO_TypeDef *port, uint16_t pin) {
+    return (port->ODR & pin) != 0;
+}
+
+const std::string &uartOutput() {
+    return s_uartOutput;
+}
+
+void uartClear() {
+    s_uartOutput.clear();
+}
+
+void uartInput(const std::string &text) {
+    s_uartInput += text;
+}
+
+void i2cAttach(uint8_t address, I2cDevice *device) {
+    if (device == nullptr) {
+        s_i2cDevices.erase(address);
+    } else {
+        s_i2cDevices[address] = device;
+    }
+}
+
+bool i2cPending() {
+    return s_i2cPending.active;
+}
+
+bool i2cComplete() {
+    if (!s_i2cPending.active) {
+        return false;
+    }
+    // The callback may start the next transfer
+    PendingTransfer transfer = s_i2cPending;
+    s_i2cPending.active = false;
+    if (!i2cTransfer(transfer.address, transfer.receive, transfer.data,
+                     transfer.length)) {
+        hi2c1.ErrorCode = HAL_I2C_ERROR_AF;
+        HAL_I2C_ErrorCallback(&hi2c1);
+    } else if (transfer.receive) {
+        HAL_I2C_MasterRxCpltCallback(&hi2c1);
+    } else {
+        HAL_I2C_MasterTxCpltCallback(&hi2c1);
+    }
+    return true;
+}
+
+uint32_t resetRequests() {
+    return s_resetRequests;
+}
+
+} // namespace mock
+
+extern "C" {
+
+/* Tick ----------------------------------------------------------------------*/
+
+uint32_t HAL_GetTick(void) {
+    return s_tick;
+}
+
+void HAL_Delay(uint32_t Delay) {
+    mock::halAdvanceMs(Delay);
+}
+
+/* GPIO ----------------------------------------------------------------------*/
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    return ((GPIOx->IDR & GPIO_Pin) != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState) {
+    if (PinState == GPIO_PIN_SET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~static_cast<uint32_t>(GPIO_Pin);
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR ^= GPIO_Pin;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+/* ADC -----------------------------------------------------------------------*/
+
+void MX_ADC1_Init(void) {
+    memset(&hadc1, 0, sizeof(hadc1));
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc,
+                                        ADC_ChannelConfTypeDef *sConfig) {
+    hadc->Channel = sConfig->Channel;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc) {
+    hadc->State = 1;
+    s_adcConversions++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc,
+                                            uint32_t Timeout) {
+    (void)hadc;
+    (void)Timeout;
+    if (s_adcFailCount > 0) {
+        s_adcFailCount--;
+        return s_adcFailStatus;
+    }
+    return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc) {
+    std::map<uint32_t, AdcChannel>::iterator it =
+        s_adcChannels.find(hadc->Channel);
+    if (it == s_adcChannels.end()) {
+        return 0;
+    }
+    AdcChannel &adc = it->second;
+    if (adc.count == 0) {
+        return adc.value;
+    }
+    uint16_t value = adc.stream[adc.next];
+    adc.next = (adc.next + 1) % adc.count;
+    return value;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc) {
+    hadc->State = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_DeInit(ADC_HandleTypeDef *hadc) {
+    memset(hadc, 0, sizeof(*hadc));
+    return HAL_OK;
+}
+
+/* UART ----------------------------------------------------------------------*/
+
+void MX_USART2_UART_Init(void) {
+    huart2.Init.BaudRate = 115200;
+    s_uartReady = true;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout) {
+    (void)huart;
+    (void)Timeout;
+    // Like the HAL, refuse to use the peripheral before its init
+    if (!s_uartReady) {
+        return HAL_BUSY;
+    }
+    s_uartOutput.append(reinterpret_cast<const char *>(pData), Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+    (void)huart;
+    (void)Timeout;
+    if (!s_uartReady) {
+        return HAL_BUSY;
+    }
+    if (s_uartInput.size() < Size) {
+        return HAL_TIMEOUT;
+    }
+    memcpy(pData, s_uartInput.data(), Size);
+    s_uartInput.erase(0, Size);
+    return HAL_OK;
+}
+
+/* I2C -----------------------------------------------------------------------*/
+
+void MX_I2C1_Init(void) {
+    memset(&hi2c1, 0, sizeof(hi2c1));
+    hi2c1.Init.Timing = main_serre_i2cTiming();
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c) {
+    s_i2cPending.active = false;
+    memset(hi2c, 0, sizeof(*hi2c));
+    return HAL_OK;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c) {
+    return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress, uint32_t Trials,
+                                        uint32_t Timeout) {
+    (void)hi2c;
+    (void)Trials;
+    (void)Timeout;
+    return (i2cDevice(DevAddress) != nullptr) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c,
+                                          uint16_t DevAddress,
+                                          uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout) {
+    (void)Timeout;
+    if (!i2cTransfer(static_cast<uint8_t>(DevAddress >> 1), false, pData,
+                     Size)) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c,
+                                         uint16_t DevAddress, uint8_t *pData,
+                                         uint16_t Size, uint32_t Timeout) {
+    (void)Timeout;
+    if (!i2cTransfer(static_cast<uint8_t>(DevAddress >> 1), true, pData,
+                     Size)) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c,
+                                                  uint16_t DevAddress,
+                                                  uint8_t *pData,
+                                                  uint16_t Size,
+                                                  uint32_t XferOptions) {
+    (void)XferOptions;
+    return i2cStart(hi2c, DevAddress, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c,
+                                                 uint16_t DevAddress,
+                                                 uint8_t *pData, uint16_t Size,
+                                                 uint32_t XferOptions) {
+    (void)XferOptions;
+    return i2cStart(hi2c, DevAddress, pData, Size, true);
+}
+
+/* RCC and core --------------------------------------------------------------*/
+
+uint32_t HAL_RCC_GetPCLK1Freq(void) {
+    return SystemCoreClock;
+}
+
+void NVIC_SystemReset(void) {
+    // The test goes on: callers must not rely on the reset happening
+    s_resetRequests++;
+}
+
+void __disable_irq(void) {
+    s_primask = 1;
+}
+
+void __enable_irq(void) {
+    s_primask = 0;
+}
+
+uint32_t __get_PRIMASK(void) {
+    return s_primask;
+}
+
+void __set_PRIMASK(uint32_t priMask) {
+    s_primask = priMask;
+}
+
+void __WFI(void) {
+    // The next interrupt is the SysTick
+    mock::halAdvanceMs(1);
+}
+
+} // extern "C"
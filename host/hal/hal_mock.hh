@@ -0,0 +1,155 @@
+#ifndef HAL_MOCK_HH
+#define HAL_MOCK_HH
+
+// Includes
+#include "stm32g0xx_hal.h"
+
+#include <string>
+
+/**
+ * @namespace mock
+ * @brief Simulated board behind the host build of the firmware.
+ */
+namespace mock {
+
+/**
+ * @class I2cDevice
+ * @brief Target attached to the simulated I2C1 bus.
+ *
+ * Each transfer addressed to the device is passed whole to write() or
+ * read(); returning false NACKs it.
+ */
+class I2cDevice {
+  public:
+    /**
+     * @brief Virtual destructor for I2cDevice.
+     */
+    virtual ~I2cDevice();
+
+    /**
+     * @brief Receives a write transfer.
+     * @param data Bytes written by the controller.
+     * @param length Number of bytes.
+     * @return False to NACK the transfer.
+     */
+    virtual bool write(const uint8_t *data, uint16_t length) = 0;
+
+    /**
+     * @brief Answers a read transfer.
+     * @param[out] data Buffer to fill.
+     * @param length Number of bytes requested.
+     * @return False to NACK the transfer.
+     */
+    virtual bool read(uint8_t *data, uint16_t length) = 0;
+};
+
+/**
+ * @brief Puts the tick, the peripherals and the call counters back to
+ * their power-on state; inputs read high (pull-ups), USART2 refuses
+ * transfers until MX_USART2_UART_Init() and no device is attached to the
+ * I2C bus.
+ */
+void halReset();
+
+/**
+ * @brief Advances the tick, one millisecond at a time. Each step completes
+ * the pending I2C transfer, then calls the tick hook like SysTick would.
+ * @param ms Number of milliseconds.
+ */
+void halAdvanceMs(uint32_t ms);
+
+/**
+ * @brief Sets the function called on every simulated SysTick.
+ * @param hook Tick handler, nullptr for none.
+ */
+void halSetTickHook(void (*hook)());
+
+/**
+ * @brief Sets the result of the conversions on an ADC channel.
+ * @param channel ADC_CHANNEL_* value.
+ * @param value 12-bit conversion result.
+ */
+void adcSetValue(uint32_t channel, uint16_t value);
+
+/**
+ * @brief Replays a sequence of results on an ADC channel, in a loop.
+ * @param channel ADC_CHANNEL_* value.
+ * @param values 12-bit conversion results, must outlive the replay.
+ * @param count Number of results.
+ */
+void adcSetStream(uint32_t channel, const uint16_t *values, size_t count);
+
+/**
+ * @brief Makes the next conversions fail.
+ * @param status Returned by HAL_ADC_PollForConversion().
+ * @param count Number of failed conversions.
+ */
+void adcFailNext(HAL_StatusTypeDef status, uint8_t count);
+
+/**
+ * @brief Gets the number of conversions started.
+ * @return Calls to HAL_ADC_Start() since halReset().
+ */
+uint32_t adcConversions();
+
+/**
+ * @brief Drives an input pin, calling the EXTI callback on a change.
+ * @param port GPIO port.
+ * @param pin GPIO_PIN_* mask.
+ * @param high New level.
+ */
+void gpioSetInput(GPIO_TypeDef *port, uint16_t pin, bool high);
+
+/**
+ * @brief Reads back an output pin.
+ * @param port GPIO port.
+ * @param pin GPIO_PIN_* mask.
+ * @return Level last written by the firmware.
+ */
+bool gpioOutput(GPIO_TypeDef *port, uint16_t pin);
+
+/**
+ * @brief Gets what the firmware sent on USART2.
+ * @return Bytes transmitted since the last uartClear().
+ */
+const std::string &uartOutput();
+
+/**
+ * @brief Forgets the USART2 output.
+ */
+void uartClear();
+
+/**
+ * @brief Queues bytes for the firmware to read from USART2.
+ * @param text Bytes received, appended to the pending ones.
+ */
+void uartInput(const std::string &text);
+
+/**
+ * @brief Attaches a device to the I2C1 bus.
+ * @param address 7-bit address.
+ * @param device Device model, nullptr to detach.
+ */
+void i2cAttach(uint8_t address, I2cDevice *device);
+
+/**
+ * @brief Checks if a DMA transfer waits for completion.
+ * @return True between a Seq_*_DMA call and its callback.
+ */
+bool i2cPending();
+
+/**
+ * @brief Completes the pending DMA transfer and calls its callback.
+ * @return False if no transfer was pending.
+ */
+bool i2cComplete();
+
+/**
+ * @brief Gets the number of NVIC_SystemReset() calls.
+ * @return Resets requested since halReset().
+ */
+uint32_t resetRequests();
+
+} // namespace mock
+
+#endif // HAL_MOCK_HH
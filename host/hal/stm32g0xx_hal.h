@@ -0,0 +1,217 @@
+#ifndef STM32G0XX_HAL_H
+#define STM32G0XX_HAL_H
+
+/**
+ * @file stm32g0xx_hal.h
+ * @brief Host stand-in for the STM32G0 HAL.
+ *
+ * First on the include path of the host build, so that the CubeMX headers
+ * (main.h, adc.h, usart.h, ...) pull in this file instead of the vendor one.
+ * It declares the subset of the HAL the firmware uses; hal_mock.cc
+ * implements it on top of simulated ADC, GPIO, UART, I2C and tick state
+ * that the tests drive through hal_mock.hh.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+/* Tick ----------------------------------------------------------------------*/
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+/* GPIO ----------------------------------------------------------------------*/
+
+typedef struct {
+    volatile uint32_t IDR; /* Input levels, set by the tests */
+    volatile uint32_t ODR; /* Output levels, set by the firmware */
+} GPIO_TypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0U, GPIO_PIN_SET } GPIO_PinState;
+
+extern GPIO_TypeDef mock_gpioA;
+extern GPIO_TypeDef mock_gpioB;
+extern GPIO_TypeDef mock_gpioC;
+extern GPIO_TypeDef mock_gpioF;
+
+#define GPIOA (&mock_gpioA)
+#define GPIOB (&mock_gpioB)
+#define GPIOC (&mock_gpioC)
+#define GPIOF (&mock_gpioF)
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+#define GPIO_MODE_INPUT 0x00U
+#define GPIO_MODE_OUTPUT_PP 0x01U
+#define GPIO_MODE_OUTPUT_OD 0x11U
+#define GPIO_NOPULL 0x00U
+#define GPIO_SPEED_FREQ_LOW 0x00U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+
+/* Called by the mock when an input level changes, as the EXTI would */
+void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin);
+
+/* ADC -----------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Channel;      /* Selected by HAL_ADC_ConfigChannel() */
+    uint32_t State;        /* Nonzero while a conversion runs */
+} ADC_HandleTypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+} ADC_ChannelConfTypeDef;
+
+#define ADC_CHANNEL_0 0U
+#define ADC_CHANNEL_1 1U
+#define ADC_CHANNEL_TEMPSENSOR 12U
+#define ADC_CHANNEL_VREFINT 13U
+#define ADC_REGULAR_RANK_1 0U
+#define ADC_SAMPLINGTIME_COMMON_1 0U
+#define ADC_SAMPLINGTIME_COMMON_2 1U
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc,
+                                        ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc,
+                                            uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_DeInit(ADC_HandleTypeDef *hadc);
+
+/* UART ----------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+typedef struct {
+    UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout);
+
+/* I2C -----------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Timing;
+} I2C_InitTypeDef;
+
+typedef struct {
+    I2C_InitTypeDef Init;
+    uint32_t ErrorCode;    /* HAL_I2C_ERROR_* of the last failed transfer */
+} I2C_HandleTypeDef;
+
+#define HAL_I2C_ERROR_NONE 0x00U
+#define HAL_I2C_ERROR_BERR 0x01U
+#define HAL_I2C_ERROR_AF 0x04U
+#define HAL_I2C_ERROR_TIMEOUT 0x20U
+
+#define I2C_FIRST_FRAME 0x00000000U
+#define I2C_FIRST_AND_LAST_FRAME 0x02000000U
+#define I2C_LAST_FRAME 0x02002000U
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress, uint32_t Trials,
+                                        uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c,
+                                          uint16_t DevAddress,
+                                          uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c,
+                                         uint16_t DevAddress, uint8_t *pData,
+                                         uint16_t Size, uint32_t Timeout);
+
+/* Completed by mock::i2cComplete(), from the simulated interrupt context */
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c,
+                                                  uint16_t DevAddress,
+                                                  uint8_t *pData,
+                                                  uint16_t Size,
+                                                  uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c,
+                                                 uint16_t DevAddress,
+                                                 uint8_t *pData, uint16_t Size,
+                                                 uint32_t XferOptions);
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+/* TIM -----------------------------------------------------------------------*/
+
+typedef struct {
+    volatile uint32_t CNT; /* Left to the tests, the mock does not count */
+} TIM_TypeDef;
+
+extern TIM_TypeDef mock_tim2;
+
+#define TIM2 (&mock_tim2)
+
+/* RCC and core --------------------------------------------------------------*/
+
+extern uint32_t SystemCoreClock;
+
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+void NVIC_SystemReset(void);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __WFI(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32G0XX_HAL_H */
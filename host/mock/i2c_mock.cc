@@ -0,0 +1,136 @@
+#include "i2c_mock.hh"
+
+#include <stdio.h>
+
+namespace mock {
+
+void MockI2cPort::attach(bus::I2cEngine *engine) {
+    this->m_engine = engine;
+}
+
+void MockI2cPort::queueReply(I2cReply reply) {
+    this->m_replies.push_back(reply);
+}
+
+void MockI2cPort::queueRead(const std::vector<uint8_t> &data) {
+    this->m_reads.push_back(data);
+}
+
+bool MockI2cPort::complete() {
+    if (!this->inProgress || (this->m_engine == nullptr)) {
+        return false;
+    }
+    I2cReply reply = I2cReply::ACK;
+    if (!this->m_replies.empty()) {
+        reply = this->m_replies.front();
+        this->m_replies.pop_front();
+    }
+    if (reply == I2cReply::SILENT) {
+        return false;
+    }
+    this->inProgress = false;
+    switch (reply) {
+    case I2cReply::NACK:
+        this->m_engine->onTransferDone(bus::I2cTransferStatus::NACK);
+        break;
+    case I2cReply::ERROR:
+        this->m_engine->onTransferDone(bus::I2cTransferStatus::ERROR);
+        break;
+    default:
+        this->m_engine->onTransferDone(bus::I2cTransferStatus::DONE);
+        break;
+    }
+    return true;
+}
+
+const std::vector<I2cTraceEntry> &MockI2cPort::trace() const {
+    return this->m_trace;
+}
+
+std::string MockI2cPort::traceText() const {
+    static const char names[] = {'W', 'R', 'A', 'X'};
+    std::string text;
+    char field[8];
+    for (const I2cTraceEntry &entry : this->m_trace) {
+        text += names[static_cast<uint8_t>(entry.op)];
+        if ((entry.op == I2cOp::WRITE) || (entry.op == I2cOp::READ)) {
+            snprintf(field, sizeof(field), " %02X", entry.address);
+            text += field;
+            for (uint8_t byte : entry.data) {
+                snprintf(field, sizeof(field), " %02X", byte);
+                text += field;
+            }
+            if ((entry.op == I2cOp::WRITE) && !entry.stop) {
+                text += " +";
+            }
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void MockI2cPort::clearTrace() {
+    this->m_trace.clear();
+}
+
+bool MockI2cPort::transmit(uint8_t address, const uint8_t *data,
+                           uint16_t length, bool stop) {
+    if (this->refuse) {
+        return false;
+    }
+    I2cTraceEntry entry = {I2cOp::WRITE, address,
+                           std::vector<uint8_t>(data, data + length), stop};
+    this->m_trace.push_back(entry);
+    this->inProgress = true;
+    return true;
+}
+
+bool MockI2cPort::receive(uint8_t address, uint8_t *data, uint16_t length) {
+    if (this->refuse) {
+        return false;
+    }
+    std::vector<uint8_t> bytes(length, 0);
+    if (!this->m_reads.empty()) {
+        const std::vector<uint8_t> &scripted = this->m_reads.front();
+        for (uint16_t i = 0; (i < length) && (i < scripted.size()); i++) {
+            bytes[i] = scripted[i];
+        }
+        this->m_reads.pop_front();
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = bytes[i];
+    }
+    I2cTraceEntry entry = {I2cOp::READ, address, bytes, true};
+    this->m_trace.push_back(entry);
+    this->inProgress = true;
+    return true;
+}
+
+void MockI2cPort::abort() {
+    I2cTraceEntry entry = {I2cOp::ABORT, 0, {}, true};
+    this->m_trace.push_back(entry);
+    this->inProgress = false;
+}
+
+bool MockI2cPort::isBusStuck() const {
+    return this->stuck;
+}
+
+bool MockI2cPort::recoverBus() {
+    I2cTraceEntry entry = {I2cOp::RECOVER, 0, {}, true};
+    this->m_trace.push_back(entry);
+    this->stuck = false;
+    return true;
+}
+
+uint32_t MockI2cPort::nowMs() const {
+    return this->now;
+}
+
+void MockI2cPort::lock() {
+}
+
+void MockI2cPort::unlock() {
+}
+
+} // namespace mock
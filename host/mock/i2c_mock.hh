@@ -0,0 +1,122 @@
+#ifndef I2C_MOCK_HH
+#define I2C_MOCK_HH
+
+// Includes
+#include "../../Core/serre/driver/i2c/inc/i2c_bus.hh"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace mock
+ * @brief Host-side doubles of the firmware hardware layers.
+ */
+namespace mock {
+
+/**
+ * @brief Operation recorded by the mock I2C port.
+ */
+enum class I2cOp : uint8_t {
+    WRITE = 0, ///< transmit()
+    READ,      ///< receive()
+    ABORT,     ///< abort()
+    RECOVER    ///< recoverBus()
+};
+
+/**
+ * @brief How the simulated device answers the next transfer phase.
+ */
+enum class I2cReply : uint8_t {
+    ACK = 0, ///< Completes normally
+    NACK,    ///< Not acknowledged
+    ERROR,   ///< Bus error
+    SILENT   ///< Never completes, left to the engine timeout
+};
+
+/**
+ * @brief One recorded port operation.
+ */
+struct I2cTraceEntry {
+    I2cOp op;                  ///< Operation
+    uint8_t address;           ///< 7-bit address, 0 for ABORT/RECOVER
+    std::vector<uint8_t> data; ///< Bytes written or returned
+    bool stop;                 ///< WRITE ended with a STOP
+};
+
+/**
+ * @class MockI2cPort
+ * @brief Scripted I2C port recording every transfer.
+ *
+ * Transfers are asynchronous like on the target: they stay in progress
+ * until the test calls complete(), which plays the next scripted reply.
+ * Reads return the bytes given to queueRead(), zeros otherwise.
+ */
+class MockI2cPort final : public bus::I2cPort {
+  public:
+    /**
+     * @brief Connects the engine receiving the completions.
+     * @param engine Engine driving this port.
+     */
+    void attach(bus::I2cEngine *engine);
+
+    /**
+     * @brief Scripts the outcome of a coming transfer phase.
+     * @param reply Outcome, phases without script complete with ACK.
+     */
+    void queueReply(I2cReply reply);
+
+    /**
+     * @brief Scripts the bytes returned by a coming read.
+     * @param data Bytes of the device.
+     */
+    void queueRead(const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Ends the transfer in progress with its scripted reply.
+     * @return False if no transfer is in progress or its reply is SILENT.
+     */
+    bool complete();
+
+    /**
+     * @brief Gets the recorded operations.
+     * @return Trace, oldest first.
+     */
+    const std::vector<I2cTraceEntry> &trace() const;
+
+    /**
+     * @brief Renders the trace, one operation per line, e.g. "W 44 FD".
+     * @return Trace text.
+     */
+    std::string traceText() const;
+
+    /**
+     * @brief Forgets the recorded operations.
+     */
+    void clearTrace();
+
+    bool transmit(uint8_t address, const uint8_t *data, uint16_t length,
+                  bool stop) override;
+    bool receive(uint8_t address, uint8_t *data, uint16_t length) override;
+    void abort() override;
+    bool isBusStuck() const override;
+    bool recoverBus() override;
+    uint32_t nowMs() const override;
+    void lock() override;
+    void unlock() override;
+
+    uint32_t now = 0;        ///< Time returned by nowMs().
+    bool stuck = false;      ///< Lines held low, until recoverBus().
+    bool refuse = false;     ///< transmit()/receive() fail to start.
+    bool inProgress = false; ///< A transfer phase is running.
+
+  private:
+    bus::I2cEngine *m_engine = nullptr;       ///< Completion target.
+    std::deque<I2cReply> m_replies;           ///< Scripted outcomes.
+    std::deque<std::vector<uint8_t>> m_reads; ///< Scripted read data.
+    std::vector<I2cTraceEntry> m_trace;       ///< Recorded operations.
+};
+
+} // namespace mock
+
+#endif // I2C_MOCK_HH
@@ -0,0 +1,180 @@
+#include "greenhouse_sim.hh"
+
+#include "../hal/hal_mock.hh"
+
+#include <math.h>
+
+namespace sim {
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+constexpr float DAY_SECONDS = 86400.0f;
+constexpr float MAX_STEP_S = 10.0f; ///< Well below the fastest time constant
+constexpr float ADC_FULL_SCALE = 4095.0f;
+constexpr float ADC_VREF = 3.3f;
+
+// Analog probe of TempSensor: 0.5 V at 0 °C, 10 mV/°C
+constexpr float PROBE_OFFSET_V = 0.5f;
+constexpr float PROBE_V_PER_C = 0.01f;
+
+uint16_t toAdc(float counts) {
+    if (counts <= 0.0f) {
+        return 0;
+    }
+    if (counts >= ADC_FULL_SCALE) {
+        return 4095;
+    }
+    return static_cast<uint16_t>(counts + 0.5f);
+}
+
+} // namespace
+
+Plant defaultPlant() {
+    Plant plant = {};
+    plant.thermalMassJPerK = 150000.0f;
+    plant.wallLossWPerK = 15.0f;
+    plant.fanLossWPerK = 120.0f;
+    plant.solarPeakW = 600.0f;
+    plant.outsideMeanC = 18.0f;
+    plant.outsideSwingC = 6.0f;
+    plant.fanPowerW = 15.0f;
+    plant.evaporationPctPerHour = 1.5f;
+    plant.evaporationPerK = 0.05f;
+    plant.pumpLitersPerMin = 2.0f;
+    plant.moisturePctPerLiter = 2.0f;
+    plant.soakTimeS = 600.0f;
+    return plant;
+}
+
+GreenhouseSim::GreenhouseSim(Plant plant, Wiring wiring, float tempC,
+                             float moisturePct, float startHour) {
+    this->m_plant = plant;
+    this->m_wiring = wiring;
+    this->m_tempC = tempC;
+    this->m_moisture = moisturePct;
+    this->m_daySeconds = fmodf(startHour * 3600.0f, DAY_SECONDS);
+    this->m_metrics.tempMinC = tempC;
+    this->m_metrics.tempMaxC = tempC;
+    this->m_metrics.moistureMinPct = moisturePct;
+    this->m_metrics.moistureMaxPct = moisturePct;
+    this->publish();
+}
+
+void GreenhouseSim::step(float seconds) {
+    bool fanOn =
+        mock::gpioOutput(this->m_wiring.fanPort, this->m_wiring.fanPin);
+    bool pumpOn =
+        mock::gpioOutput(this->m_wiring.pumpPort, this->m_wiring.pumpPin);
+    if (fanOn && !this->m_fanOn) {
+        this->m_metrics.fanStarts++;
+    }
+    if (pumpOn && !this->m_pumpOn) {
+        this->m_metrics.pumpStarts++;
+    }
+    this->m_fanOn = fanOn;
+    this->m_pumpOn = pumpOn;
+
+    while (seconds > 0.0f) {
+        float dt = (seconds > MAX_STEP_S) ? MAX_STEP_S : seconds;
+        this->integrate(dt, fanOn, pumpOn);
+        seconds -= dt;
+    }
+    this->publish();
+}
+
+float GreenhouseSim::temperatureC() const {
+    return this->m_tempC;
+}
+
+float GreenhouseSim::moisturePct() const {
+    return this->m_moisture;
+}
+
+float GreenhouseSim::outsideC() const {
+    // Coldest at 3 h, warmest at 15 h
+    float phase = 2.0f * PI * (this->m_daySeconds / DAY_SECONDS - 0.375f);
+    return this->m_plant.outsideMeanC +
+           this->m_plant.outsideSwingC * sinf(phase);
+}
+
+const Metrics &GreenhouseSim::metrics() const {
+    return this->m_metrics;
+}
+
+// Explicit Euler: the step stays far below the thermal and soak time
+// constants (minutes), which keeps it stable and cheap.
+void GreenhouseSim::integrate(float seconds, bool fanOn, bool pumpOn) {
+    const Plant &plant = this->m_plant;
+
+    // Air: sun in, losses through the walls and the fan out
+    float hour = this->m_daySeconds / 3600.0f;
+    float solar = 0.0f;
+    if ((hour > 6.0f) && (hour < 18.0f)) {
+        solar = plant.solarPeakW * sinf(PI * (hour - 6.0f) / 12.0f);
+    }
+    float loss = plant.wallLossWPerK + (fanOn ? plant.fanLossWPerK : 0.0f);
+    float power = solar + loss * (this->outsideC() - this->m_tempC);
+    this->m_tempC += power * seconds / plant.thermalMassJPerK;
+
+    // Soil: evaporation grows with the heat, pumped water soaks in slowly
+    float evaporation =
+        1.0f + plant.evaporationPerK * (this->m_tempC - 20.0f);
+    if (evaporation < 0.0f) {
+        evaporation = 0.0f;
+    }
+    this->m_moisture -=
+        plant.evaporationPctPerHour * evaporation * seconds / 3600.0f;
+    if (pumpOn) {
+        float liters = plant.pumpLitersPerMin * seconds / 60.0f;
+        this->m_surfaceL += liters;
+        this->m_metrics.waterLiters += liters;
+    }
+    float soaked =
+        this->m_surfaceL * (1.0f - expf(-seconds / plant.soakTimeS));
+    this->m_surfaceL -= soaked;
+    this->m_moisture += soaked * plant.moisturePctPerLiter;
+    if (this->m_moisture < 0.0f) {
+        this->m_moisture = 0.0f;
+    } else if (this->m_moisture > 100.0f) {
+        this->m_moisture = 100.0f;
+    }
+
+    this->m_daySeconds = fmodf(this->m_daySeconds + seconds, DAY_SECONDS);
+
+    Metrics &metrics = this->m_metrics;
+    metrics.seconds += seconds;
+    if (fanOn) {
+        metrics.fanOnSeconds += seconds;
+        metrics.fanEnergyWh += plant.fanPowerW * seconds / 3600.0f;
+    }
+    metrics.tempMinC = fminf(metrics.tempMinC, this->m_tempC);
+    metrics.tempMaxC = fmaxf(metrics.tempMaxC, this->m_tempC);
+    metrics.moistureMinPct = fminf(metrics.moistureMinPct, this->m_moisture);
+    metrics.moistureMaxPct = fmaxf(metrics.moistureMaxPct, this->m_moisture);
+}
+
+void GreenhouseSim::publish() {
+    float volts = PROBE_OFFSET_V + PROBE_V_PER_C * this->m_tempC;
+    float temp = volts * ADC_FULL_SCALE / ADC_VREF;
+    mock::adcSetValue(this->m_wiring.tempChannel, toAdc(temp + this->noise()));
+
+    float dry = static_cast<float>(this->m_wiring.soilDryRaw);
+    float wet = static_cast<float>(this->m_wiring.soilWetRaw);
+    float soil = dry - (dry - wet) * this->m_moisture / 100.0f;
+    mock::adcSetValue(this->m_wiring.soilChannel, toAdc(soil + this->noise()));
+}
+
+// xorshift32: the same noise on every run keeps the tests reproducible
+float GreenhouseSim::noise() {
+    uint32_t x = this->m_noiseState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    this->m_noiseState = x;
+    float unit = static_cast<float>(x) / 4294967296.0f; // [0, 1)
+    return (2.0f * unit - 1.0f) *
+           static_cast<float>(this->m_wiring.noiseCounts);
+}
+
+} // namespace sim
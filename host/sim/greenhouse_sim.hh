@@ -0,0 +1,211 @@
+#ifndef GREENHOUSE_SIM_HH
+#define GREENHOUSE_SIM_HH
+
+// Includes
+#include "../hal/stm32g0xx_hal.h"
+
+/**
+ * @namespace sim
+ * @brief Physical models closing the loop around the host build.
+ */
+namespace sim {
+
+/**
+ * @brief Physical constants of the simulated greenhouse.
+ *
+ * @struct Plant
+ * @var float thermalMassJPerK
+ *      Heat capacity of the air, benches and soil, in J/K.
+ * @var float wallLossWPerK
+ *      Heat lost through the walls per kelvin above outside, in W/K.
+ * @var float fanLossWPerK
+ *      Extra heat removed by the running fan per kelvin, in W/K.
+ * @var float solarPeakW
+ *      Heat gained at noon, in W. Half a sine from 6 h to 18 h.
+ * @var float outsideMeanC
+ *      Average outside temperature, in °C.
+ * @var float outsideSwingC
+ *      Amplitude of the daily outside swing, coldest at 3 h, in °C.
+ * @var float fanPowerW
+ *      Electrical power of the fan, in W.
+ * @var float evaporationPctPerHour
+ *      Soil moisture lost per hour at 20 °C, in percent.
+ * @var float evaporationPerK
+ *      Relative evaporation increase per kelvin above 20 °C.
+ * @var float pumpLitersPerMin
+ *      Pump flow, in L/min.
+ * @var float moisturePctPerLiter
+ *      Soil moisture gained per liter soaked in, in percent.
+ * @var float soakTimeS
+ *      Time constant of the water soaking down to the probe, in s.
+ */
+typedef struct {
+    float thermalMassJPerK;      ///< Heat capacity (J/K)
+    float wallLossWPerK;         ///< Wall losses (W/K)
+    float fanLossWPerK;          ///< Fan ventilation (W/K)
+    float solarPeakW;            ///< Heat gain at noon (W)
+    float outsideMeanC;          ///< Average outside temperature (°C)
+    float outsideSwingC;         ///< Daily outside swing (°C)
+    float fanPowerW;             ///< Fan electrical power (W)
+    float evaporationPctPerHour; ///< Moisture loss at 20 °C (%/h)
+    float evaporationPerK;       ///< Evaporation increase per K
+    float pumpLitersPerMin;      ///< Pump flow (L/min)
+    float moisturePctPerLiter;   ///< Moisture gain per liter (%)
+    float soakTimeS;             ///< Soak time constant (s)
+} Plant;
+
+/**
+ * @brief Where the simulated greenhouse meets the mocked board.
+ *
+ * @struct Wiring
+ * @var uint32_t tempChannel
+ *      ADC channel of the analog temperature probe.
+ * @var uint32_t soilChannel
+ *      ADC channel of the soil humidity probe.
+ * @var uint16_t soilDryRaw
+ *      Conversion result of dry soil.
+ * @var uint16_t soilWetRaw
+ *      Conversion result of saturated soil.
+ * @var uint16_t noiseCounts
+ *      Peak noise added to each probe conversion.
+ * @var GPIO_TypeDef *fanPort
+ *      GPIO port of the fan output.
+ * @var uint16_t fanPin
+ *      GPIO pin of the fan output.
+ * @var GPIO_TypeDef *pumpPort
+ *      GPIO port of the pump output.
+ * @var uint16_t pumpPin
+ *      GPIO pin of the pump output.
+ */
+typedef struct {
+    uint32_t tempChannel;   ///< Temperature probe ADC channel
+    uint32_t soilChannel;   ///< Soil probe ADC channel
+    uint16_t soilDryRaw;    ///< Raw value of dry soil
+    uint16_t soilWetRaw;    ///< Raw value of saturated soil
+    uint16_t noiseCounts;   ///< Peak conversion noise
+    GPIO_TypeDef *fanPort;  ///< Fan GPIO port
+    uint16_t fanPin;        ///< Fan GPIO pin
+    GPIO_TypeDef *pumpPort; ///< Pump GPIO port
+    uint16_t pumpPin;       ///< Pump GPIO pin
+} Wiring;
+
+/**
+ * @brief What the controller cost and how well it held the climate.
+ *
+ * @struct Metrics
+ * @var float seconds
+ *      Simulated time.
+ * @var float tempMinC
+ *      Lowest air temperature, in °C.
+ * @var float tempMaxC
+ *      Highest air temperature, in °C.
+ * @var float moistureMinPct
+ *      Lowest soil moisture, in percent.
+ * @var float moistureMaxPct
+ *      Highest soil moisture, in percent.
+ * @var float fanOnSeconds
+ *      Time the fan ran.
+ * @var float fanEnergyWh
+ *      Energy drawn by the fan, in Wh.
+ * @var float waterLiters
+ *      Water pumped.
+ * @var uint32_t fanStarts
+ *      Fan off-to-on transitions.
+ * @var uint32_t pumpStarts
+ *      Pump off-to-on transitions.
+ */
+typedef struct {
+    float seconds;        ///< Simulated time
+    float tempMinC;       ///< Lowest temperature (°C)
+    float tempMaxC;       ///< Highest temperature (°C)
+    float moistureMinPct; ///< Lowest soil moisture (%)
+    float moistureMaxPct; ///< Highest soil moisture (%)
+    float fanOnSeconds;   ///< Fan run time
+    float fanEnergyWh;    ///< Fan energy (Wh)
+    float waterLiters;    ///< Water pumped (L)
+    uint32_t fanStarts;   ///< Fan starts
+    uint32_t pumpStarts;  ///< Pump starts
+} Metrics;
+
+/**
+ * @brief Small hobby greenhouse: 2 m³ of air over a 50 L bench.
+ * @return Plant constants.
+ */
+Plant defaultPlant();
+
+/**
+ * @class GreenhouseSim
+ * @brief Air temperature and soil moisture of a greenhouse, driven by the
+ * fan and pump outputs of the mocked board.
+ *
+ * Each step() reads the FAN and PUMP pins as last written by the firmware,
+ * integrates the model over the step, then sets the probe channels of the
+ * mocked ADC to the voltages the sensors would give, plus a reproducible
+ * uniform noise so that the probe diagnostics see live readings. The
+ * simulated time is independent of HAL_GetTick(): the caller decides when
+ * the firmware code runs, so a week of simulation takes well under a
+ * second.
+ */
+class GreenhouseSim {
+  public:
+    /**
+     * @brief Constructor for GreenhouseSim. Also sets the probe channels.
+     * @param plant Physical constants.
+     * @param wiring Probe channels, soil calibration and actuator pins.
+     * @param tempC Starting air temperature, in °C.
+     * @param moisturePct Starting soil moisture, in percent.
+     * @param startHour Time of day the simulation starts at, in hours.
+     */
+    GreenhouseSim(Plant plant, Wiring wiring, float tempC, float moisturePct,
+                  float startHour);
+
+    /**
+     * @brief Advances the simulation, in sub-steps of at most 10 s.
+     * @param seconds Simulated time.
+     */
+    void step(float seconds);
+
+    /**
+     * @brief Gets the air temperature.
+     * @return Temperature, in °C.
+     */
+    float temperatureC() const;
+
+    /**
+     * @brief Gets the soil moisture at the probe.
+     * @return Moisture, in percent.
+     */
+    float moisturePct() const;
+
+    /**
+     * @brief Gets the outside temperature at the current time.
+     * @return Temperature, in °C.
+     */
+    float outsideC() const;
+
+    /**
+     * @brief Gets the costs and extremes since construction.
+     * @return Accumulated metrics.
+     */
+    const Metrics &metrics() const;
+
+  private:
+    void integrate(float seconds, bool fanOn, bool pumpOn);
+    void publish();
+    float noise();
+
+    Plant m_plant = {};        ///< Physical constants.
+    Wiring m_wiring = {};      ///< Board connection.
+    Metrics m_metrics = {};    ///< Costs and extremes.
+    float m_tempC = 0.0f;      ///< Air temperature (°C).
+    float m_moisture = 0.0f;   ///< Soil moisture at the probe (%).
+    float m_surfaceL = 0.0f;   ///< Water not soaked in yet (L).
+    float m_daySeconds = 0.0f; ///< Time of day (s).
+    bool m_fanOn = false;      ///< Fan state of the previous step.
+    bool m_pumpOn = false;     ///< Pump state of the previous step.
+    uint32_t m_noiseState = 1; ///< Noise generator, fixed seed.
+};
+
+} // namespace sim
+
+#endif // GREENHOUSE_SIM_HH
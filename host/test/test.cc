@@ -0,0 +1,109 @@
+#include "test.hh"
+
+#include "../board/board.hh"
+#include "../hal/hal_mock.hh"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint16_t MAX_TESTS = 256;
+
+/**
+ * @brief Registered test case.
+ */
+struct TestCase {
+    const char *suite;     ///< Group of tests
+    const char *name;      ///< Test name
+    test::TestFunction fn; ///< Test body
+};
+
+TestCase s_tests[MAX_TESTS];
+uint16_t s_testCount = 0;
+uint32_t s_failedChecks = 0;
+
+bool matches(const TestCase &test, const char *filter) {
+    if (filter == nullptr) {
+        return true;
+    }
+    char fullName[128];
+    snprintf(fullName, sizeof(fullName), "%s.%s", test.suite, test.name);
+    return strstr(fullName, filter) != nullptr;
+}
+
+} // namespace
+
+namespace test {
+
+Registrar::Registrar(const char *suite, const char *name,
+                     TestFunction function) {
+    if (s_testCount < MAX_TESTS) {
+        s_tests[s_testCount++] = {suite, name, function};
+    }
+}
+
+bool check(bool passed, const char *file, int line, const char *expression) {
+    if (!passed) {
+        printf("%s:%d: failed: %s\n", file, line, expression);
+        s_failedChecks++;
+    }
+    return passed;
+}
+
+bool checkEqual(int64_t actual, int64_t expected, const char *file, int line,
+                const char *expression) {
+    if (actual != expected) {
+        printf("%s:%d: failed: %s\n    actual %lld, expected %lld\n", file,
+               line, expression, static_cast<long long>(actual),
+               static_cast<long long>(expected));
+        s_failedChecks++;
+        return false;
+    }
+    return true;
+}
+
+bool checkNear(double actual, double expected, double tolerance,
+               const char *file, int line, const char *expression) {
+    double error = actual - expected;
+    if ((error > tolerance) || (error < -tolerance)) {
+        printf("%s:%d: failed: %s\n    actual %g, expected %g +/- %g\n",
+               file, line, expression, actual, expected, tolerance);
+        s_failedChecks++;
+        return false;
+    }
+    return true;
+}
+
+} // namespace test
+
+/**
+ * @brief Runs the registered tests.
+ *
+ * Usage: serre_host_tests [filter], where filter is a substring of
+ * "Suite.name".
+ */
+int main(int argc, char **argv) {
+    const char *filter = (argc > 1) ? argv[1] : nullptr;
+    uint16_t run = 0;
+    uint16_t failed = 0;
+    for (uint16_t i = 0; i < s_testCount; i++) {
+        const TestCase &test = s_tests[i];
+        if (!matches(test, filter)) {
+            continue;
+        }
+        mock::halReset();
+        mock::boardReset();
+        uint32_t failedBefore = s_failedChecks;
+        test.fn();
+        run++;
+        if (s_failedChecks != failedBefore) {
+            printf("[ FAIL ] %s.%s\n", test.suite, test.name);
+            failed++;
+        } else {
+            printf("[   OK ] %s.%s\n", test.suite, test.name);
+        }
+    }
+    printf("%u tests, %u failed\n", run, failed);
+    return (failed == 0) ? 0 : 1;
+}
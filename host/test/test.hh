@@ -0,0 +1,85 @@
+#ifndef TEST_HH
+#define TEST_HH
+
+// Includes
+#include <stdint.h>
+
+/**
+ * @namespace test
+ * @brief Minimal test runner of the host build.
+ *
+ * TEST() registers a function at static initialization; the runner resets
+ * the simulated HAL and board before each test, so tests do not depend on
+ * their order. A failed EXPECT_* is reported and the test goes on, a failed
+ * ASSERT_* returns from the test.
+ */
+namespace test {
+
+typedef void (*TestFunction)();
+
+/**
+ * @brief Registers a test case, used through TEST().
+ */
+class Registrar {
+  public:
+    /**
+     * @brief Constructor for Registrar.
+     * @param suite Name of the group of tests.
+     * @param name Name of the test.
+     * @param function Test body.
+     */
+    Registrar(const char *suite, const char *name, TestFunction function);
+};
+
+/**
+ * @brief Records the outcome of a check.
+ * @param passed Outcome.
+ * @param file Source file of the check.
+ * @param line Source line of the check.
+ * @param expression Text of the checked expression.
+ * @return passed.
+ */
+bool check(bool passed, const char *file, int line, const char *expression);
+
+/**
+ * @brief Records the outcome of an equality check, printing both values.
+ * @return True if the values are equal.
+ */
+bool checkEqual(int64_t actual, int64_t expected, const char *file, int line,
+                const char *expression);
+
+/**
+ * @brief Records the outcome of a tolerance check, printing both values.
+ * @return True if |actual - expected| <= tolerance.
+ */
+bool checkNear(double actual, double expected, double tolerance,
+               const char *file, int line, const char *expression);
+
+} // namespace test
+
+#define TEST(suite, name)                                                      \
+    static void suite##_##name();                                             \
+    static test::Registrar suite##_##name##_registrar(#suite, #name,          \
+                                                      suite##_##name);        \
+    static void suite##_##name()
+
+#define EXPECT_TRUE(condition)                                                 \
+    test::check((condition), __FILE__, __LINE__, #condition)
+#define EXPECT_FALSE(condition)                                                \
+    test::check(!(condition), __FILE__, __LINE__, "!(" #condition ")")
+#define EXPECT_EQ(actual, expected)                                            \
+    test::checkEqual(static_cast<int64_t>(actual),                             \
+                     static_cast<int64_t>(expected), __FILE__, __LINE__,       \
+                     #actual " == " #expected)
+#define EXPECT_NEAR(actual, expected, tolerance)                               \
+    test::checkNear((actual), (expected), (tolerance), __FILE__, __LINE__,     \
+                    #actual " ~ " #expected)
+
+#define ASSERT_TRUE(condition)                                                 \
+    if (!EXPECT_TRUE(condition))                                               \
+    return
+#define ASSERT_EQ(actual, expected)                                            \
+    if (!EXPECT_EQ(actual, expected))                                          \
+    return
+
+#endif // TEST_HH
@@ -0,0 +1,33 @@
+#include "../../Core/serre/control/actuators/inc/actuators.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+namespace {
+
+const control::ActuatorConfig actuatorConfig = {FAN_GPIO_Port, FAN_Pin,
+                                                PUMP_GPIO_Port, PUMP_Pin};
+
+} // namespace
+
+TEST(Actuators, OverrideWinsOverCommand) {
+    control::Actuators actuators(actuatorConfig);
+    actuators.setPump(true);
+    EXPECT_TRUE(mock::gpioOutput(PUMP_GPIO_Port, PUMP_Pin));
+
+    actuators.setPumpOverride(control::Override::OFF);
+    EXPECT_FALSE(actuators.isPumpOn());
+    EXPECT_FALSE(mock::gpioOutput(PUMP_GPIO_Port, PUMP_Pin));
+
+    actuators.setPumpOverride(control::Override::AUTO);
+    EXPECT_TRUE(mock::gpioOutput(PUMP_GPIO_Port, PUMP_Pin));
+}
+
+TEST(Actuators, ScheduledWateringWaitsOnePeriod) {
+    const control::WateringSchedule schedule = {60000, 5000};
+    EXPECT_FALSE(control::scheduledWatering(&schedule, 0));
+    EXPECT_FALSE(control::scheduledWatering(&schedule, 54999));
+    EXPECT_TRUE(control::scheduledWatering(&schedule, 55000));
+    EXPECT_TRUE(control::scheduledWatering(&schedule, 59999));
+    EXPECT_FALSE(control::scheduledWatering(&schedule, 60000));
+    EXPECT_TRUE(control::scheduledWatering(&schedule, 115000));
+}
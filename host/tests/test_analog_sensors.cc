@@ -0,0 +1,229 @@
+#include "../../Core/Inc/adc.h"
+#include "../../Core/serre/driver/sensors/die_temp_sensor/inc/die_temp.hh"
+#include "../../Core/serre/driver/sensors/soil_hum_sensor/inc/soil_hum.hh"
+#include "../../Core/serre/driver/sensors/temp_sensor/inc/temp_sensor.hh"
+#include "../../Core/serre/driver/sensors/trend.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+namespace {
+
+const sensor::SensorConfig tempConfig = {&hadc1, ADC_CHANNEL_0,
+                                         ADC_SAMPLINGTIME_COMMON_1, 10, 1000};
+
+const sensor::SensorConfig dieConfig = {&hadc1, ADC_CHANNEL_TEMPSENSOR,
+                                        ADC_SAMPLINGTIME_COMMON_2, 10, 0};
+
+// 1100 and 1430 at 3.0 V are 1000 and 1300 at the 3.3 V of the board
+const sensor::DieTempCalibration dieCalibration = {1100, 1430};
+
+} // namespace
+
+TEST(TempSensor, ConvertsAverageOfSamples) {
+    sensor::TempSensor temp(tempConfig);
+    // 0.75 V on a 3.3 V, 12-bit scale is 25 °C for a 10 mV/°C, 0.5 V offset
+    mock::adcSetValue(ADC_CHANNEL_0, 900);
+    EXPECT_EQ(temp.readData(), HAL_OK);
+    mock::adcSetValue(ADC_CHANNEL_0, 962);
+    EXPECT_EQ(temp.readData(), HAL_OK);
+    temp.processData();
+
+    EXPECT_NEAR(temp.getTemperatureCelsius(), 25.0, 0.1);
+    EXPECT_TRUE(temp.isTemperatureValid());
+    EXPECT_EQ(mock::adcConversions(), 2);
+}
+
+TEST(TempSensor, ConversionTimeoutKeepsPreviousSamples) {
+    sensor::TempSensor temp(tempConfig);
+    mock::adcSetValue(ADC_CHANNEL_0, 931);
+    EXPECT_EQ(temp.readData(), HAL_OK);
+
+    mock::adcSetValue(ADC_CHANNEL_0, 4095);
+    mock::adcFailNext(HAL_TIMEOUT, 1);
+    EXPECT_EQ(temp.readData(), HAL_TIMEOUT);
+    temp.processData();
+
+    EXPECT_NEAR(temp.getTemperatureCelsius(), 25.0, 0.1);
+}
+
+TEST(TempSensor, OutOfThresholdIsInvalid) {
+    sensor::TempSensor temp(tempConfig);
+    temp.setThreshold(0.0f, 40.0f);
+    mock::adcSetValue(ADC_CHANNEL_0, 1241); // 1.0 V, 50 °C
+    EXPECT_EQ(temp.readData(), HAL_OK);
+    temp.processData();
+
+    EXPECT_NEAR(temp.getTemperatureCelsius(), 50.0, 0.1);
+    EXPECT_FALSE(temp.isTemperatureValid());
+}
+
+TEST(TempSensor, MissingAdcHandle) {
+    sensor::SensorConfig config = tempConfig;
+    config.adcHandle = nullptr;
+    sensor::TempSensor temp(config);
+    EXPECT_EQ(temp.readData(), HAL_ERROR);
+    EXPECT_EQ(mock::adcConversions(), 0);
+}
+
+TEST(SlopeEstimator, ExactOnRampWhileSliding) {
+    sensor::SlopeEstimator trend;
+    EXPECT_EQ(trend.slope(), 0.0f);
+    trend.add(100);
+    EXPECT_EQ(trend.slope(), 0.0f);
+
+    // 3 per point while filling, then after the window wraps several times
+    for (uint16_t i = 1; i < 40; i++) {
+        trend.add(static_cast<uint16_t>(100 + 3 * i));
+        if (i == 5) {
+            EXPECT_NEAR(trend.slope(), 3.0, 1e-6);
+        }
+    }
+    EXPECT_EQ(trend.count(), sensor::SlopeEstimator::WINDOW);
+    EXPECT_NEAR(trend.slope(), 3.0, 1e-6);
+
+    // A step down then flat: the old ramp leaves the window
+    for (uint8_t i = 0; i < sensor::SlopeEstimator::WINDOW; i++) {
+        trend.add(40000);
+    }
+    EXPECT_NEAR(trend.slope(), 0.0, 1e-6);
+
+    trend.reset();
+    EXPECT_EQ(trend.count(), 0);
+}
+
+TEST(TempSensor, TrendFollowsRisingProbe) {
+    sensor::TempSensor temp(tempConfig);
+    // One count per read is 0.0806 °C/s, 4.84 °C/min at one read per second
+    uint16_t value = 900;
+    for (uint8_t i = 0; i < 39; i++) {
+        mock::adcSetValue(ADC_CHANNEL_0, value++);
+        EXPECT_EQ(temp.readData(), HAL_OK);
+    }
+    EXPECT_FALSE(temp.isTrendReady());
+    EXPECT_EQ(temp.getTrendCelsiusPerMinute(), 0.0f);
+
+    mock::adcSetValue(ADC_CHANNEL_0, value++);
+    EXPECT_EQ(temp.readData(), HAL_OK);
+    EXPECT_TRUE(temp.isTrendReady());
+    EXPECT_NEAR(temp.getTrendCelsiusPerMinute(), 4.835, 0.01);
+}
+
+TEST(SoilHumSensor, TrendIsPercentPerHour) {
+    sensor::SensorConfig config = tempConfig;
+    config.samplePeriodMs = 60000;
+    sensor::SoilHumSensor soil(config);
+    soil.calibrate(3000, 1000);
+    // Drying by 2 counts per minute on a 2000-count span: 6 %/h lost
+    uint16_t value = 2000;
+    for (uint8_t i = 0; i < 60; i++) {
+        mock::adcSetValue(ADC_CHANNEL_0, value);
+        value = static_cast<uint16_t>(value + 2);
+        EXPECT_EQ(soil.readData(), HAL_OK);
+    }
+    EXPECT_NEAR(soil.getTrendPercentPerHour(), -6.0, 0.01);
+}
+
+TEST(TempSensor, TrendDisabledWithoutSamplePeriod) {
+    sensor::SensorConfig config = tempConfig;
+    config.samplePeriodMs = 0;
+    sensor::TempSensor temp(config);
+    for (uint8_t i = 0; i < 60; i++) {
+        mock::adcSetValue(ADC_CHANNEL_0, static_cast<uint16_t>(900 + i));
+        temp.readData();
+    }
+    EXPECT_FALSE(temp.isTrendReady());
+    EXPECT_EQ(temp.getTrendCelsiusPerMinute(), 0.0f);
+}
+
+TEST(SoilHumSensor, OpenProbeIsInvalid) {
+    sensor::SoilHumSensor soil(tempConfig);
+    soil.calibrate(3000, 1000);
+    // A disconnected probe reads full scale, which maps to 0 %
+    mock::adcSetValue(ADC_CHANNEL_0, 4095);
+    EXPECT_EQ(soil.readData(), HAL_OK);
+    soil.processData();
+    EXPECT_EQ(soil.probeFault(), sensor::ProbeFault::RAIL);
+    EXPECT_FALSE(soil.isHumidityValid());
+
+    // Valid again once the jump back from the rail leaves the window
+    for (uint8_t i = 0; i < 10; i++) {
+        mock::adcSetValue(ADC_CHANNEL_0, static_cast<uint16_t>(2000 + i % 3));
+        EXPECT_EQ(soil.readData(), HAL_OK);
+    }
+    EXPECT_EQ(soil.probeFault(), sensor::ProbeFault::RATE);
+    EXPECT_EQ(soil.readData(), HAL_OK);
+    soil.processData();
+    EXPECT_EQ(soil.probeFault(), sensor::ProbeFault::NONE);
+    EXPECT_TRUE(soil.isHumidityValid());
+}
+
+TEST(TempSensor, ProbeDiagnostics) {
+    sensor::TempSensor temp(tempConfig);
+    uint16_t live[] = {930, 931, 932, 931};
+    mock::adcSetStream(ADC_CHANNEL_0, live, 4);
+    for (uint8_t i = 0; i < 10; i++) {
+        temp.readData();
+    }
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::NONE);
+
+    // One implausible jump taints the window until it leaves it
+    mock::adcSetValue(ADC_CHANNEL_0, 1200);
+    temp.readData();
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::RATE);
+    temp.processData();
+    EXPECT_FALSE(temp.isTemperatureValid());
+
+    // Loose contact: samples swing within the step limit
+    uint16_t loose[] = {1200, 1140, 1200, 1260};
+    mock::adcSetStream(ADC_CHANNEL_0, loose, 4);
+    for (uint8_t i = 0; i < 10; i++) {
+        temp.readData();
+    }
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::NOISE);
+
+    // Frozen converter: 30 windows without a single count of change
+    mock::adcSetValue(ADC_CHANNEL_0, 1200);
+    for (uint16_t i = 0; i < 299; i++) {
+        temp.readData();
+    }
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::NONE);
+    for (uint16_t i = 0; i < 11; i++) {
+        temp.readData();
+    }
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::STUCK);
+    mock::adcSetValue(ADC_CHANNEL_0, 1201);
+    temp.readData();
+    EXPECT_EQ(temp.probeFault(), sensor::ProbeFault::STUCK);
+}
+
+TEST(DieTempSensor, InterpolatesFactoryCalibration) {
+    sensor::DieTempSensor die(dieConfig, dieCalibration);
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 1000);
+    EXPECT_EQ(die.readData(), HAL_OK);
+    die.processData();
+    EXPECT_EQ(die.getTemperatureTenths(), 300);
+    EXPECT_TRUE(die.isTemperatureValid());
+
+    // Average of 1000 and 1300: halfway between 30 and 130 °C
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 1300);
+    EXPECT_EQ(die.readData(), HAL_OK);
+    die.processData();
+    EXPECT_EQ(die.getTemperatureTenths(), 800);
+    EXPECT_NEAR(die.getTemperatureCelsius(), 80.0f, 0.01f);
+
+    // The hot end is past the 125 °C the die is specified for
+    sensor::DieTempSensor hot(dieConfig, dieCalibration);
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 1300);
+    EXPECT_EQ(hot.readData(), HAL_OK);
+    hot.processData();
+    EXPECT_EQ(hot.getTemperatureTenths(), 1300);
+    EXPECT_FALSE(hot.isTemperatureValid());
+}
+
+TEST(DieTempSensor, BlankCalibrationIsInvalid) {
+    sensor::DieTempSensor die(dieConfig, {0xFFFF, 0xFFFF});
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 1000);
+    EXPECT_EQ(die.readData(), HAL_OK);
+    die.processData();
+    EXPECT_FALSE(die.isTemperatureValid());
+}
@@ -0,0 +1,81 @@
+#include "../../Core/serre/system/pool/inc/block_pool.hh"
+#include "../../Core/serre/system/pool/inc/pool_heap.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+TEST(BlockPool, AllocatesUntilFullThenReuses) {
+    static sys::BlockPool<12, 3> pool;
+    void *first = pool.allocate();
+    void *second = pool.allocate();
+    void *third = pool.allocate();
+    ASSERT_TRUE((first != nullptr) && (second != nullptr) &&
+                (third != nullptr));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % 8, 0);
+    EXPECT_EQ(static_cast<uint8_t *>(second) - static_cast<uint8_t *>(first),
+              16);
+    EXPECT_TRUE(pool.allocate() == nullptr);
+
+    // Last released, first reused
+    EXPECT_TRUE(pool.release(second));
+    EXPECT_TRUE(pool.release(first));
+    EXPECT_TRUE(pool.allocate() == first);
+    EXPECT_TRUE(pool.allocate() == second);
+
+    sys::PoolStats stats = pool.stats();
+    EXPECT_EQ(stats.blockSize, 16);
+    EXPECT_EQ(stats.capacity, 3);
+    EXPECT_EQ(stats.used, 3);
+    EXPECT_EQ(stats.peak, 3);
+    EXPECT_EQ(stats.failures, 1);
+}
+
+TEST(BlockPool, RejectsForeignPointers) {
+    static sys::BlockPool<16, 2> pool;
+    uint8_t *block = static_cast<uint8_t *>(pool.allocate());
+    int local = 0;
+    EXPECT_FALSE(pool.release(&local));
+    EXPECT_FALSE(pool.release(block + 4));
+    EXPECT_TRUE(pool.release(block));
+    EXPECT_EQ(pool.stats().used, 0);
+}
+
+TEST(BlockPool, EmptyPoolRefusesEverything) {
+    static sys::BlockPool<16, 0> pool;
+    EXPECT_TRUE(sizeof(pool) <= sizeof(uint32_t));
+    EXPECT_TRUE(pool.allocate() == nullptr);
+    int local = 0;
+    EXPECT_FALSE(pool.release(&local));
+
+    sys::PoolStats stats = pool.stats();
+    EXPECT_EQ(stats.blockSize, 16);
+    EXPECT_EQ(stats.capacity, 0);
+    EXPECT_EQ(stats.failures, 1);
+}
+
+TEST(BlockPool, SizeClassesFallBackToLargerBlocks) {
+    void *blocks[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        blocks[i] = sys::poolAllocate(8);
+    }
+    EXPECT_EQ(sys::poolStats(0).used, 4);
+
+    // Small class full: served by the 32-byte class
+    void *spill = sys::poolAllocate(8);
+    ASSERT_TRUE(spill != nullptr);
+    EXPECT_EQ(sys::poolStats(1).used, 1);
+    EXPECT_TRUE(sys::poolAllocate(65) == nullptr);
+
+    EXPECT_TRUE(sys::poolRelease(spill));
+    for (uint8_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(sys::poolRelease(blocks[i]));
+    }
+    EXPECT_TRUE(sys::poolRelease(nullptr));
+    EXPECT_EQ(sys::poolStats(0).used, 0);
+    EXPECT_EQ(sys::poolStats(1).used, 0);
+
+    char line[48];
+    sys::PoolStats stats = sys::poolStats(0);
+    sys::poolFormat(&stats, line, sizeof(line));
+    EXPECT_TRUE(strcmp(line, "pool 16 used=0 peak=4 max=4 fail=1") == 0);
+}
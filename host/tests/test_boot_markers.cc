@@ -0,0 +1,34 @@
+#include "../../Core/serre/system/boot/inc/boot_markers.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+TEST(BootMarkers, KeepsFirstTimeOnly) {
+    sys::bootMarkersReset();
+    EXPECT_EQ(sys::bootMarkerUs(sys::BootMarker::FIRST_SAMPLE),
+              sys::BOOT_MARKER_UNSET);
+
+    sys::bootMarkAt(sys::BootMarker::FIRST_SAMPLE, 1210);
+    sys::bootMarkAt(sys::BootMarker::FIRST_SAMPLE, 5000);
+    EXPECT_EQ(sys::bootMarkerUs(sys::BootMarker::FIRST_SAMPLE), 1210);
+    sys::bootMarkersReset();
+}
+
+TEST(BootMarkers, FormatsTimeline) {
+    sys::bootMarkersReset();
+    sys::bootMarkAt(sys::BootMarker::SAFE_OUTPUTS, 180);
+    sys::bootMarkAt(sys::BootMarker::FIRST_SAMPLE, 1210);
+    sys::bootMarkAt(sys::BootMarker::CONSOLE_READY, 1390);
+    sys::bootMarkAt(sys::BootMarker::I2C_READY, 2950);
+
+    char line[80];
+    size_t length = sys::bootMarkersFormat(line, sizeof(line));
+    EXPECT_TRUE(strcmp(line, "boot safe=180us sample=1210us console=1390us "
+                             "i2c=2950us display=-") == 0);
+    EXPECT_EQ(length, strlen(line));
+
+    length = sys::bootMarkersFormat(line, 11);
+    EXPECT_EQ(length, 10);
+    EXPECT_TRUE(strcmp(line, "boot safe=") == 0);
+    sys::bootMarkersReset();
+}
@@ -0,0 +1,93 @@
+#include "../../Core/serre/driver/buttons/inc/buttons.hh"
+#include "../test/test.hh"
+
+namespace {
+
+const input::ButtonTiming TIMING = {20, 800, 400, 150};
+const uint8_t UP = 1U << static_cast<uint8_t>(input::ButtonId::UP);
+const uint8_t SEL = 1U << static_cast<uint8_t>(input::ButtonId::SEL);
+
+/**
+ * @brief Calls update() every millisecond of [from, to) with a fixed level,
+ * as the tick does while needsUpdate() is true.
+ */
+uint8_t run(input::Buttons &buttons, uint32_t from, uint32_t to,
+            uint8_t pressed, input::ButtonQueue *queue) {
+    uint8_t events = 0;
+    for (uint32_t now = from; now < to; now++) {
+        if (buttons.needsUpdate()) {
+            events += buttons.update(now, pressed, queue);
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(Buttons, BounceGivesOneShortPress) {
+    input::Buttons buttons(TIMING);
+    input::ButtonQueue queue;
+    EXPECT_FALSE(buttons.needsUpdate());
+
+    // Contact bounce: edges 3 ms apart, then stable
+    buttons.onEdge(input::ButtonId::SEL, 100);
+    EXPECT_EQ(run(buttons, 100, 103, 0, &queue), 0);
+    buttons.onEdge(input::ButtonId::SEL, 103);
+    EXPECT_EQ(run(buttons, 103, 106, SEL, &queue), 0);
+    buttons.onEdge(input::ButtonId::SEL, 106);
+    EXPECT_EQ(run(buttons, 106, 200, SEL, &queue), 0);
+    EXPECT_TRUE(buttons.needsUpdate());
+
+    buttons.onEdge(input::ButtonId::SEL, 200);
+    EXPECT_EQ(run(buttons, 200, 202, SEL, &queue), 0);
+    buttons.onEdge(input::ButtonId::SEL, 202);
+    EXPECT_EQ(run(buttons, 202, 222, 0, &queue), 0);
+    EXPECT_EQ(run(buttons, 222, 223, 0, &queue), 1);
+    EXPECT_FALSE(buttons.needsUpdate());
+
+    input::ButtonEvent event;
+    ASSERT_TRUE(queue.pop(&event));
+    EXPECT_TRUE(event.button == input::ButtonId::SEL);
+    EXPECT_TRUE(event.type == input::ButtonEventType::SHORT_PRESS);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(Buttons, GlitchShorterThanDebounceIsIgnored) {
+    input::Buttons buttons(TIMING);
+    input::ButtonQueue queue;
+
+    // Pressed then released within the debounce time: level back to idle
+    buttons.onEdge(input::ButtonId::UP, 50);
+    EXPECT_EQ(run(buttons, 50, 55, UP, &queue), 0);
+    buttons.onEdge(input::ButtonId::UP, 55);
+    EXPECT_EQ(run(buttons, 55, 200, 0, &queue), 0);
+    EXPECT_FALSE(buttons.needsUpdate());
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(Buttons, HoldGivesLongPressThenRepeats) {
+    input::Buttons buttons(TIMING);
+    input::ButtonQueue queue;
+
+    // Debounced at 20, LONG_PRESS at 820, REPEAT at 1220, 1370, 1520
+    buttons.onEdge(input::ButtonId::SEL, 0);
+    EXPECT_EQ(run(buttons, 0, 820, SEL, &queue), 0);
+    EXPECT_EQ(run(buttons, 820, 821, SEL, &queue), 1);
+    EXPECT_EQ(run(buttons, 821, 1220, SEL, &queue), 0);
+    EXPECT_EQ(run(buttons, 1220, 1521, SEL, &queue), 3);
+
+    // No SHORT_PRESS on release after a long press
+    EXPECT_EQ(run(buttons, 1521, 1600, SEL, &queue), 0);
+    buttons.onEdge(input::ButtonId::SEL, 1600);
+    EXPECT_EQ(run(buttons, 1600, 1700, 0, &queue), 0);
+    EXPECT_FALSE(buttons.needsUpdate());
+
+    input::ButtonEvent event;
+    ASSERT_TRUE(queue.pop(&event));
+    EXPECT_TRUE(event.type == input::ButtonEventType::LONG_PRESS);
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(queue.pop(&event));
+        EXPECT_TRUE(event.type == input::ButtonEventType::REPEAT);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,87 @@
+#include "../../Core/serre/system/clock/inc/clock.hh"
+#include "../test/test.hh"
+
+namespace {
+
+/**
+ * @brief Decoded TIMINGR, durations in nanoseconds.
+ */
+struct I2cTiming {
+    uint32_t low;   ///< SCL low period
+    uint32_t high;  ///< SCL high period
+    uint32_t hold;  ///< Data hold time
+    uint32_t setup; ///< Data setup time
+};
+
+I2cTiming decode(uint32_t timingr, uint32_t i2cClockHz) {
+    uint32_t periodNs = (((timingr >> 28) & 0xF) + 1) * 1000000000ULL /
+                        i2cClockHz;
+    I2cTiming timing;
+    timing.low = ((timingr & 0xFF) + 1) * periodNs;
+    timing.high = (((timingr >> 8) & 0xFF) + 1) * periodNs;
+    timing.hold = ((timingr >> 16) & 0xF) * periodNs;
+    timing.setup = (((timingr >> 20) & 0xF) + 1) * periodNs;
+    return timing;
+}
+
+} // namespace
+
+TEST(Clock, I2cTimingAt16MHz) {
+    EXPECT_EQ(sys::i2cStandardTiming(16000000), 0x30420F13);
+
+    // Same SCL period as the CubeMX value 0x00503D58 within 5 %, with the
+    // high time now meeting tHIGH >= 4.0 us on its own
+    I2cTiming timing = decode(0x30420F13, 16000000);
+    I2cTiming cube = decode(0x00503D58, 16000000);
+    uint32_t period = timing.low + timing.high;
+    uint32_t cubePeriod = cube.low + cube.high;
+    EXPECT_TRUE(period * 100 >= cubePeriod * 95);
+    EXPECT_TRUE(period * 100 <= cubePeriod * 105);
+    EXPECT_EQ(timing.low, 5000);
+    EXPECT_EQ(timing.high, 4000);
+}
+
+TEST(Clock, I2cTimingMeetsStandardModeAtProfileLimits) {
+    EXPECT_EQ(sys::i2cStandardTiming(4000000), 0x00420F13);
+    EXPECT_EQ(sys::i2cStandardTiming(64000000), 0xF0420F13);
+
+    const uint32_t clocks[] = {4000000, 16000000, 64000000};
+    for (uint32_t clockHz : clocks) {
+        I2cTiming timing = decode(sys::i2cStandardTiming(clockHz), clockHz);
+        EXPECT_TRUE(timing.low >= 4700);
+        EXPECT_TRUE(timing.high >= 4000);
+        EXPECT_TRUE(timing.hold <= 3450);
+        EXPECT_TRUE(timing.setup >= 250);
+    }
+}
+
+TEST(Clock, UartBrrRoundsToNearest) {
+    EXPECT_EQ(sys::uartBrr(16000000, 115200), 139);
+    EXPECT_EQ(sys::uartBrr(4000000, 115200), 35);
+    EXPECT_EQ(sys::uartBrr(64000000, 115200), 556);
+    EXPECT_EQ(sys::uartBrr(16000000, 0), 0);
+
+    // Baud rate error stays below 1 % on every profile
+    const sys::ClockProfile profiles[] = {sys::ClockProfile::ECO,
+                                          sys::ClockProfile::NORMAL,
+                                          sys::ClockProfile::PERFORMANCE};
+    for (sys::ClockProfile profile : profiles) {
+        uint32_t clockHz = sys::clockProfileHz(profile);
+        uint32_t actual = clockHz / sys::uartBrr(clockHz, 115200);
+        EXPECT_NEAR(static_cast<double>(actual), 115200.0, 1152.0);
+    }
+}
+
+TEST(Clock, FlashWaitStatesPerRange) {
+    EXPECT_EQ(sys::clockProfileHz(sys::ClockProfile::ECO), 4000000);
+    EXPECT_EQ(sys::clockProfileHz(sys::ClockProfile::NORMAL), 16000000);
+    EXPECT_EQ(sys::clockProfileHz(sys::ClockProfile::PERFORMANCE), 64000000);
+
+    EXPECT_EQ(sys::flashWaitStates(4000000), 0);
+    EXPECT_EQ(sys::flashWaitStates(16000000), 0);
+    EXPECT_EQ(sys::flashWaitStates(24000000), 0);
+    EXPECT_EQ(sys::flashWaitStates(24000001), 1);
+    EXPECT_EQ(sys::flashWaitStates(48000000), 1);
+    EXPECT_EQ(sys::flashWaitStates(48000001), 2);
+    EXPECT_EQ(sys::flashWaitStates(64000000), 2);
+}
@@ -0,0 +1,69 @@
+#include "../../Core/serre/system/crash/inc/crash.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Fake RAM: an exception frame followed by two stack words.
+ */
+uint32_t s_ram[10] = {0x00000000, 0x20000010, 0x00000001, 0x00000000,
+                      0x00000000, 0x08000a21, 0x08000a3c, 0x61000003,
+                      0x08000c5d, 0x00000000};
+
+uintptr_t ramStart() {
+    return reinterpret_cast<uintptr_t>(&s_ram[0]);
+}
+
+uintptr_t ramEnd() {
+    return reinterpret_cast<uintptr_t>(&s_ram[10]);
+}
+
+} // namespace
+
+TEST(Crash, FormatMatchesDecoder) {
+    sys::CrashRecord record = {};
+    sys::crashCapture(&record, s_ram, 0xFFFFFFF9, ramStart(), ramEnd(), 3);
+    ASSERT_TRUE(sys::crashIsValid(&record));
+    EXPECT_EQ(record.stackWords, 2);
+
+    // The stack pointer of the faulting code, whatever the host addresses
+    record.sp = 0x20001fc8;
+    char report[256];
+    size_t length = sys::crashFormat(&record, report, sizeof(report));
+    const char *expected =
+        "CRASH boot=00000003 exc=fffffff9\r\n"
+        "pc=08000a3c lr=08000a21 xpsr=61000003 sp=20001fc8\r\n"
+        "r0=00000000 r1=20000010 r2=00000001 r3=00000000 r12=00000000\r\n"
+        "stack=08000c5d 00000000\r\n"
+        "END\r\n";
+    EXPECT_TRUE(strcmp(report, expected) == 0);
+    EXPECT_EQ(length, strlen(expected));
+}
+
+TEST(Crash, FormatTruncatesAndRejectsInvalid) {
+    sys::CrashRecord record = {};
+    sys::crashCapture(&record, s_ram, 0xFFFFFFFD, ramStart(), ramEnd(), 1);
+
+    char small[12];
+    memset(small, 'x', sizeof(small));
+    EXPECT_EQ(sys::crashFormat(&record, small, sizeof(small)), 11);
+    EXPECT_TRUE(strcmp(small, "CRASH boot=") == 0);
+
+    sys::crashInvalidate(&record);
+    char report[64] = "stale";
+    EXPECT_EQ(sys::crashFormat(&record, report, sizeof(report)), 0);
+    EXPECT_EQ(report[0], '\0');
+}
+
+TEST(Crash, FrameOutsideRamKeepsRegistersAtZero) {
+    sys::CrashRecord record = {};
+    // Frame would end past the RAM
+    sys::crashCapture(&record, &s_ram[4], 0xFFFFFFF9, ramStart(), ramEnd(),
+                      2);
+    ASSERT_TRUE(sys::crashIsValid(&record));
+    EXPECT_EQ(record.pc, 0);
+    EXPECT_EQ(record.lr, 0);
+    EXPECT_EQ(record.stackWords, 0);
+}
@@ -0,0 +1,94 @@
+#include "../../Core/serre/system/fault/inc/fault.hh"
+#include "../test/test.hh"
+
+TEST(FaultManager, RetriesThenReinitializesThenGivesUp) {
+    sys::FaultLog log = {};
+    sys::faultLogInit(&log);
+    sys::FaultManager faults(&log, 7);
+
+    EXPECT_TRUE(faults.report(sys::FaultCode::I2C_TIMEOUT, 100) ==
+                sys::FaultAction::RETRY);
+    EXPECT_TRUE(faults.report(sys::FaultCode::I2C_ERROR, 101) ==
+                sys::FaultAction::REINITIALIZE);
+    EXPECT_TRUE(faults.report(sys::FaultCode::I2C_TIMEOUT, 103) ==
+                sys::FaultAction::RETRY);
+    EXPECT_FALSE(faults.isDegraded());
+    EXPECT_TRUE(faults.report(sys::FaultCode::I2C_TIMEOUT, 107) ==
+                sys::FaultAction::GIVE_UP);
+    EXPECT_TRUE(faults.isDegraded(sys::Subsystem::I2C));
+    EXPECT_EQ(faults.failures(sys::Subsystem::I2C), 4);
+
+    // Degraded: reported once, then neither logged nor counted
+    EXPECT_TRUE(faults.report(sys::FaultCode::I2C_TIMEOUT, 200) ==
+                sys::FaultAction::GIVE_UP);
+    EXPECT_EQ(faults.failures(sys::Subsystem::I2C), 4);
+    EXPECT_EQ(log.count, 4);
+
+    sys::FaultRecord record;
+    ASSERT_TRUE(sys::faultLogGet(&log, 1, &record));
+    EXPECT_EQ(record.code, static_cast<uint16_t>(sys::FaultCode::I2C_ERROR));
+    EXPECT_EQ(record.timestampMs, 101);
+    EXPECT_EQ(record.bootCount, 7);
+
+    // Other subsystems are independent
+    EXPECT_FALSE(faults.isDegraded(sys::Subsystem::ANALOG));
+    EXPECT_TRUE(faults.report(sys::FaultCode::ADC_TIMEOUT, 300) ==
+                sys::FaultAction::RETRY);
+}
+
+TEST(FaultManager, BackoffDoublesPerFailure) {
+    sys::FaultManager faults(nullptr, 0);
+    EXPECT_EQ(faults.retryDelayMs(sys::Subsystem::UART), 0);
+
+    const uint32_t expected[] = {1, 2, 4, 8};
+    for (uint8_t i = 0; i < 4; i++) {
+        faults.report(sys::FaultCode::UART_ERROR, i);
+        EXPECT_EQ(faults.retryDelayMs(sys::Subsystem::UART), expected[i]);
+    }
+
+    // Degraded reports are not counted, the delay stops growing
+    faults.report(sys::FaultCode::UART_ERROR, 10);
+    EXPECT_EQ(faults.failures(sys::Subsystem::UART), 4);
+    EXPECT_EQ(faults.retryDelayMs(sys::Subsystem::UART), 8);
+}
+
+TEST(FaultManager, SuccessEndsDegradedState) {
+    sys::FaultManager faults(nullptr, 0);
+    for (uint8_t i = 0; i < 4; i++) {
+        faults.report(sys::FaultCode::ADC_ERROR, i);
+    }
+    ASSERT_TRUE(faults.isDegraded(sys::Subsystem::ANALOG));
+
+    faults.clear(sys::Subsystem::ANALOG);
+    EXPECT_FALSE(faults.isDegraded());
+    EXPECT_EQ(faults.failures(sys::Subsystem::ANALOG), 0);
+    EXPECT_EQ(faults.retryDelayMs(sys::Subsystem::ANALOG), 0);
+    EXPECT_TRUE(faults.report(sys::FaultCode::ADC_ERROR, 10) ==
+                sys::FaultAction::RETRY);
+
+    // NONE and out of range subsystems are ignored
+    EXPECT_TRUE(faults.report(sys::FaultCode::NONE, 11) ==
+                sys::FaultAction::GIVE_UP);
+    faults.clear(sys::Subsystem::COUNT);
+    EXPECT_FALSE(faults.isDegraded(sys::Subsystem::COUNT));
+}
+
+TEST(FaultLog, OverwritesOldestWhenFull) {
+    sys::FaultLog log;
+    log.magic = 0x12345678;
+    log.head = 99;
+    sys::faultLogInit(&log);
+    EXPECT_EQ(log.count, 0);
+
+    for (uint16_t i = 0; i < sys::FAULT_LOG_SIZE + 3; i++) {
+        sys::faultLogPush(&log, sys::FaultCode::UART_ERROR, i, 1);
+    }
+    EXPECT_EQ(log.count, sys::FAULT_LOG_SIZE);
+
+    sys::FaultRecord record;
+    ASSERT_TRUE(sys::faultLogGet(&log, 0, &record));
+    EXPECT_EQ(record.timestampMs, 3);
+    ASSERT_TRUE(sys::faultLogGet(&log, sys::FAULT_LOG_SIZE - 1, &record));
+    EXPECT_EQ(record.timestampMs, sys::FAULT_LOG_SIZE + 2);
+    EXPECT_FALSE(sys::faultLogGet(&log, sys::FAULT_LOG_SIZE, &record));
+}
@@ -0,0 +1,147 @@
+#include "../../Core/Inc/adc.h"
+#include "../../Core/serre/control/actuators/inc/actuators.hh"
+#include "../../Core/serre/driver/sensors/soil_hum_sensor/inc/soil_hum.hh"
+#include "../../Core/serre/driver/sensors/temp_sensor/inc/temp_sensor.hh"
+#include "../sim/greenhouse_sim.hh"
+#include "../test/test.hh"
+
+namespace {
+
+constexpr uint32_t WEEK_S = 7 * 24 * 3600;
+constexpr uint32_t CONTROL_PERIOD_S = 10;
+
+const sensor::SensorConfig tempConfig = {&hadc1, ADC_CHANNEL_1,
+                                         ADC_SAMPLINGTIME_COMMON_1, 10, 1000};
+const sensor::SensorConfig soilConfig = {&hadc1, ADC_CHANNEL_0,
+                                         ADC_SAMPLINGTIME_COMMON_1, 10, 1000};
+const control::ActuatorConfig actuatorConfig = {FAN_GPIO_Port, FAN_Pin,
+                                                PUMP_GPIO_Port, PUMP_Pin};
+const sim::Wiring wiring = {ADC_CHANNEL_1, ADC_CHANNEL_0, 3200, 1200, 3,
+                            FAN_GPIO_Port, FAN_Pin, PUMP_GPIO_Port, PUMP_Pin};
+
+/**
+ * @brief Firmware sensors and outputs in a simulated greenhouse, sampled
+ * every second like the acquisition task.
+ */
+struct Loop {
+    Loop(float tempC, float moisturePct, float startHour)
+        : sim(sim::defaultPlant(), wiring, tempC, moisturePct, startHour),
+          temp(tempConfig), soil(soilConfig), actuators(actuatorConfig) {
+        this->soil.calibrate(wiring.soilDryRaw, wiring.soilWetRaw);
+    }
+
+    void sample() {
+        this->temp.readData();
+        this->soil.readData();
+        this->temp.processData();
+        this->soil.processData();
+    }
+
+    sim::GreenhouseSim sim;
+    sensor::TempSensor temp;
+    sensor::SoilHumSensor soil;
+    control::Actuators actuators;
+};
+
+} // namespace
+
+TEST(GreenhouseSim, SensorsReadTheSimulatedClimate) {
+    Loop loop(22.0f, 50.0f, 0.0f);
+    // The noise averages out over the 10-sample window
+    for (uint8_t i = 0; i < 10; i++) {
+        loop.sample();
+        loop.sim.step(1.0f);
+    }
+    EXPECT_NEAR(loop.temp.getTemperatureCelsius(), 22.0, 0.15);
+    EXPECT_NEAR(loop.soil.getHumidityPercent(), 50.0, 0.1);
+    EXPECT_TRUE(loop.temp.isTemperatureValid());
+    EXPECT_TRUE(loop.soil.isHumidityValid());
+}
+
+TEST(GreenhouseSim, SunOverheatsAClosedGreenhouse) {
+    Loop loop(20.0f, 50.0f, 6.0f);
+    loop.actuators.setFan(false);
+    loop.sim.step(6 * 3600);
+    float closed = loop.sim.temperatureC();
+    EXPECT_TRUE(closed > 40.0f);
+
+    // Ventilating brings it back close to the outside air
+    loop.actuators.setFan(true);
+    loop.sim.step(2 * 3600);
+    EXPECT_TRUE(loop.sim.temperatureC() < loop.sim.outsideC() + 6.0f);
+    EXPECT_NEAR(loop.sim.metrics().fanEnergyWh, 30.0, 0.5);
+}
+
+TEST(GreenhouseSim, WaterReachesTheProbeAfterSoaking) {
+    Loop loop(20.0f, 30.0f, 0.0f);
+    loop.actuators.setPump(true);
+    loop.sim.step(60);
+    loop.actuators.setPump(false);
+    loop.sim.step(1);
+    float soon = loop.sim.moisturePct();
+    loop.sim.step(3600);
+
+    // 2 L at 2 %/L, less an hour of evaporation; barely any after a minute
+    EXPECT_TRUE(soon < 31.0f);
+    EXPECT_NEAR(loop.sim.moisturePct(), 32.6, 0.3);
+    EXPECT_NEAR(loop.sim.metrics().waterLiters, 2.0, 0.01);
+    EXPECT_EQ(loop.sim.metrics().pumpStarts, 1);
+}
+
+TEST(GreenhouseSim, TrendTracksMorningWarmUp) {
+    Loop loop(15.0f, 50.0f, 9.0f);
+    float windowStart = 0.0f;
+    for (uint32_t second = 0; second < 600; second++) {
+        if (second == 480) {
+            windowStart = loop.sim.temperatureC();
+        }
+        loop.sample();
+        loop.sim.step(1.0f);
+    }
+    // Average rise over the 2 minutes the trend covers
+    float rise = (loop.sim.temperatureC() - windowStart) / 2.0f;
+
+    EXPECT_TRUE(loop.temp.isTrendReady());
+    EXPECT_TRUE(rise > 0.1f);
+    EXPECT_NEAR(loop.temp.getTrendCelsiusPerMinute(), rise, 0.03);
+}
+
+// Closed-loop regression: a week of a reference hysteresis controller
+TEST(GreenhouseSim, HysteresisHoldsClimateForAWeek) {
+    Loop loop(20.0f, 50.0f, 0.0f);
+    uint32_t faulted = 0;
+    for (uint32_t second = 0; second < WEEK_S; second++) {
+        loop.sample();
+        if ((loop.temp.probeFault() != sensor::ProbeFault::NONE) ||
+            (loop.soil.probeFault() != sensor::ProbeFault::NONE)) {
+            faulted++;
+        }
+        if ((second % CONTROL_PERIOD_S) == 0) {
+            float tempC = loop.temp.getTemperatureCelsius();
+            float moisture = loop.soil.getHumidityPercent();
+            if (tempC > 27.0f) {
+                loop.actuators.setFan(true);
+            } else if (tempC < 25.0f) {
+                loop.actuators.setFan(false);
+            }
+            if (moisture < 40.0f) {
+                loop.actuators.setPump(true);
+            } else if (moisture > 45.0f) {
+                loop.actuators.setPump(false);
+            }
+        }
+        loop.sim.step(1.0f);
+    }
+
+    const sim::Metrics &metrics = loop.sim.metrics();
+    EXPECT_NEAR(metrics.seconds, WEEK_S, 60.0);
+    EXPECT_TRUE(metrics.tempMaxC < 28.5f);
+    EXPECT_TRUE(metrics.moistureMinPct > 38.0f);
+    // The water still soaking in when the pump stops overshoots by ~15 %
+    EXPECT_TRUE(metrics.moistureMaxPct < 65.0f);
+    EXPECT_TRUE(metrics.fanEnergyWh < 800.0f);
+    EXPECT_TRUE(metrics.waterLiters < 150.0f);
+    EXPECT_TRUE(metrics.pumpStarts > 0);
+    // Slow drifts under a few counts of noise are not a frozen probe
+    EXPECT_EQ(faulted, 0);
+}
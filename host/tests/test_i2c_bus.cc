@@ -0,0 +1,178 @@
+#include "../../Core/serre/driver/i2c/inc/i2c_bus.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Register file: a write sets the pointer and stores the following
+ * bytes, a read returns the registers from the pointer.
+ */
+class RegisterDevice final : public mock::I2cDevice {
+  public:
+    bool write(const uint8_t *data, uint16_t length) override {
+        if (length == 0) {
+            return true;
+        }
+        this->m_pointer = data[0];
+        for (uint16_t i = 1; i < length; i++) {
+            this->m_registers[(this->m_pointer + i - 1) & 0xFF] = data[i];
+        }
+        return true;
+    }
+
+    bool read(uint8_t *data, uint16_t length) override {
+        for (uint16_t i = 0; i < length; i++) {
+            data[i] = this->m_registers[(this->m_pointer + i) & 0xFF];
+        }
+        return true;
+    }
+
+    uint8_t m_registers[256] = {};
+    uint8_t m_pointer = 0;
+};
+
+uint32_t s_callbacks = 0;
+
+void onDone(bus::I2cTransaction *transaction) {
+    (void)transaction;
+    s_callbacks++;
+}
+
+bus::I2cTransaction makeTransaction(uint8_t address, const uint8_t *tx,
+                                    uint16_t txLength, uint8_t *rx,
+                                    uint16_t rxLength) {
+    bus::I2cTransaction transaction = {};
+    transaction.address = address;
+    transaction.txData = tx;
+    transaction.txLength = txLength;
+    transaction.rxData = rx;
+    transaction.rxLength = rxLength;
+    transaction.timeoutMs = 20;
+    transaction.callback = onDone;
+    return transaction;
+}
+
+// The engine is a singleton: leave it idle for the next test
+void drain() {
+    for (uint8_t i = 0; (i < 100) && !bus::i2c1().isIdle(); i++) {
+        mock::halAdvanceMs(1);
+        bus::i2c1().poll(HAL_GetTick());
+    }
+}
+
+} // namespace
+
+TEST(I2cBus, WriteThenReadWithRepeatedStart) {
+    RegisterDevice device;
+    device.m_registers[0x10] = 0xAB;
+    device.m_registers[0x11] = 0xCD;
+    mock::i2cAttach(0x40, &device);
+    s_callbacks = 0;
+
+    const uint8_t pointer[] = {0x10};
+    uint8_t rx[2] = {};
+    bus::I2cTransaction transaction =
+        makeTransaction(0x40, pointer, sizeof(pointer), rx, sizeof(rx));
+    ASSERT_TRUE(bus::i2c1().submit(&transaction));
+    EXPECT_TRUE(transaction.result == bus::I2cResult::PENDING);
+
+    drain();
+    EXPECT_TRUE(transaction.result == bus::I2cResult::OK);
+    EXPECT_EQ(rx[0], 0xAB);
+    EXPECT_EQ(rx[1], 0xCD);
+    EXPECT_EQ(s_callbacks, 1);
+}
+
+TEST(I2cBus, AbsentDeviceIsNacked) {
+    s_callbacks = 0;
+    const uint8_t command[] = {0x01, 0x02};
+    bus::I2cTransaction transaction =
+        makeTransaction(0x22, command, sizeof(command), nullptr, 0);
+    ASSERT_TRUE(bus::i2c1().submit(&transaction));
+
+    drain();
+    EXPECT_TRUE(transaction.result == bus::I2cResult::NACK);
+    EXPECT_EQ(s_callbacks, 1);
+}
+
+TEST(I2cBus, QueuedTransactionsRunInOrder) {
+    RegisterDevice device;
+    mock::i2cAttach(0x50, &device);
+
+    const uint8_t first[] = {0x00, 0x11};
+    const uint8_t second[] = {0x00, 0x22};
+    bus::I2cTransaction a = makeTransaction(0x50, first, 2, nullptr, 0);
+    bus::I2cTransaction b = makeTransaction(0x50, second, 2, nullptr, 0);
+    ASSERT_TRUE(bus::i2c1().submit(&a));
+    ASSERT_TRUE(bus::i2c1().submit(&b));
+
+    drain();
+    EXPECT_TRUE(a.result == bus::I2cResult::OK);
+    EXPECT_TRUE(b.result == bus::I2cResult::OK);
+    EXPECT_EQ(device.m_registers[0], 0x22);
+}
+
+namespace {
+
+/**
+ * @brief Port with both lines held low and a recovery that never frees
+ * them, as on a node without pull-ups.
+ */
+class StuckPort final : public bus::I2cPort {
+  public:
+    bool transmit(uint8_t, const uint8_t *, uint16_t, bool) override {
+        return false;
+    }
+    bool receive(uint8_t, uint8_t *, uint16_t) override {
+        return false;
+    }
+    void abort() override {
+    }
+    bool isBusStuck() const override {
+        return this->m_stuck;
+    }
+    bool recoverBus() override {
+        this->m_recoveries++;
+        return false;
+    }
+    uint32_t nowMs() const override {
+        return this->m_nowMs;
+    }
+    void lock() override {
+    }
+    void unlock() override {
+    }
+
+    bool m_stuck = true;
+    uint32_t m_nowMs = 0;
+    uint32_t m_recoveries = 0;
+};
+
+} // namespace
+
+TEST(I2cBus, StuckBusRecoveryBacksOffThenGivesUp) {
+    StuckPort port;
+    bus::I2cEngine engine(&port);
+
+    // Polled every 5 ms for a minute: 10, 20, 40 ... ms apart, then stop
+    for (port.m_nowMs = 0; port.m_nowMs < 60000; port.m_nowMs += 5) {
+        engine.poll(port.m_nowMs);
+    }
+    EXPECT_EQ(port.m_recoveries, 8);
+    const bus::I2cStats &stats = engine.stats();
+    EXPECT_EQ(stats.recoveryFailures, 8);
+    EXPECT_EQ(stats.stuckEpisodes, 1);
+    EXPECT_EQ(stats.failedEpisodes, 1);
+    EXPECT_EQ(stats.abandoned, 1);
+
+    // Lines high again: the next stuck bus is a new episode
+    port.m_stuck = false;
+    engine.poll(port.m_nowMs);
+    port.m_stuck = true;
+    engine.poll(port.m_nowMs += 5);
+    EXPECT_EQ(port.m_recoveries, 9);
+    EXPECT_EQ(stats.stuckEpisodes, 2);
+}
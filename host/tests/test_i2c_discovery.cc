@@ -0,0 +1,213 @@
+#include "../../Core/serre/driver/i2c/inc/i2c_discovery.hh"
+#include "../../Core/serre/driver/sensors/sht_sensor/inc/sht_sensor.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Scripted bus: answering addresses, serial numbers and a clock
+ * advanced by every transfer.
+ */
+class FakeProber final : public bus::I2cProber {
+  public:
+    bool probe(uint8_t address) override {
+        this->m_probes[address]++;
+        this->m_now += this->m_probeMs;
+        return bus::i2cContains(&this->m_present, address);
+    }
+
+    bool query(uint8_t address, const uint8_t *command, uint8_t commandLength,
+               uint16_t delayMs, uint8_t *response,
+               uint8_t responseLength) override {
+        this->m_queries++;
+        this->m_now += delayMs;
+        memcpy(this->m_command, command,
+               commandLength < sizeof(this->m_command)
+                   ? commandLength
+                   : sizeof(this->m_command));
+        this->m_commandLength = commandLength;
+        if (!bus::i2cContains(&this->m_present, address)) {
+            return false;
+        }
+        memcpy(response, this->m_serial,
+               responseLength < sizeof(this->m_serial)
+                   ? responseLength
+                   : sizeof(this->m_serial));
+        return true;
+    }
+
+    uint32_t nowMs() const override {
+        return this->m_now;
+    }
+
+    void answer(uint8_t address) {
+        bus::i2cInsert(&this->m_present, address);
+    }
+
+    /**
+     * @brief Sets the serial number read back, with valid or broken CRCs.
+     */
+    void setSerial(bool valid) {
+        const uint8_t words[] = {0x12, 0x34, 0x56, 0x78};
+        this->m_serial[0] = words[0];
+        this->m_serial[1] = words[1];
+        this->m_serial[2] = sensor::shtCrc(&words[0], 2);
+        this->m_serial[3] = words[2];
+        this->m_serial[4] = words[3];
+        this->m_serial[5] = sensor::shtCrc(&words[2], 2);
+        if (!valid) {
+            this->m_serial[5] ^= 0x01;
+        }
+    }
+
+    bus::I2cAddressSet m_present = {};
+    uint8_t m_probes[128] = {};
+    uint32_t m_queries = 0;
+    uint32_t m_now = 1000;
+    uint32_t m_probeMs = 0;
+    uint8_t m_serial[6] = {};
+    uint8_t m_command[2] = {};
+    uint8_t m_commandLength = 0;
+};
+
+uint8_t s_created[4] = {};
+uint8_t s_createdCount = 0;
+uint8_t s_instance = 0;
+
+void *create(uint8_t address) {
+    if (s_createdCount < sizeof(s_created)) {
+        s_created[s_createdCount++] = address;
+    }
+    return &s_instance;
+}
+
+bool identifyNever(bus::I2cProber *prober, uint8_t address) {
+    (void)prober;
+    (void)address;
+    return false;
+}
+
+const uint8_t SENSOR_ADDRESSES[] = {0x44, 0x45};
+const uint8_t DISPLAY_ADDRESSES[] = {0x3C, 0x3D};
+const uint8_t SHARED_ADDRESSES[] = {0x44};
+
+} // namespace
+
+TEST(I2cDiscovery, ScanStopsAtBudget) {
+    FakeProber prober;
+    prober.answer(0x08);
+    prober.answer(0x3C);
+    prober.m_probeMs = 2;
+
+    bus::I2cAddressSet found = {};
+    EXPECT_FALSE(bus::i2cScan(&prober, nullptr, 0, 20, &found));
+    EXPECT_TRUE(bus::i2cContains(&found, 0x08));
+    EXPECT_FALSE(bus::i2cContains(&found, 0x3C));
+    EXPECT_EQ(prober.m_probes[0x11], 1);
+    EXPECT_EQ(prober.m_probes[0x12], 0);
+
+    // Within budget: the whole 0x08-0x77 range once
+    FakeProber full;
+    full.answer(0x3C);
+    bus::I2cAddressSet all = {};
+    EXPECT_TRUE(bus::i2cScan(&full, nullptr, 0, 20, &all));
+    EXPECT_TRUE(bus::i2cContains(&all, 0x3C));
+    EXPECT_EQ(full.m_probes[0x07], 0);
+    EXPECT_EQ(full.m_probes[0x08], 1);
+    EXPECT_EQ(full.m_probes[0x77], 1);
+    EXPECT_EQ(full.m_probes[0x78], 0);
+}
+
+TEST(I2cDiscovery, ScanSkipsAddressesAlreadyFound) {
+    FakeProber prober;
+    prober.answer(0x44);
+    const uint8_t addresses[] = {0x44, 0x45, 0x44};
+    bus::I2cAddressSet found = {};
+    EXPECT_TRUE(bus::i2cScan(&prober, addresses, 3, 20, &found));
+    EXPECT_EQ(prober.m_probes[0x44], 1);
+    EXPECT_EQ(prober.m_probes[0x45], 1);
+    EXPECT_TRUE(bus::i2cContains(&found, 0x44));
+    EXPECT_FALSE(bus::i2cContains(&found, 0x45));
+}
+
+TEST(I2cDiscovery, FirstIdentifyingDriverClaimsAddress) {
+    const bus::DriverDescriptor table[] = {
+        {"never", bus::DeviceKind::AIR_SENSOR, SHARED_ADDRESSES, 1,
+         identifyNever, create},
+        {"sensor", bus::DeviceKind::AIR_SENSOR, SENSOR_ADDRESSES, 2, nullptr,
+         create},
+        {"again", bus::DeviceKind::AIR_SENSOR, SHARED_ADDRESSES, 1, nullptr,
+         create},
+        {"display", bus::DeviceKind::DISPLAY, DISPLAY_ADDRESSES, 2, nullptr,
+         create},
+    };
+    FakeProber prober;
+    prober.answer(0x44);
+    prober.answer(0x3D);
+    s_createdCount = 0;
+
+    bus::Discovery result;
+    bus::i2cDiscover(&prober, table, 4, 50, &result);
+    EXPECT_TRUE(result.complete);
+
+    // One probe per address, however many drivers list it
+    EXPECT_EQ(prober.m_probes[0x44], 1);
+    EXPECT_EQ(prober.m_probes[0x45], 1);
+    EXPECT_EQ(prober.m_probes[0x3C], 1);
+
+    // "never" refuses 0x44, "sensor" takes it, "again" finds it claimed
+    ASSERT_EQ(result.count, 2);
+    EXPECT_TRUE(strcmp(result.devices[0].driver->name, "sensor") == 0);
+    EXPECT_EQ(result.devices[0].address, 0x44);
+    EXPECT_TRUE(strcmp(result.devices[1].driver->name, "display") == 0);
+    EXPECT_EQ(result.devices[1].address, 0x3D);
+    EXPECT_EQ(s_createdCount, 2);
+
+    EXPECT_TRUE(bus::i2cFindDevice(&result, bus::DeviceKind::DISPLAY) ==
+                &s_instance);
+}
+
+TEST(I2cDiscovery, DiscoveryStopsAtBudget) {
+    const bus::DriverDescriptor table[] = {
+        {"sensor", bus::DeviceKind::AIR_SENSOR, SENSOR_ADDRESSES, 2, nullptr,
+         create},
+        {"display", bus::DeviceKind::DISPLAY, DISPLAY_ADDRESSES, 2, nullptr,
+         create},
+    };
+    FakeProber prober;
+    prober.answer(0x44);
+    prober.answer(0x3C);
+    prober.m_probeMs = 5;
+    s_createdCount = 0;
+
+    bus::Discovery result;
+    bus::i2cDiscover(&prober, table, 2, 10, &result);
+    EXPECT_FALSE(result.complete);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(prober.m_probes[0x3C], 0);
+    EXPECT_TRUE(bus::i2cFindDevice(&result, bus::DeviceKind::DISPLAY) ==
+                nullptr);
+}
+
+TEST(I2cDiscovery, ShtIdentifyChecksSerialCrc) {
+    FakeProber prober;
+    prober.answer(0x44);
+    prober.setSerial(true);
+
+    EXPECT_TRUE(sensor::shtIdentify(&prober, 0x44, sensor::ShtModel::SHT4X));
+    EXPECT_EQ(prober.m_commandLength, 1);
+    EXPECT_EQ(prober.m_command[0], 0x89);
+
+    EXPECT_TRUE(sensor::shtIdentify(&prober, 0x44, sensor::ShtModel::SHT3X));
+    EXPECT_EQ(prober.m_commandLength, 2);
+    EXPECT_EQ(prober.m_command[0], 0x37);
+    EXPECT_EQ(prober.m_command[1], 0x80);
+
+    // A device at the address that does not speak the protocol
+    prober.setSerial(false);
+    EXPECT_FALSE(sensor::shtIdentify(&prober, 0x44, sensor::ShtModel::SHT4X));
+    EXPECT_FALSE(sensor::shtIdentify(&prober, 0x45, sensor::ShtModel::SHT4X));
+    EXPECT_EQ(prober.m_queries, 4);
+}
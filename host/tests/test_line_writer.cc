@@ -0,0 +1,47 @@
+#include "../../Core/serre/system/text/inc/line_writer.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+TEST(LineWriter, AppendsTextAndNumbers) {
+    char line[40];
+    sys::LineWriter out(line, sizeof(line));
+    out.text("ram free=");
+    out.number(0);
+    out.put(' ');
+    out.number(4294967295UL);
+    out.put(' ');
+    out.hex(0x08000a3c);
+    EXPECT_TRUE(strcmp(line, "ram free=0 4294967295 08000a3c") == 0);
+    EXPECT_EQ(out.length(), strlen(line));
+}
+
+TEST(LineWriter, FixedRoundsToTwoDecimals) {
+    char line[32];
+    sys::LineWriter out(line, sizeof(line));
+    out.fixed(21.456f);
+    out.put(' ');
+    out.fixed(-3.049f);
+    out.put(' ');
+    out.fixed(0.0f);
+    EXPECT_TRUE(strcmp(line, "21.46 -3.05 0.00") == 0);
+}
+
+TEST(LineWriter, TruncatesAndStaysTerminated) {
+    char line[8];
+    memset(line, 'x', sizeof(line));
+    sys::LineWriter out(line, sizeof(line));
+    out.text("prof ");
+    out.number(123456);
+    EXPECT_TRUE(strcmp(line, "prof 12") == 0);
+    EXPECT_EQ(out.length(), 7);
+
+    // No buffer, or no room even for the terminator
+    sys::LineWriter none(nullptr, 16);
+    none.text("ignored");
+    EXPECT_EQ(none.length(), 0);
+    char untouched = 'x';
+    sys::LineWriter empty(&untouched, 0);
+    empty.put('a');
+    EXPECT_EQ(untouched, 'x');
+}
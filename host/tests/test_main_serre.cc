@@ -0,0 +1,225 @@
+#include "../../Core/Inc/main.h"
+#include "../../Core/serre/driver/sensors/sht_sensor/inc/sht_sensor.hh"
+#include "../../Core/serre/system/boot/inc/boot_markers.hh"
+#include "../../Core/serre/system/clock/inc/clock.hh"
+#include "../../Core/serre/system/fault/inc/fault.hh"
+#include "../board/board.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief SHT4x answering the serial number and high precision measurement
+ * commands with fixed words.
+ */
+class Sht4x final : public mock::I2cDevice {
+  public:
+    bool write(const uint8_t *data, uint16_t length) override {
+        if (length != 1) {
+            return false;
+        }
+        this->m_command = data[0];
+        if (this->m_command == 0xFD) {
+            this->m_measurements++;
+        }
+        return (this->m_command == 0x89) || (this->m_command == 0xFD);
+    }
+
+    bool read(uint8_t *data, uint16_t length) override {
+        if (length != 6) {
+            return false;
+        }
+        // 0x6666: 25 °C, 0x7FFF: 56.5 %RH
+        uint16_t first = (this->m_command == 0xFD) ? 0x6666 : 0x1234;
+        uint16_t second = (this->m_command == 0xFD) ? 0x7FFF : 0x5678;
+        putWord(&data[0], first);
+        putWord(&data[3], second);
+        return true;
+    }
+
+    uint32_t m_measurements = 0;
+
+  private:
+    static void putWord(uint8_t *out, uint16_t word) {
+        out[0] = static_cast<uint8_t>(word >> 8);
+        out[1] = static_cast<uint8_t>(word & 0xFF);
+        out[2] = sensor::shtCrc(out, 2);
+    }
+
+    uint8_t m_command = 0;
+};
+
+/**
+ * @brief SSD1306 that accepts every write.
+ */
+class Oled final : public mock::I2cDevice {
+  public:
+    bool write(const uint8_t *data, uint16_t length) override {
+        (void)data;
+        this->m_bytes += length;
+        return true;
+    }
+
+    bool read(uint8_t *data, uint16_t length) override {
+        (void)data;
+        (void)length;
+        return false;
+    }
+
+    uint32_t m_bytes = 0;
+};
+
+/**
+ * @brief Counts the entries of a fault code in the retained fault log.
+ */
+uint8_t loggedCount(sys::FaultCode code) {
+    uint8_t count = 0;
+    const sys::FaultLog *log = sys::retainedFaultLog();
+    for (uint16_t i = 0; i < log->count; i++) {
+        if (log->entries[i].code == static_cast<uint16_t>(code)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+// main_serre() boots once per process: everything is checked in one test
+TEST(MainSerre, BootsAndRunsTheControlLoop) {
+    Sht4x air;
+    Oled oled;
+    mock::i2cAttach(0x44, &air);
+    mock::i2cAttach(0x3C, &oled);
+    mock::adcSetValue(ADC_CHANNEL_0, 2000);
+    mock::adcSetValue(ADC_CHANNEL_1, 931);
+    // 747 mV on the internal sensor: 25 °C for the typical calibration
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 928);
+    mock::halSetTickHook(main_serre_tick);
+
+    while (HAL_GetTick() < 5000) {
+        main_serre();
+    }
+
+    // Profile dump on command, one line per region
+    mock::uartInput("p");
+    uint32_t end = HAL_GetTick() + 200;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+
+    const std::string &console = mock::uartOutput();
+    EXPECT_TRUE(console.find("I2C: SHT4x@44 SSD1306@3c\r\n") !=
+                std::string::npos);
+    EXPECT_EQ(mock::board().watchdogTimeoutMs, 4000);
+    EXPECT_TRUE(mock::board().watchdogRefreshes > 1000);
+    EXPECT_TRUE(air.m_measurements >= 4);
+    EXPECT_TRUE(oled.m_bytes > 0);
+    EXPECT_EQ(mock::resetRequests(), 0);
+    EXPECT_TRUE(console.find("prof MAIN_LOOP n=") != std::string::npos);
+    EXPECT_TRUE(console.find("prof UI_RENDER n=") != std::string::npos);
+
+    // Interrupt latency: measured on request only, the clock restored
+    EXPECT_TRUE(console.find("ISR latency") == std::string::npos);
+    mock::uartInput("l");
+    end = HAL_GetTick() + 200;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_TRUE(mock::uartOutput().find("ISR latency @64MHz: ram ") !=
+                std::string::npos);
+    EXPECT_TRUE(sys::clockProfile() == sys::ClockProfile::NORMAL);
+
+    // Staged startup: sampling before the console, the console before I2C
+    uint32_t sample = sys::bootMarkerUs(sys::BootMarker::FIRST_SAMPLE);
+    uint32_t uart = sys::bootMarkerUs(sys::BootMarker::CONSOLE_READY);
+    uint32_t i2c = sys::bootMarkerUs(sys::BootMarker::I2C_READY);
+    EXPECT_TRUE(i2c != sys::BOOT_MARKER_UNSET);
+    EXPECT_TRUE((sample <= uart) && (uart <= i2c));
+    EXPECT_TRUE(sys::bootMarkerUs(sys::BootMarker::DISPLAY_READY) !=
+                sys::BOOT_MARKER_UNSET);
+    EXPECT_TRUE(console.find("boot safe=") != std::string::npos);
+
+    // Telemetry: the steady air sensor is recorded once, not every second
+    EXPECT_TRUE(console.find("tel temperature 25.00 digital\r\n") !=
+                std::string::npos);
+    size_t record = console.find("tel air 56.50 digital\r\n");
+    EXPECT_TRUE(record != std::string::npos);
+    EXPECT_TRUE(console.find("tel air", record + 1) == std::string::npos);
+
+    // Stack and heap about to collide: logged once, printed on command
+    mock::board().ramUsage.freeBytes = 64;
+    mock::uartInput("m");
+    end = HAL_GetTick() + 10000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_TRUE(mock::uartOutput().find("ram static=3072 heap=0 stack=512 "
+                                        "free=64\r\n") != std::string::npos);
+    EXPECT_EQ(loggedCount(sys::FaultCode::SYSTEM_RAM_LOW), 1);
+
+    // Probes unplugged: the jump is caught at once, the rail once the
+    // window is full of it; the fan runs, the pump stays off until the
+    // timed watering
+    EXPECT_FALSE(mock::gpioOutput(FAN_GPIO_Port, FAN_Pin));
+    mock::adcSetValue(ADC_CHANNEL_0, 4095);
+    mock::adcSetValue(ADC_CHANNEL_1, 4095);
+    end = HAL_GetTick() + 12000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_EQ(loggedCount(sys::FaultCode::ADC_PROBE_RATE), 2);
+    EXPECT_EQ(loggedCount(sys::FaultCode::ADC_PROBE_RAIL), 2);
+    EXPECT_TRUE(mock::gpioOutput(FAN_GPIO_Port, FAN_Pin));
+    EXPECT_FALSE(mock::gpioOutput(PUMP_GPIO_Port, PUMP_Pin));
+
+    // Plugged back: once the windows settle the fan is released
+    mock::adcSetValue(ADC_CHANNEL_0, 2000);
+    mock::adcSetValue(ADC_CHANNEL_1, 931);
+    end = HAL_GetTick() + 12000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_FALSE(mock::gpioOutput(FAN_GPIO_Port, FAN_Pin));
+    EXPECT_FALSE(mock::gpioOutput(PUMP_GPIO_Port, PUMP_Pin));
+
+    // SHT4x unplugged: the analog air probe takes over once the digital
+    // reading is stale
+    mock::i2cAttach(0x44, nullptr);
+    end = HAL_GetTick() + 7000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    size_t hot = mock::uartOutput().size();
+
+    // Die at 75 °C: the clock is throttled, and the 25 °C air probe no
+    // longer looks plausible; full clock and a valid probe once cooled
+    EXPECT_EQ(loggedCount(sys::FaultCode::ADC_PROBE_MISMATCH), 0);
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 1083);
+    end = HAL_GetTick() + 12000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_EQ(loggedCount(sys::FaultCode::SYSTEM_OVERHEAT), 1);
+    EXPECT_EQ(loggedCount(sys::FaultCode::ADC_PROBE_MISMATCH), 1);
+    EXPECT_TRUE(sys::clockProfile() == sys::ClockProfile::ECO);
+    EXPECT_TRUE(mock::uartOutput().find("tel temperature 25.03 analog "
+                                        "invalid\r\n",
+                                        hot) != std::string::npos);
+    EXPECT_TRUE(mock::uartOutput().find("tel temperature 25.03 analog\r\n",
+                                        hot) == std::string::npos);
+    size_t cooled = mock::uartOutput().size();
+    mock::adcSetValue(ADC_CHANNEL_TEMPSENSOR, 928);
+    end = HAL_GetTick() + 12000;
+    while (HAL_GetTick() < end) {
+        main_serre();
+    }
+    EXPECT_TRUE(sys::clockProfile() == sys::ClockProfile::NORMAL);
+    EXPECT_TRUE(mock::uartOutput().find("tel temperature 25.03 analog\r\n",
+                                        cooled) != std::string::npos);
+
+    mock::i2cAttach(0x3C, nullptr);
+}
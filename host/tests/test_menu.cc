@@ -0,0 +1,178 @@
+#include "../../Core/serre/ui/menu/inc/menu.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Display keeping the last flushed frame.
+ */
+class FrameDisplay final : public ui::Display {
+  public:
+    uint8_t rows() const override {
+        return 4;
+    }
+
+    uint8_t columns() const override {
+        return 16;
+    }
+
+    void clear() override {
+        memset(this->m_draft, 0, sizeof(this->m_draft));
+        this->m_draftHighlight = 0xFF;
+    }
+
+    void drawText(uint8_t row, const char *text, bool highlighted) override {
+        strncpy(this->m_draft[row], text, 16);
+        if (highlighted) {
+            this->m_draftHighlight = row;
+        }
+    }
+
+    void flush() override {
+        memcpy(this->m_frame, this->m_draft, sizeof(this->m_frame));
+        this->m_highlight = this->m_draftHighlight;
+    }
+
+    char m_frame[4][17] = {};
+    uint8_t m_highlight = 0xFF;
+
+  private:
+    char m_draft[4][17] = {};
+    uint8_t m_draftHighlight = 0xFF;
+};
+
+/**
+ * @brief Two values and an action counter.
+ */
+class Model final : public ui::MenuModel {
+  public:
+    int16_t getValue(uint8_t id) const override {
+        return this->m_values[id];
+    }
+
+    void setValue(uint8_t id, int16_t value) override {
+        this->m_values[id] = value;
+        this->m_writes++;
+    }
+
+    const char *runAction(uint8_t id) override {
+        (void)id;
+        this->m_actions++;
+        return "Done";
+    }
+
+    int16_t m_values[3] = {185, 1, 42};
+    uint8_t m_writes = 0;
+    uint8_t m_actions = 0;
+};
+
+const char *const MODES[] = {"Off", "Auto", "On"};
+
+const ui::MenuItem SETTINGS_ITEMS[] = {
+    {"Target", ui::ItemKind::VALUE, 0, 100, 190, 5, 1, nullptr, nullptr},
+    {"Mode", ui::ItemKind::VALUE, 1, 0, 2, 1, 0, MODES, nullptr},
+    {"Back", ui::ItemKind::BACK, 0, 0, 0, 0, 0, nullptr, nullptr},
+};
+const ui::Menu SETTINGS = {"Settings", SETTINGS_ITEMS, 3};
+
+const ui::MenuItem ROOT_ITEMS[] = {
+    {"Soil", ui::ItemKind::READOUT, 2, 0, 100, 0, 0, nullptr, nullptr},
+    {"Settings", ui::ItemKind::SUBMENU, 0, 0, 0, 0, 0, nullptr, &SETTINGS},
+    {"Save", ui::ItemKind::ACTION, 0, 0, 0, 0, 0, nullptr, nullptr},
+};
+const ui::Menu ROOT = {"Serre", ROOT_ITEMS, 3};
+
+input::ButtonEvent press(input::ButtonId button) {
+    input::ButtonEvent event = {button, input::ButtonEventType::SHORT_PRESS};
+    return event;
+}
+
+input::ButtonEvent hold(input::ButtonId button, input::ButtonEventType type) {
+    input::ButtonEvent event = {button, type};
+    return event;
+}
+
+} // namespace
+
+TEST(MenuEngine, NavigatesAndRendersRightAligned) {
+    Model model;
+    ui::MenuEngine menu(&ROOT, &model);
+    FrameDisplay display;
+
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Serre") == 0);
+    EXPECT_TRUE(strcmp(display.m_frame[1], "Soil          42") == 0);
+    EXPECT_TRUE(strcmp(display.m_frame[2], "Settings       >") == 0);
+    EXPECT_EQ(display.m_highlight, 1);
+    EXPECT_TRUE(menu.isLive());
+
+    // UP from the first entry wraps to the last
+    menu.handle(press(input::ButtonId::UP));
+    menu.render(&display);
+    EXPECT_EQ(display.m_highlight, 3);
+
+    menu.handle(press(input::ButtonId::SEL));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Done") == 0);
+    EXPECT_EQ(model.m_actions, 1);
+
+    // Any event clears the action message
+    menu.handle(press(input::ButtonId::UP));
+    menu.handle(press(input::ButtonId::SEL));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Settings") == 0);
+    EXPECT_TRUE(strcmp(display.m_frame[1], "Target      18.5") == 0);
+    EXPECT_TRUE(strcmp(display.m_frame[2], "Mode        Auto") == 0);
+    EXPECT_FALSE(menu.isLive());
+
+    // A long SEL goes back, so does the BACK entry
+    menu.handle(hold(input::ButtonId::SEL, input::ButtonEventType::LONG_PRESS));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Serre") == 0);
+    EXPECT_EQ(display.m_highlight, 2);
+    menu.handle(press(input::ButtonId::SEL));
+    menu.handle(press(input::ButtonId::UP));
+    menu.handle(press(input::ButtonId::SEL));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Serre") == 0);
+}
+
+TEST(MenuEngine, EditClampsNumbersAndWrapsChoices) {
+    Model model;
+    ui::MenuEngine menu(&ROOT, &model);
+    FrameDisplay display;
+    menu.handle(press(input::ButtonId::DOWN));
+    menu.handle(press(input::ButtonId::SEL));
+
+    // Numbers stop at their limits, repeats count as presses
+    menu.handle(press(input::ButtonId::SEL));
+    EXPECT_TRUE(menu.isEditing());
+    menu.handle(press(input::ButtonId::UP));
+    menu.handle(hold(input::ButtonId::UP, input::ButtonEventType::REPEAT));
+    menu.handle(hold(input::ButtonId::UP, input::ButtonEventType::REPEAT));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[1], "Target    [19.0]") == 0);
+    EXPECT_EQ(model.m_writes, 0);
+    menu.handle(press(input::ButtonId::SEL));
+    EXPECT_FALSE(menu.isEditing());
+    EXPECT_EQ(model.m_values[0], 190);
+    EXPECT_EQ(model.m_writes, 1);
+
+    // Choice lists wrap around
+    menu.handle(press(input::ButtonId::DOWN));
+    menu.handle(press(input::ButtonId::SEL));
+    menu.handle(press(input::ButtonId::UP));
+    menu.handle(press(input::ButtonId::UP));
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[2], "Mode       [Off]") == 0);
+
+    // A long SEL cancels the edit and stays in the menu
+    menu.handle(hold(input::ButtonId::SEL, input::ButtonEventType::LONG_PRESS));
+    EXPECT_FALSE(menu.isEditing());
+    EXPECT_EQ(model.m_values[1], 1);
+    EXPECT_EQ(model.m_writes, 1);
+    menu.render(&display);
+    EXPECT_TRUE(strcmp(display.m_frame[0], "Settings") == 0);
+}
@@ -0,0 +1,68 @@
+#include "../../Core/serre/system/profile/inc/profile.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+void timedRegion(uint32_t start, uint32_t end) {
+    TIM2->CNT = start;
+    SERRE_PROFILE_BEGIN(ADC_POLL);
+    TIM2->CNT = end;
+    SERRE_PROFILE_END(ADC_POLL);
+}
+
+} // namespace
+
+TEST(Profile, ProbesRecordMinMeanMax) {
+    sys::profileReset();
+    timedRegion(100, 400);
+    timedRegion(1000, 1100);
+    timedRegion(5000, 5200);
+
+    const sys::ProfileStats &stats =
+        sys::profileStats(sys::ProfileRegion::ADC_POLL);
+    EXPECT_EQ(stats.count, 3);
+    EXPECT_EQ(stats.minCycles, 100);
+    EXPECT_EQ(stats.maxCycles, 300);
+    EXPECT_EQ(stats.totalCycles, 600);
+}
+
+TEST(Profile, TimerWrapIsTransparent) {
+    sys::profileReset();
+    timedRegion(0xFFFFFFF0U, 0x10);
+    EXPECT_EQ(sys::profileStats(sys::ProfileRegion::ADC_POLL).maxCycles,
+              0x20);
+}
+
+TEST(Profile, FormatsReportLine) {
+    sys::profileReset();
+    sys::profileRecord(sys::ProfileRegion::TEMP_MATH, 80);
+    sys::profileRecord(sys::ProfileRegion::TEMP_MATH, 120);
+
+    char line[64];
+    size_t length = sys::profileFormat(
+        sys::ProfileRegion::TEMP_MATH,
+        &sys::profileStats(sys::ProfileRegion::TEMP_MATH), line,
+        sizeof(line));
+    EXPECT_TRUE(strcmp(line, "prof TEMP_MATH n=2 min=80 mean=100 max=120") ==
+                0);
+    EXPECT_EQ(length, strlen(line));
+
+    sys::profileFormat(sys::ProfileRegion::SOIL_MATH,
+                       &sys::profileStats(sys::ProfileRegion::SOIL_MATH),
+                       line, sizeof(line));
+    EXPECT_TRUE(strcmp(line, "prof SOIL_MATH n=0") == 0);
+}
+
+TEST(Profile, ReportTruncatesToBuffer) {
+    sys::profileReset();
+    char line[10];
+    size_t length = sys::profileFormat(
+        sys::ProfileRegion::MAIN_LOOP,
+        &sys::profileStats(sys::ProfileRegion::MAIN_LOOP), line,
+        sizeof(line));
+    EXPECT_EQ(length, 9);
+    EXPECT_TRUE(strcmp(line, "prof MAIN") == 0);
+}
@@ -0,0 +1,40 @@
+#include "../../Core/serre/system/memory/inc/ram_monitor.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+TEST(RamMonitor, FindsDeepestStackWord) {
+    uint32_t stack[16];
+    for (uint8_t i = 0; i < 16; i++) {
+        stack[i] = sys::STACK_PAINT;
+    }
+    EXPECT_EQ(sys::stackPeakBytes(&stack[0], &stack[16], sys::STACK_PAINT),
+              0);
+
+    // Frames leave painted holes above the deepest write
+    stack[15] = 0;
+    stack[11] = 0x1234;
+    stack[6] = 0;
+    EXPECT_EQ(sys::stackPeakBytes(&stack[0], &stack[16], sys::STACK_PAINT),
+              40);
+
+    // Scanning starts at the heap high-water mark
+    stack[2] = 0;
+    EXPECT_EQ(sys::stackPeakBytes(&stack[4], &stack[16], sys::STACK_PAINT),
+              40);
+    EXPECT_EQ(sys::stackPeakBytes(&stack[0], &stack[16], sys::STACK_PAINT),
+              56);
+}
+
+TEST(RamMonitor, FormatsReportLine) {
+    sys::RamUsage usage = {3412, 0, 612, 4168};
+    char line[64];
+    size_t length = sys::ramUsageFormat(&usage, line, sizeof(line));
+    EXPECT_TRUE(strcmp(line, "ram static=3412 heap=0 stack=612 free=4168") ==
+                0);
+    EXPECT_EQ(length, strlen(line));
+
+    length = sys::ramUsageFormat(&usage, line, 12);
+    EXPECT_EQ(length, 11);
+    EXPECT_TRUE(strcmp(line, "ram static=") == 0);
+}
@@ -0,0 +1,53 @@
+#include "../../Core/serre/driver/sensors/report.hh"
+#include "../test/test.hh"
+
+#include <string.h>
+
+namespace {
+
+sensor::Reading analog(float value) {
+    sensor::Reading reading = {value, 0, sensor::Source::ANALOG, true};
+    return reading;
+}
+
+} // namespace
+
+TEST(ReportFilter, DeadbandFromLastRecord) {
+    sensor::ReportFilter filter({0.5f, 0});
+    sensor::Reading never = {};
+    EXPECT_FALSE(filter.accept(never, 0));
+
+    EXPECT_TRUE(filter.accept(analog(20.0f), 0));
+    EXPECT_FALSE(filter.accept(analog(20.3f), 1000));
+    // Slow drift: measured from 20.0, not from the previous sample
+    EXPECT_FALSE(filter.accept(analog(20.4f), 2000));
+    EXPECT_TRUE(filter.accept(analog(20.5f), 3000));
+    EXPECT_FALSE(filter.accept(analog(20.1f), 4000));
+
+    sensor::Reading flagged = analog(20.5f);
+    flagged.valid = false;
+    EXPECT_TRUE(filter.accept(flagged, 5000));
+    EXPECT_EQ(filter.records(), 3);
+}
+
+TEST(ReportFilter, HeartbeatAfterSilence) {
+    sensor::ReportFilter filter({1.0f, 60000});
+    EXPECT_TRUE(filter.accept(analog(40.0f), 1000));
+    EXPECT_FALSE(filter.accept(analog(40.0f), 60999));
+    EXPECT_TRUE(filter.accept(analog(40.0f), 61000));
+    EXPECT_FALSE(filter.accept(analog(40.2f), 62000));
+}
+
+TEST(ReportFilter, FormatsRecordLine) {
+    char line[48];
+    sensor::Reading reading = {21.456f, 0, sensor::Source::DIGITAL, true};
+    size_t length = sensor::reportFormat("temperature", &reading, line,
+                                         sizeof(line));
+    EXPECT_TRUE(strcmp(line, "tel temperature 21.46 digital") == 0);
+    EXPECT_EQ(length, strlen(line));
+
+    reading = analog(-3.05f);
+    reading.valid = false;
+    sensor::reportFormat("soil", &reading, line, sizeof(line));
+    EXPECT_TRUE(strcmp(line, "tel soil -3.05 analog invalid") == 0);
+}
@@ -0,0 +1,55 @@
+#include "../../Core/serre/system/scheduler/inc/scheduler.hh"
+#include "../test/test.hh"
+
+namespace {
+
+void countRun(void *context, uint32_t nowMs) {
+    (void)nowMs;
+    (*static_cast<uint32_t *>(context))++;
+}
+
+} // namespace
+
+TEST(Scheduler, PeriodicTaskRunsOncePerPeriod) {
+    sys::Scheduler scheduler;
+    uint32_t runs = 0;
+    scheduler.addTask(countRun, &runs, 100, 1000);
+
+    EXPECT_EQ(scheduler.run(1000), 1); // Due right away
+    EXPECT_EQ(scheduler.run(1050), 0);
+    EXPECT_EQ(scheduler.run(1100), 1);
+    EXPECT_EQ(runs, 2);
+}
+
+TEST(Scheduler, LateRunDoesNotCatchUp) {
+    sys::Scheduler scheduler;
+    uint32_t runs = 0;
+    scheduler.addTask(countRun, &runs, 100, 0);
+
+    scheduler.run(0);
+    EXPECT_EQ(scheduler.run(550), 1);
+    EXPECT_EQ(scheduler.run(560), 0);
+    EXPECT_EQ(scheduler.run(650), 1);
+    EXPECT_EQ(runs, 3);
+}
+
+TEST(Scheduler, SignalRunsSignalOnlyTask) {
+    sys::Scheduler scheduler;
+    uint32_t runs = 0;
+    int8_t id = scheduler.addTask(countRun, &runs, 0, 0);
+
+    EXPECT_EQ(scheduler.run(10), 0);
+    scheduler.signal(id);
+    EXPECT_EQ(scheduler.run(20), 1);
+    EXPECT_EQ(scheduler.run(30), 0);
+    EXPECT_EQ(runs, 1);
+}
+
+TEST(Scheduler, TableFull) {
+    sys::Scheduler scheduler;
+    uint32_t runs = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        EXPECT_EQ(scheduler.addTask(countRun, &runs, 10, 0), i);
+    }
+    EXPECT_EQ(scheduler.addTask(countRun, &runs, 10, 0), sys::INVALID_TASK);
+}
@@ -0,0 +1,66 @@
+#include "../../Core/serre/system/settings/inc/settings.hh"
+#include "../board/board.hh"
+#include "../test/test.hh"
+
+TEST(Settings, DefaultsOnErasedPage) {
+    sys::Settings settings;
+    sys::settingsLoad(&settings);
+    EXPECT_EQ(settings.tempMinDeci, -400);
+    EXPECT_EQ(settings.tempMaxDeci, 850);
+    EXPECT_FALSE(sys::settingsIsValid(&settings));
+}
+
+TEST(Settings, SaveThenLoad) {
+    sys::Settings settings;
+    sys::settingsDefaults(&settings);
+    settings.soilDry = 3100;
+    settings.soilWet = 1200;
+    ASSERT_TRUE(sys::settingsSave(&settings));
+    settings.soilDry = 2000;
+    ASSERT_TRUE(sys::settingsSave(&settings));
+
+    sys::Settings loaded;
+    sys::settingsLoad(&loaded);
+    EXPECT_TRUE(sys::settingsIsValid(&loaded));
+    EXPECT_EQ(loaded.sequence, 2);
+    EXPECT_EQ(loaded.soilDry, 2000);
+    EXPECT_EQ(loaded.soilWet, 1200);
+}
+
+TEST(Settings, CorruptedRecordFallsBackToPrevious) {
+    sys::Settings settings;
+    sys::settingsDefaults(&settings);
+    settings.soilDry = 3000;
+    sys::settingsSave(&settings);
+    settings.soilDry = 2500;
+    sys::settingsSave(&settings);
+
+    // Torn write of the second record
+    mock::board().settingsPage[1].soilWet ^= 0x0100;
+
+    sys::Settings loaded;
+    sys::settingsLoad(&loaded);
+    EXPECT_EQ(loaded.sequence, 1);
+    EXPECT_EQ(loaded.soilDry, 3000);
+}
+
+TEST(Settings, FullPageIsErasedAndReused) {
+    sys::Settings settings;
+    sys::settingsDefaults(&settings);
+    for (uint16_t i = 0; i < mock::SETTINGS_SLOTS; i++) {
+        sys::settingsSave(&settings);
+    }
+    EXPECT_EQ(sys::settingsFindFree(mock::board().settingsPage,
+                                    mock::SETTINGS_SLOTS),
+              -1);
+
+    settings.tempMaxDeci = 400;
+    ASSERT_TRUE(sys::settingsSave(&settings));
+    EXPECT_EQ(sys::settingsFindLatest(mock::board().settingsPage,
+                                      mock::SETTINGS_SLOTS),
+              0);
+
+    sys::Settings loaded;
+    sys::settingsLoad(&loaded);
+    EXPECT_EQ(loaded.tempMaxDeci, 400);
+}
@@ -0,0 +1,97 @@
+#include "../../Core/serre/driver/sensors/sht_sensor/inc/sht_sensor.hh"
+#include "../mock/i2c_mock.hh"
+#include "../test/test.hh"
+
+namespace {
+
+/**
+ * @brief Builds a measurement frame: two words, each followed by its CRC.
+ */
+std::vector<uint8_t> frame(uint16_t temperature, uint16_t humidity) {
+    std::vector<uint8_t> data = {static_cast<uint8_t>(temperature >> 8),
+                                 static_cast<uint8_t>(temperature & 0xFF), 0,
+                                 static_cast<uint8_t>(humidity >> 8),
+                                 static_cast<uint8_t>(humidity & 0xFF), 0};
+    data[2] = sensor::shtCrc(&data[0], 2);
+    data[5] = sensor::shtCrc(&data[3], 2);
+    return data;
+}
+
+/**
+ * @brief Runs a trigger and a fetch, the port answering with the given frame.
+ */
+HAL_StatusTypeDef measure(mock::MockI2cPort &port, sensor::ShtSensor &sht,
+                          const std::vector<uint8_t> &data) {
+    if (sht.trigger() != HAL_OK) {
+        return HAL_ERROR;
+    }
+    port.complete();
+    port.queueRead(data);
+    if (sht.fetch() != HAL_OK) {
+        return HAL_ERROR;
+    }
+    port.complete();
+    return sht.readData();
+}
+
+} // namespace
+
+TEST(ShtSensor, Sht4xSendsSingleByteCommand) {
+    mock::MockI2cPort port;
+    bus::I2cEngine engine(&port);
+    port.attach(&engine);
+    sensor::ShtSensor sht({&engine, 0x44, sensor::ShtModel::SHT4X, 20});
+
+    ASSERT_EQ(measure(port, sht, frame(0x6666, 0x7FFF)), HAL_OK);
+    EXPECT_TRUE(port.traceText() == "W 44 FD\nR 44 66 66 93 7F FF 8F\n");
+
+    sht.processData();
+    EXPECT_TRUE(sht.isDataValid());
+    EXPECT_NEAR(sht.getTemperatureCelsius(), 25.0f, 0.01f);
+    EXPECT_NEAR(sht.getHumidityPercent(), 56.5f, 0.01f);
+}
+
+TEST(ShtSensor, Sht3xSendsMeasureHighWithoutStretching) {
+    mock::MockI2cPort port;
+    bus::I2cEngine engine(&port);
+    port.attach(&engine);
+    sensor::ShtSensor sht({&engine, 0x45, sensor::ShtModel::SHT3X, 20});
+
+    ASSERT_EQ(sht.trigger(), HAL_OK);
+    EXPECT_TRUE(port.traceText() == "W 45 24 00\n");
+    EXPECT_EQ(sht.conversionTimeMs(), 16);
+}
+
+TEST(ShtSensor, CorruptedWordIsRejected) {
+    mock::MockI2cPort port;
+    bus::I2cEngine engine(&port);
+    port.attach(&engine);
+    sensor::ShtSensor sht({&engine, 0x44, sensor::ShtModel::SHT4X, 20});
+
+    ASSERT_EQ(measure(port, sht, frame(0x6666, 0x7FFF)), HAL_OK);
+    ASSERT_TRUE(sht.isDataValid());
+
+    // One bit flipped in the humidity word, its CRC left as sent
+    std::vector<uint8_t> corrupted = frame(0x6666, 0x7FFF);
+    corrupted[4] ^= 0x01;
+    EXPECT_EQ(measure(port, sht, corrupted), HAL_ERROR);
+    EXPECT_FALSE(sht.isDataValid());
+
+    // The temperature word alone
+    corrupted = frame(0x6666, 0x7FFF);
+    corrupted[0] ^= 0x80;
+    EXPECT_EQ(measure(port, sht, corrupted), HAL_ERROR);
+    EXPECT_FALSE(sht.isDataValid());
+}
+
+TEST(ShtSensor, NackedTriggerEndsWithError) {
+    mock::MockI2cPort port;
+    bus::I2cEngine engine(&port);
+    port.attach(&engine);
+    sensor::ShtSensor sht({&engine, 0x44, sensor::ShtModel::SHT4X, 20});
+
+    port.queueReply(mock::I2cReply::ACK);
+    port.queueReply(mock::I2cReply::NACK);
+    EXPECT_EQ(measure(port, sht, frame(0x6666, 0x7FFF)), HAL_ERROR);
+    EXPECT_FALSE(sht.isDataValid());
+}
@@ -0,0 +1,57 @@
+#include "../../Core/serre/system/queue/inc/spsc_queue.hh"
+#include "../test/test.hh"
+
+TEST(SpscQueue, KeepsOrderAndOneSlotFree) {
+    sys::SpscQueue<uint16_t, 4> queue;
+    uint16_t item = 0;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.pop(&item));
+
+    // Capacity is N - 1
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(queue.dropped(), 1);
+
+    ASSERT_TRUE(queue.pop(&item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(queue.push(5));
+    ASSERT_TRUE(queue.pop(&item));
+    EXPECT_EQ(item, 2);
+    ASSERT_TRUE(queue.pop(&item));
+    EXPECT_EQ(item, 3);
+    ASSERT_TRUE(queue.pop(&item));
+    EXPECT_EQ(item, 5);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.dropped(), 1);
+}
+
+TEST(SpscQueue, WrapsAroundManyTimes) {
+    sys::SpscQueue<uint32_t, 8> queue;
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    uint32_t item = 0;
+
+    // Producer two items ahead, indices wrap every eight
+    for (uint32_t round = 0; round < 100; round++) {
+        EXPECT_TRUE(queue.push(next++));
+        EXPECT_TRUE(queue.push(next++));
+        ASSERT_TRUE(queue.pop(&item));
+        EXPECT_EQ(item, expected++);
+        if (round % 2 == 1) {
+            ASSERT_TRUE(queue.pop(&item));
+            EXPECT_EQ(item, expected++);
+        }
+        if (next - expected >= 6) {
+            while (queue.pop(&item)) {
+                EXPECT_EQ(item, expected++);
+            }
+        }
+    }
+    while (queue.pop(&item)) {
+        EXPECT_EQ(item, expected++);
+    }
+    EXPECT_EQ(expected, next);
+    EXPECT_EQ(queue.dropped(), 0);
+}
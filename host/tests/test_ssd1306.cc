@@ -0,0 +1,105 @@
+#include "../../Core/serre/ui/display/inc/ssd1306_display.hh"
+#include "../hal/hal_mock.hh"
+#include "../test/test.hh"
+
+namespace {
+
+constexpr uint8_t OLED_ADDRESS = 0x3C;
+
+/**
+ * @brief Panel that accepts everything and counts the transfers.
+ */
+class Panel final : public mock::I2cDevice {
+  public:
+    bool write(const uint8_t *data, uint16_t length) override {
+        (void)data;
+        this->m_transfers++;
+        this->m_lastLength = length;
+        return true;
+    }
+
+    bool read(uint8_t *data, uint16_t length) override {
+        (void)data;
+        (void)length;
+        return false;
+    }
+
+    uint32_t m_transfers = 0;
+    uint16_t m_lastLength = 0;
+};
+
+// Runs update() after each completed transfer until the display is idle
+void settle(ui::Ssd1306Display &display) {
+    for (uint8_t i = 0; i < 50; i++) {
+        mock::halAdvanceMs(1);
+        display.update();
+    }
+}
+
+} // namespace
+
+TEST(Ssd1306, FirstFrameSendsInitAllPagesAndPowerOn) {
+    Panel panel;
+    mock::i2cAttach(OLED_ADDRESS, &panel);
+    ui::Ssd1306Display display({&bus::i2c1(), OLED_ADDRESS, 30});
+
+    display.drawText(0, "Serre", false);
+    display.flush();
+    settle(display);
+
+    // Initialization, 8 pages, display on
+    EXPECT_EQ(panel.m_transfers, 10);
+    EXPECT_FALSE(display.isBusy());
+}
+
+TEST(Ssd1306, OneCharacterChangeSendsOneCell) {
+    Panel panel;
+    mock::i2cAttach(OLED_ADDRESS, &panel);
+    ui::Ssd1306Display display({&bus::i2c1(), OLED_ADDRESS, 30});
+    display.drawText(2, "T 21.5C", false);
+    display.flush();
+    settle(display);
+
+    uint32_t transfers = panel.m_transfers;
+    uint32_t bytes = display.bytesSent();
+    display.drawText(2, "T 21.6C", false);
+    display.flush();
+    settle(display);
+
+    EXPECT_EQ(panel.m_transfers, transfers + 1);
+    EXPECT_EQ(display.bytesSent() - bytes, 7 + 6); // Header and one cell
+}
+
+TEST(Ssd1306, HighlightRedrawsFullPage) {
+    Panel panel;
+    mock::i2cAttach(OLED_ADDRESS, &panel);
+    ui::Ssd1306Display display({&bus::i2c1(), OLED_ADDRESS, 30});
+    display.drawText(1, "Menu", false);
+    display.flush();
+    settle(display);
+
+    display.drawText(1, "Menu", true);
+    display.flush();
+    settle(display);
+    EXPECT_EQ(panel.m_lastLength, 7 + 128);
+}
+
+TEST(Ssd1306, NackedPageIsRedrawn) {
+    Panel panel;
+    mock::i2cAttach(OLED_ADDRESS, &panel);
+    ui::Ssd1306Display display({&bus::i2c1(), OLED_ADDRESS, 30});
+    display.flush();
+    settle(display);
+
+    mock::i2cAttach(OLED_ADDRESS, nullptr);
+    display.drawText(4, "x", false);
+    display.flush();
+    settle(display);
+
+    mock::i2cAttach(OLED_ADDRESS, &panel);
+    uint32_t transfers = panel.m_transfers;
+    display.update();
+    settle(display);
+    EXPECT_EQ(panel.m_transfers, transfers + 1);
+    EXPECT_EQ(panel.m_lastLength, 7 + 128);
+}
@@ -0,0 +1,109 @@
+#include "../../Core/serre/driver/sensors/snapshot.hh"
+#include "../../Core/serre/system/bus/inc/topic_bus.hh"
+#include "../test/test.hh"
+
+namespace {
+
+enum class Topic : uint8_t { TEMPERATURE = 0, SOIL, COUNT };
+
+typedef sys::TopicBus<Topic, sensor::Reading, sensor::sameReading> Bus;
+
+/**
+ * @brief What the handlers received, in delivery order.
+ */
+struct Log {
+    char calls[8];
+    float values[8];
+    uint8_t count;
+};
+
+void record(Log *log, char name, const sensor::Reading &reading) {
+    log->calls[log->count] = name;
+    log->values[log->count] = reading.value;
+    log->count++;
+}
+
+void first(void *context, Topic topic, const sensor::Reading &reading) {
+    (void)topic;
+    record(static_cast<Log *>(context), 'a', reading);
+}
+
+void second(void *context, Topic topic, const sensor::Reading &reading) {
+    (void)topic;
+    record(static_cast<Log *>(context), 'b', reading);
+}
+
+void soil(void *context, Topic topic, const sensor::Reading &reading) {
+    (void)topic;
+    record(static_cast<Log *>(context), 's', reading);
+}
+
+const Bus::Entry table[] = {
+    {Topic::TEMPERATURE, first},
+    {Topic::SOIL, soil},
+    {Topic::TEMPERATURE, second},
+};
+
+sensor::Reading reading(float value, uint32_t timestampMs) {
+    sensor::Reading result = {value, timestampMs, sensor::Source::ANALOG,
+                              true};
+    return result;
+}
+
+} // namespace
+
+TEST(TopicBus, DeliversOnlyChanges) {
+    Bus bus(table, 3);
+    Log log = {};
+
+    EXPECT_TRUE(bus.publish(Topic::TEMPERATURE, reading(21.0f, 0)));
+    EXPECT_TRUE(bus.isPending());
+    EXPECT_EQ(bus.dispatch(&log), 2);
+    ASSERT_EQ(log.count, 2);
+    EXPECT_EQ(log.calls[0], 'a');
+    EXPECT_EQ(log.calls[1], 'b');
+
+    // Same data, newer timestamp: nothing to do
+    EXPECT_FALSE(bus.publish(Topic::TEMPERATURE, reading(21.0f, 1000)));
+    EXPECT_FALSE(bus.isPending());
+    EXPECT_EQ(bus.dispatch(&log), 0);
+
+    sensor::Reading invalid = reading(21.0f, 2000);
+    invalid.valid = false;
+    EXPECT_TRUE(bus.publish(Topic::TEMPERATURE, invalid));
+    EXPECT_EQ(bus.dispatch(&log), 2);
+
+    sys::BusStats stats = bus.stats();
+    EXPECT_EQ(stats.published, 3);
+    EXPECT_EQ(stats.unchanged, 1);
+    EXPECT_EQ(stats.deliveries, 4);
+}
+
+TEST(TopicBus, CoalescesInPublicationOrder) {
+    Bus bus(table, 3);
+    Log log = {};
+
+    bus.publish(Topic::SOIL, reading(40.0f, 0));
+    bus.publish(Topic::TEMPERATURE, reading(20.0f, 0));
+    bus.publish(Topic::SOIL, reading(41.0f, 1000));
+    EXPECT_EQ(bus.dispatch(&log), 3);
+
+    // Soil first, delivered once with its latest value
+    ASSERT_EQ(log.count, 3);
+    EXPECT_EQ(log.calls[0], 's');
+    EXPECT_NEAR(log.values[0], 41.0f, 0.001f);
+    EXPECT_EQ(log.calls[1], 'a');
+    EXPECT_EQ(log.calls[2], 'b');
+
+    sensor::Reading latest = {};
+    EXPECT_TRUE(bus.latest(Topic::SOIL, &latest));
+    EXPECT_EQ(latest.timestampMs, 1000);
+}
+
+TEST(TopicBus, UnpublishedTopicHasNoValue) {
+    Bus bus(table, 3);
+    sensor::Reading latest = {};
+    EXPECT_FALSE(bus.latest(Topic::SOIL, &latest));
+    EXPECT_FALSE(bus.publish(Topic::COUNT, reading(1.0f, 0)));
+    EXPECT_EQ(bus.stats().published, 0);
+}
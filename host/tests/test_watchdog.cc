@@ -0,0 +1,49 @@
+#include "../../Core/serre/system/watchdog/inc/watchdog.hh"
+#include "../test/test.hh"
+
+TEST(Watchdog, IwdgConfigPicksSmallestPrescaler) {
+    // 100 ms: 3200 LSI cycles, 800 ticks of the /4 divider
+    sys::IwdgConfig config = sys::computeIwdgConfig(100);
+    EXPECT_EQ(config.prescaler, 0);
+    EXPECT_EQ(config.reload, 799);
+
+    // 1 s no longer fits /4 (8000 ticks), /8 gives 4000
+    config = sys::computeIwdgConfig(1000);
+    EXPECT_EQ(config.prescaler, 1);
+    EXPECT_EQ(config.reload, 3999);
+
+    // Exactly 4096 ticks of /4 still fit the 12-bit reload
+    config = sys::computeIwdgConfig(512);
+    EXPECT_EQ(config.prescaler, 0);
+    EXPECT_EQ(config.reload, 0x0FFF);
+}
+
+TEST(Watchdog, IwdgConfigClampsToHardwareRange) {
+    sys::IwdgConfig config = sys::computeIwdgConfig(0);
+    EXPECT_EQ(config.prescaler, 0);
+    EXPECT_EQ(config.reload, 0);
+
+    // 32768 ms is the longest timeout: /256 and a full reload
+    config = sys::computeIwdgConfig(32768);
+    EXPECT_EQ(config.prescaler, 6);
+    EXPECT_EQ(config.reload, 0x0FFF);
+    config = sys::computeIwdgConfig(60000);
+    EXPECT_EQ(config.prescaler, 6);
+    EXPECT_EQ(config.reload, 0x0FFF);
+}
+
+TEST(Watchdog, LateTaskBlocksRefresh) {
+    sys::Watchdog watchdog;
+    EXPECT_TRUE(watchdog.isHealthy(0));
+
+    // Registered just before the tick wraps
+    uint32_t start = 0xFFFFFF00UL;
+    watchdog.registerTask(sys::WatchdogTask::ACQUISITION, 500, start);
+    watchdog.registerTask(sys::WatchdogTask::COMMS, 2000, start);
+    EXPECT_TRUE(watchdog.isHealthy(start + 500));
+
+    watchdog.checkIn(sys::WatchdogTask::ACQUISITION, start + 400);
+    EXPECT_TRUE(watchdog.isHealthy(start + 900));
+    EXPECT_EQ(watchdog.lateTasks(start + 901), 1U << 0);
+    EXPECT_EQ(watchdog.lateTasks(start + 2001), (1U << 0) | (1U << 2));
+}
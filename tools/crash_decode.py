@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Symbolize a HardFault report emitted over USART2 by serre_co.
+
+The firmware prints the report once at the boot following a hard fault:
+
+    CRASH boot=00000003 exc=fffffff9
+    pc=08000a3c lr=08000a21 xpsr=61000003 sp=20001fc8
+    r0=00000000 r1=20000010 r2=00000001 r3=00000000 r12=00000000
+    stack=08000c5d 00000000 ...
+    END
+
+PC, LR and every stack word that looks like a Thumb return address into
+flash are resolved against the ELF (arm-none-eabi-addr2line) or, when
+the toolchain is not installed, against the linker map file.
+
+Usage:
+    tools/crash_decode.py --elf build/debug/serre_co.elf report.txt
+    tools/crash_decode.py --map build/debug/serre_co.map < report.txt
+"""
+
+import argparse
+import bisect
+import re
+import shutil
+import subprocess
+import sys
+
+FLASH_START = 0x08000000
+FLASH_END = 0x08010000
+
+FIELD_RE = re.compile(r"(\w+)=([0-9a-fA-F]{8})")
+MAP_SECTION_RE = re.compile(
+    r"^\s*\.text\.?(\S*)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+MAP_SECTION_NAME_RE = re.compile(r"^\s*\.text\.?(\S*)\s*$")
+MAP_SECTION_ADDR_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+
+
+def parse_report(text):
+    """Return (fields, stack words) of the first CRASH block in text."""
+    fields = {}
+    stack = []
+    inside = False
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith("CRASH"):
+            inside = True
+        if not inside:
+            continue
+        if line == "END":
+            break
+        if line.startswith("stack="):
+            stack = [int(word, 16) for word in line[len("stack="):].split()]
+            continue
+        for name, value in FIELD_RE.findall(line):
+            fields[name] = int(value, 16)
+    if not inside:
+        raise ValueError("no CRASH report found")
+    return fields, stack
+
+
+class MapSymbols:
+    """Address to symbol lookup built from a GNU ld map file."""
+
+    def __init__(self, path):
+        self.addresses = []
+        self.entries = []
+        pending = None
+        with open(path, encoding="utf-8", errors="replace") as handle:
+            for line in handle:
+                match = MAP_SECTION_RE.match(line)
+                if match:
+                    self._add(match.group(1), match.group(2), match.group(3),
+                              match.group(4))
+                    pending = None
+                    continue
+                match = MAP_SECTION_NAME_RE.match(line)
+                if match:
+                    pending = match.group(1)
+                    continue
+                if pending is not None:
+                    match = MAP_SECTION_ADDR_RE.match(line)
+                    if match:
+                        self._add(pending, match.group(1), match.group(2),
+                                  match.group(3))
+                    pending = None
+        order = sorted(range(len(self.addresses)), key=self.addresses.__getitem__)
+        self.addresses = [self.addresses[i] for i in order]
+        self.entries = [self.entries[i] for i in order]
+
+    def _add(self, name, address, size, obj):
+        address = int(address, 16)
+        size = int(size, 16)
+        if size == 0 or not FLASH_START <= address < FLASH_END:
+            return
+        self.addresses.append(address)
+        self.entries.append((address, size, name or "?", obj))
+
+    def lookup(self, address):
+        index = bisect.bisect_right(self.addresses, address) - 1
+        if index < 0:
+            return None
+        start, size, name, obj = self.entries[index]
+        if address >= start + size:
+            return None
+        return "%s+0x%x (%s)" % (name, address - start, obj)
+
+
+class ElfSymbols:
+    """Address to function/file:line lookup through binutils."""
+
+    def __init__(self, path, addr2line):
+        self.path = path
+        self.addr2line = addr2line
+
+    def lookup(self, address):
+        output = subprocess.run(
+            [self.addr2line, "-e", self.path, "-f", "-C", "-i", "-p",
+             "0x%08x" % address],
+            check=False, capture_output=True, text=True).stdout.strip()
+        if not output or output.startswith("??"):
+            return None
+        return output.replace("\n", " / ")
+
+
+def is_code_address(word):
+    return FLASH_START <= word < FLASH_END
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("report", nargs="?", help="report file (default: stdin)")
+    parser.add_argument("--elf", help="firmware ELF (build/<profile>/serre_co.elf)")
+    parser.add_argument("--map", help="linker map (build/<profile>/serre_co.map)")
+    parser.add_argument("--addr2line", default="arm-none-eabi-addr2line",
+                        help="addr2line executable")
+    args = parser.parse_args()
+
+    resolvers = []
+    if args.elf and shutil.which(args.addr2line):
+        resolvers.append(ElfSymbols(args.elf, args.addr2line))
+    if args.map:
+        resolvers.append(MapSymbols(args.map))
+    if not resolvers:
+        parser.error("need --elf (with binutils installed) or --map")
+
+    text = open(args.report).read() if args.report else sys.stdin.read()
+    fields, stack = parse_report(text)
+
+    def resolve(address):
+        # Clear the Thumb bit carried by LR and return addresses
+        address &= ~1
+        for resolver in resolvers:
+            symbol = resolver.lookup(address)
+            if symbol:
+                return symbol
+        return "??"
+
+    print("boot #%d, EXC_RETURN 0x%08x (%s stack)" % (
+        fields.get("boot", 0), fields.get("exc", 0),
+        "process" if fields.get("exc", 0) & 0x4 else "main"))
+    print("pc   0x%08x  %s" % (fields.get("pc", 0), resolve(fields.get("pc", 0))))
+    print("lr   0x%08x  %s" % (fields.get("lr", 0), resolve(fields.get("lr", 0))))
+    print("xpsr 0x%08x  exception %d" % (fields.get("xpsr", 0),
+                                         fields.get("xpsr", 0) & 0x3F))
+    print("sp   0x%08x" % fields.get("sp", 0))
+    for name in ("r0", "r1", "r2", "r3", "r12"):
+        print("%-4s 0x%08x" % (name, fields.get(name, 0)))
+
+    print("possible call chain (stack words pointing into flash):")
+    for offset, word in enumerate(stack):
+        if is_code_address(word) and word & 1:
+            print("  sp+0x%02x 0x%08x  %s" % (
+                offset * 4, word, resolve(word)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Cortex-M0+ code size of the kernels benchmarked on the host.
+
+Companion of `make host-bench`: the same functions, compiled by the
+arm-none-eabi release build, are looked up in its linker map and their
+size is printed per function. Functions placed in RAM (SERRE_RAMFUNC) take
+their size twice: in RAM, and in flash for the copy loaded at startup.
+Fails when an interrupt handler the linker script puts in RAM ended up in
+flash, as the kernels would then have lost their sections too.
+
+Usage:
+    tools/kernel_size.py --map build/release/serre_co.map
+    tools/kernel_size.py --map build/release/serre_co.map --json \\
+        sensor::TempSensor::processData
+"""
+
+import argparse
+import json
+import sys
+
+import linker_map
+
+KERNELS = (
+    "sensor::AnalogSensor::readData",
+    "sensor::AnalogSensor::sensor_readHelper",
+    "sensor::AnalogSensor::processData",
+    "sensor::TempSensor::processData",
+    "sensor::SoilHumSensor::processData",
+)
+
+
+def mangled_prefix(qualified):
+    """Itanium mangling of a nested name, without its parameter types."""
+    parts = qualified.split("::")
+    if len(parts) == 1:
+        return "_Z%d%s" % (len(parts[0]), parts[0])
+    return "_ZN" + "".join("%d%s" % (len(part), part) for part in parts) + "E"
+
+
+def find(symbols, qualified):
+    """Return the symbols of every overload of a function."""
+    prefix = mangled_prefix(qualified)
+    return [symbol for symbol in symbols if symbol.name.startswith(prefix)]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--map", required=True,
+                        help="linker map (build/release/serre_co.map)")
+    parser.add_argument("--json", action="store_true",
+                        help="one JSON object per line")
+    parser.add_argument("functions", nargs="*", default=KERNELS,
+                        help="qualified names (default: sensor kernels)")
+    args = parser.parse_args()
+
+    sections = linker_map.parse(args.map)
+    symbols = linker_map.symbols(sections)
+    missing = 0
+    if not args.json:
+        print("%-42s %-10s %6s  %s" % ("function", "section", "bytes",
+                                        "region"))
+    for qualified in args.functions:
+        found = find(symbols, qualified)
+        if not found:
+            # Inlined everywhere or dropped by --gc-sections
+            missing += 1
+        for symbol in found:
+            section = symbol.section
+            region = section.region()
+            if section.loaded:
+                region += "+flash"
+            if args.json:
+                print(json.dumps({"function": qualified,
+                                  "symbol": symbol.name,
+                                  "section": section.output,
+                                  "region": region,
+                                  "bytes": symbol.size}))
+            else:
+                print("%-42s %-10s %6d  %s" % (qualified, section.output,
+                                               symbol.size, region))
+        if not found and not args.json:
+            print("%-42s %-10s %6s  %s" % (qualified, "-", "-",
+                                           "not in the image"))
+        elif not found:
+            print(json.dumps({"function": qualified, "symbol": None,
+                              "section": None, "region": None,
+                              "bytes": 0}))
+    misplaced = linker_map.misplaced_ramfunc(sections)
+    if misplaced:
+        print("not in .ramfunc: %s" % ", ".join(misplaced), file=sys.stderr)
+        return 1
+    return 1 if missing == len(args.functions) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,176 @@
+"""Parser for the GNU ld map files of serre_co.
+
+Reads the "Linker script and memory map" part of the map: output sections,
+the input sections placed in them (with the object file they come from)
+and the global symbols defined in each input section. Output section
+names longer than the name column are wrapped by ld onto their own line. Symbol sizes are
+derived from the address of the next symbol in the same input section.
+"""
+
+import re
+
+FLASH_START = 0x08000000
+FLASH_END = 0x08010000
+RAM_START = 0x20000000
+RAM_END = 0x20002000
+
+# Interrupt paths the linker script places in .ramfunc by input section
+# name: they stay in flash if the build loses -ffunction-sections
+RAMFUNC_SYMBOLS = ("DMA1_Channel1_IRQHandler", "DMA1_Channel2_3_IRQHandler",
+                   "I2C1_IRQHandler", "HAL_DMA_IRQHandler")
+
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+OUTPUT_NAME_RE = re.compile(r"^(\.\S+)\s*$")
+INPUT_RE = re.compile(
+    r"^ (\.\S+|COMMON)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+INPUT_NAME_RE = re.compile(r"^ (\.\S+|COMMON)\s*$")
+INPUT_ADDR_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_$][\w$.]*)\s*$")
+LOAD_RE = re.compile(r"load address 0x([0-9a-fA-F]+)")
+
+
+class Symbol:
+    """Global symbol defined in an input section."""
+
+    def __init__(self, name, address, size, section):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.section = section
+
+
+class OutputSection:
+    """Output section of the image, fill and linker reservations included."""
+
+    def __init__(self, name, address, size, loaded):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.loaded = loaded
+
+    def region(self):
+        return _region(self.address)
+
+
+class InputSection:
+    """Input section of one object file, placed in an output section."""
+
+    def __init__(self, output, name, address, size, obj, loaded):
+        self.output = output
+        self.name = name
+        self.address = address
+        self.size = size
+        self.obj = obj
+        # Initialized RAM content (.data, .ramfunc) also takes flash
+        self.loaded = loaded
+        self.symbols = []
+
+    def region(self):
+        return _region(self.address)
+
+
+def parse(path):
+    """Return the input sections of the map file, in file order."""
+    return _read(path)[1]
+
+
+def outputs(path):
+    """Return the output sections of the map file, in file order."""
+    return _read(path)[0]
+
+
+def symbols(sections):
+    """Return every symbol of the sections, sized."""
+    return [symbol for section in sections for symbol in section.symbols]
+
+
+def misplaced_ramfunc(sections):
+    """Return the RAMFUNC_SYMBOLS missing from the .ramfunc output section."""
+    placed = set(symbol.name for section in sections
+                 if section.output == ".ramfunc"
+                 for symbol in section.symbols)
+    return [name for name in RAMFUNC_SYMBOLS if name not in placed]
+
+
+def _read(path):
+    outputs = []
+    sections = []
+    output = None
+    wrapped = None
+    loaded = False
+    pending = None
+    current = None
+    started = False
+    with open(path, encoding="utf-8", errors="replace") as handle:
+        for line in handle:
+            if not started:
+                started = line.startswith("Linker script and memory map")
+                continue
+            if wrapped is not None:
+                line = wrapped + line
+                wrapped = None
+            match = OUTPUT_RE.match(line)
+            if match:
+                output = match.group(1)
+                loaded = LOAD_RE.search(line) is not None
+                outputs.append(OutputSection(output, int(match.group(2), 16),
+                                             int(match.group(3), 16),
+                                             loaded))
+                current = None
+                pending = None
+                continue
+            match = OUTPUT_NAME_RE.match(line)
+            if match:
+                wrapped = match.group(1)
+                continue
+            match = INPUT_RE.match(line)
+            if match:
+                current = _add(sections, output, match.group(1),
+                               match.group(2), match.group(3),
+                               match.group(4), loaded)
+                pending = None
+                continue
+            match = INPUT_NAME_RE.match(line)
+            if match:
+                pending = match.group(1)
+                current = None
+                continue
+            if pending is not None:
+                match = INPUT_ADDR_RE.match(line)
+                if match:
+                    current = _add(sections, output, pending, match.group(1),
+                                   match.group(2), match.group(3), loaded)
+                pending = None
+                continue
+            match = SYMBOL_RE.match(line)
+            if match and current is not None:
+                current.symbols.append(
+                    Symbol(match.group(2), int(match.group(1), 16), 0,
+                           current))
+    for section in sections:
+        _size_symbols(section)
+    return outputs, sections
+
+
+def _region(address):
+    if FLASH_START <= address < FLASH_END:
+        return "flash"
+    if RAM_START <= address < RAM_END:
+        return "ram"
+    return "other"
+
+
+def _add(sections, output, name, address, size, obj, loaded):
+    section = InputSection(output, name, int(address, 16), int(size, 16),
+                           obj, loaded)
+    sections.append(section)
+    return section
+
+
+def _size_symbols(section):
+    ordered = sorted(section.symbols, key=lambda symbol: symbol.address)
+    end = section.address + section.size
+    for index, symbol in enumerate(ordered):
+        following = (ordered[index + 1].address if index + 1 < len(ordered)
+                     else end)
+        symbol.size = max(0, following - symbol.address)
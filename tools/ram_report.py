@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""RAM budget of serre_co, read from the linker map.
+
+Prints the RAM taken by each output section, then by each module (source
+directory of the object files, or library), and the margin left once the
+heap and stack reserves of the linker script (_Min_Heap_Size,
+_Min_Stack_Size) are counted. The run-time side is the 'm' console
+command, which prints the heap and stack high-water marks.
+
+Usage:
+    tools/ram_report.py --map build/release/serre_co.map
+    tools/ram_report.py --map build/release/serre_co.map --min-free 512
+"""
+
+import argparse
+import json
+import re
+import sys
+
+import linker_map
+
+RESERVE = "._user_heap_stack"
+ARCHIVE_RE = re.compile(r"^(?:.*[/\\])?([^/\\]+)\.a\(")
+ROOTS = ("Core/", "Drivers/")
+
+
+def module(obj):
+    """Source directory of an object file, or library for archive members."""
+    match = ARCHIVE_RE.match(obj)
+    if match:
+        return match.group(1)
+    path = obj.replace("\\", "/")
+    for root in ROOTS:
+        index = path.find(root)
+        if index >= 0:
+            path = path[index:]
+            break
+    parts = path.split("/")[:-1]
+    if len(parts) > 2 and parts[-1] == "Src":
+        parts = parts[:-1]
+    return "/".join(parts) if parts else obj
+
+
+def budget(outputs, sections):
+    """RAM use per section and per module, and the margin left."""
+    ram = [output for output in outputs
+           if output.region() == "ram" and output.size > 0]
+    reserve = sum(output.size for output in ram if output.name == RESERVE)
+    static = sum(output.size for output in ram if output.name != RESERVE)
+
+    modules = {}
+    for section in sections:
+        if section.region() != "ram" or section.output == RESERVE:
+            continue
+        entry = modules.setdefault(module(section.obj), {})
+        entry[section.output] = entry.get(section.output, 0) + section.size
+
+    total = linker_map.RAM_END - linker_map.RAM_START
+    return {"total": total,
+            "static": static,
+            "reserve": reserve,
+            "free": total - static - reserve,
+            "sections": [(output.name, output.address, output.size)
+                         for output in ram],
+            "modules": modules}
+
+
+def print_report(report, top):
+    print("%-20s %-10s %6s" % ("section", "address", "bytes"))
+    for name, address, size in report["sections"]:
+        print("%-20s 0x%08x %6d" % (name, address, size))
+    print()
+
+    names = [name for name, _, _ in report["sections"] if name != RESERVE]
+    print("%-40s %6s  %s" % ("module", "bytes",
+                             " ".join("%8s" % name for name in names)))
+    ordered = sorted(report["modules"].items(),
+                     key=lambda item: -sum(item[1].values()))
+    if top:
+        ordered = ordered[:top]
+    for name, entry in ordered:
+        print("%-40s %6d  %s" % (name[-40:], sum(entry.values()),
+                                 " ".join("%8d" % entry.get(section, 0)
+                                          for section in names)))
+    print()
+
+    print("static  %6d bytes (%d%%)" % (report["static"], 100 *
+                                        report["static"] // report["total"]))
+    print("reserve %6d bytes (heap and stack minimum)" % report["reserve"])
+    print("free    %6d bytes of %d" % (report["free"], report["total"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--map", required=True,
+                        help="linker map (build/release/serre_co.map)")
+    parser.add_argument("--json", action="store_true",
+                        help="print the budget as one JSON object")
+    parser.add_argument("--top", type=int, default=0,
+                        help="largest modules only (default: all)")
+    parser.add_argument("--min-free", type=int, default=0,
+                        help="fail when fewer bytes are left")
+    args = parser.parse_args()
+
+    report = budget(linker_map.outputs(args.map),
+                    linker_map.parse(args.map))
+    if args.json:
+        print(json.dumps(report, sort_keys=True))
+    else:
+        print_report(report, args.top)
+
+    if report["free"] < args.min_free:
+        print("RAM budget exceeded: %d bytes free, %d required" %
+              (report["free"], args.min_free), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
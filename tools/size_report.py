@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Per-symbol flash and RAM of serre_co, and what changed between builds.
+
+Reads the linker map of a build and prints the flash and RAM taken by each
+symbol. With --base, the map of an earlier build, only the symbols whose
+size changed are printed, with the difference. Initialized RAM (.data,
+.ramfunc) counts in both columns: its initial value is stored in flash.
+Functions and variables local to a file have no symbol in the map; with
+-ffunction-sections and -fdata-sections their input section is named
+after them instead. The report fails (exit status 1) when an interrupt
+handler the linker script puts in RAM ended up in flash.
+
+Usage:
+    tools/size_report.py --map build/release/serre_co.map
+    tools/size_report.py --map build/release/serre_co.map \\
+        --base build/size-base.map
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+import linker_map
+
+RESERVE = "._user_heap_stack"
+PREFIXES = (".text.", ".rodata.", ".data.", ".bss.", ".ramfunc.")
+# newlib-nano formatted I/O: should never be linked, nothing calls it
+STDIO = ("_vfprintf_r", "_svfprintf_r", "_vfiprintf_r", "_svfiprintf_r",
+         "_printf_i", "_printf_float", "__ssvfscanf_r", "_scanf_i",
+         "_scanf_float")
+
+
+def section_name(section):
+    """Name of an input section without symbol in the map."""
+    for prefix in PREFIXES:
+        if section.name.startswith(prefix):
+            return section.name[len(prefix):]
+    return "%s(%s)" % (os.path.basename(section.obj), section.name)
+
+
+def sizes(path):
+    """Return {symbol: [flash, ram]}, the image totals of a map and the
+    RAM interrupt handlers found outside .ramfunc."""
+    table = {}
+    sections = linker_map.parse(path)
+    for section in sections:
+        region = section.region()
+        if region == "other" or section.size == 0:
+            continue
+        named = [(symbol.name, symbol.size) for symbol in section.symbols]
+        if not named:
+            named = [(section_name(section), section.size)]
+        for name, size in named:
+            entry = table.setdefault(name, [0, 0])
+            if region == "flash":
+                entry[0] += size
+            else:
+                entry[1] += size
+                if section.loaded:
+                    entry[0] += size
+
+    flash = ram = 0
+    for output in linker_map.outputs(path):
+        if output.region() == "flash":
+            flash += output.size
+        elif output.region() == "ram" and output.name != RESERVE:
+            ram += output.size
+            if output.loaded:
+                flash += output.size
+    return table, (flash, ram), linker_map.misplaced_ramfunc(sections)
+
+
+def demangle(names):
+    """Readable C++ names, unchanged when no c++filt is installed."""
+    tool = shutil.which("arm-none-eabi-c++filt") or shutil.which("c++filt")
+    if tool is None or not names:
+        return {name: name for name in names}
+    result = subprocess.run([tool], input="\n".join(names), text=True,
+                            stdout=subprocess.PIPE, check=False)
+    lines = result.stdout.splitlines()
+    if len(lines) != len(names):
+        return {name: name for name in names}
+    return dict(zip(names, lines))
+
+
+def rows(table, base):
+    """One row per symbol: name, flash, ram, flash delta, ram delta."""
+    result = []
+    for name in set(table) | set(base or {}):
+        flash, ram = table.get(name, (0, 0))
+        if base is None:
+            result.append((name, flash, ram, 0, 0))
+            continue
+        old_flash, old_ram = base.get(name, (0, 0))
+        if (flash, ram) != (old_flash, old_ram):
+            result.append((name, flash, ram, flash - old_flash,
+                           ram - old_ram))
+    if base is None:
+        result.sort(key=lambda row: (-(row[1] + row[2]), row[0]))
+    else:
+        result.sort(key=lambda row: (-(abs(row[3]) + abs(row[4])), row[0]))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--map", required=True,
+                        help="linker map (build/release/serre_co.map)")
+    parser.add_argument("--base",
+                        help="map of the build to compare with")
+    parser.add_argument("--top", type=int, default=0,
+                        help="largest symbols or changes only")
+    parser.add_argument("--json", action="store_true",
+                        help="print the report as one JSON object")
+    args = parser.parse_args()
+
+    table, totals, misplaced = sizes(args.map)
+    base = base_totals = None
+    if args.base:
+        base, base_totals, _ = sizes(args.base)
+    report = rows(table, base)
+    if args.top:
+        report = report[:args.top]
+    names = demangle([row[0] for row in report])
+    stdio = sorted(name for name in table if name in STDIO)
+
+    if args.json:
+        print(json.dumps({
+            "flash": totals[0], "ram": totals[1],
+            "base_flash": base_totals[0] if base_totals else None,
+            "base_ram": base_totals[1] if base_totals else None,
+            "stdio": stdio,
+            "ramfunc_misplaced": misplaced,
+            "symbols": [{"symbol": row[0], "name": names[row[0]],
+                         "flash": row[1], "ram": row[2],
+                         "flash_delta": row[3], "ram_delta": row[4]}
+                        for row in report]}, sort_keys=True))
+        return 1 if misplaced else 0
+
+    if base is None:
+        print("%7s %6s  %s" % ("flash", "ram", "symbol"))
+        for name, flash, ram, _, _ in report:
+            print("%7d %6d  %s" % (flash, ram, names[name]))
+        print()
+        print("image: flash %d, ram %d (without heap and stack)" % totals)
+    else:
+        print("%7s %6s %7s %6s  %s" % ("flash", "ram", "+flash", "+ram",
+                                       "symbol"))
+        for name, flash, ram, flash_delta, ram_delta in report:
+            print("%7d %6d %+7d %+6d  %s" % (flash, ram, flash_delta,
+                                             ram_delta, names[name]))
+        print()
+        print("image: flash %d (%+d), ram %d (%+d)" %
+              (totals[0], totals[0] - base_totals[0], totals[1],
+               totals[1] - base_totals[1]))
+    if stdio:
+        print("newlib stdio linked: %s" % ", ".join(stdio))
+    if misplaced:
+        print("not in .ramfunc: %s" % ", ".join(misplaced), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())